@@ -0,0 +1,124 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <stdint.h>
+
+namespace common {
+enum class AbortReason : uint8_t {
+  Unknown,
+  ReadCycle,      // serialization graph cycle on a read
+  WriteCycle,     // serialization graph cycle on a write
+  CommitCycle,    // serialization graph cycle found at commit
+  Cascading,      // aborted through the abort of a transaction it depends on
+  WaitDie,        // lock request of a younger transaction
+  Validation,     // read set validation failed at commit
+  UndoBuffer,     // a read row was overwritten by a transaction committed since the start (undo buffer validation)
+  WriteConflict,  // concurrent uncommitted write of the same row
+  NotFound,       // a key was not found and the benchmark rolled back
+  count
+};
+
+/*
+ *
+ * AbortReasons remembers why the transaction of the calling worker aborts, set by the concurrency control where it
+ * decides to abort and read by the DetailCollector when the benchmark counts the abort. Only the first reason of an
+ * attempt counts, s.t. the following bookkeeping (e.g., a cascade noticed again on commit) does not overwrite it. The
+ * conflicting column is mapped to its table by the columns named by Database::snapshotDatabase.
+ *
+ */
+class AbortReasons {
+ public:
+  static constexpr uint8_t max_tables = 16;  // table 0 collects columns without name
+
+ private:
+  static thread_local AbortReason reason_;
+  static thread_local const void* column_;
+  static std::unordered_map<const void*, uint8_t> columns_;
+  static std::vector<std::string> tables_;
+
+ public:
+  static inline void set(AbortReason reason, const void* column = nullptr) {
+    if (reason_ != AbortReason::Unknown)
+      return;
+    reason_ = reason;
+    column_ = column;
+  }
+
+  // the reason and table of the last abort of the calling worker, resets the reason for the next attempt
+  static inline AbortReason take(uint8_t& table) {
+    auto reason = reason_;
+    auto it = columns_.find(column_);
+    table = (it != columns_.end()) ? it->second : 0;
+    reset();
+    return reason;
+  }
+
+  static inline void reset() {
+    reason_ = AbortReason::Unknown;
+    column_ = nullptr;
+  }
+
+  static const char* name(AbortReason reason) {
+    static const char* names[] = {"unknown",  "read_cycle", "write_cycle", "commit_cycle",   "cascading",
+                                  "wait_die", "validation", "undo_buffer", "write_conflict", "not_found"};
+    return names[static_cast<uint8_t>(reason)];
+  }
+
+  static inline const std::string& table(uint8_t table) { return tables_[table]; }
+
+  /* Maps a column to a table, must not run concurrently to the workers */
+  static void nameColumn(const void* column, const std::string& table) {
+    auto it = std::find(tables_.begin(), tables_.end(), table);
+    if (it == tables_.end()) {
+      if (tables_.size() >= max_tables)
+        return;
+      it = tables_.insert(tables_.end(), table);
+    }
+    columns_[column] = it - tables_.begin();
+  }
+
+  /* Visitor for Database::snapshotDatabase, names every column by the table prefix of the previous named column */
+  class Tables {
+    std::string table_ = "-";
+
+   public:
+    template <typename Vector>
+    inline void column(const std::string& name, Vector& vector) {
+      table_ = name.substr(0, name.find('.'));
+      nameColumn(&vector, table_);
+    }
+
+    template <typename Vector, typename Func>
+    inline void rebuild(Vector& vector, uint64_t, Func&&) {
+      nameColumn(&vector, table_);
+    }
+
+    template <typename Map>
+    inline void index(const std::string&, Map&) {}
+  };
+};
+};  // namespace common
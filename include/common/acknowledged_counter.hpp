@@ -0,0 +1,100 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+
+namespace common {
+/*
+ *
+ * AcknowledgedCounter hands out the keys of inserts and tracks the largest key below which every key was inserted, as
+ * the AcknowledgedCounterGenerator of YCSB. Inserts may commit out of order, hence last only advances over the
+ * contiguous prefix of acknowledged keys; the key of an insert that was rolled back is returned and handed out again,
+ * s.t. the prefix never stops at a key that is not inserted. At most window keys may be in flight.
+ *
+ */
+class AcknowledgedCounter {
+ public:
+  static constexpr uint64_t window = 1 << 20;
+
+ private:
+  std::atomic<uint64_t> next_{1};
+  std::atomic<uint64_t> last_{0};
+  std::atomic<uint64_t> returned_count_{0};
+  std::mutex mutex_;
+  std::vector<uint8_t> done_;  // acknowledged keys above last, ring of window slots
+  std::vector<uint64_t> returned_;
+
+ public:
+  AcknowledgedCounter() : done_(window, 0) {}
+
+  // the keys up to last exist, the next key handed out is last + 1
+  inline void reset(uint64_t last) {
+    std::lock_guard<std::mutex> guard{mutex_};
+    next_ = last + 1;
+    last_ = last;
+    std::fill(done_.begin(), done_.end(), 0);
+    returned_.clear();
+    returned_count_ = 0;
+  }
+
+  // the key of the next insert, a returned key first
+  inline uint64_t next() {
+    if (returned_count_.load(std::memory_order_relaxed) > 0) {
+      std::lock_guard<std::mutex> guard{mutex_};
+      if (!returned_.empty()) {
+        uint64_t key = returned_.back();
+        returned_.pop_back();
+        returned_count_.fetch_sub(1, std::memory_order_relaxed);
+        return key;
+      }
+    }
+    return next_++;
+  }
+
+  // every key up to last was inserted
+  inline uint64_t last() const { return last_.load(std::memory_order_acquire); }
+
+  // the insert of key committed
+  inline void acknowledge(uint64_t key) {
+    std::lock_guard<std::mutex> guard{mutex_};
+    done_[key % window] = 1;
+    uint64_t last = last_.load(std::memory_order_relaxed);
+    while (done_[(last + 1) % window]) {
+      done_[(last + 1) % window] = 0;
+      last++;
+    }
+    last_.store(last, std::memory_order_release);
+  }
+
+  // the insert of key was rolled back, the key is handed out again
+  inline void release(uint64_t key) {
+    std::lock_guard<std::mutex> guard{mutex_};
+    returned_.push_back(key);
+    returned_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+};
+};  // namespace common
@@ -0,0 +1,90 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include "common/run_control.hpp"
+#include "common/timer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <stdint.h>
+
+namespace common {
+/*
+ *
+ * Arrivals paces an OLTP worker of an open-loop run: transactions arrive at a fixed rate per worker, either evenly
+ * spaced (constant) or with exponentially distributed gaps (poisson), and the worker starts each transaction at its
+ * arrival or, if it is behind, immediately. The arrivals a worker is behind form its queue. Latencies are measured
+ * from the arrival, i.e., they include the time queued, the execution and all restarts. Without a rate the workers
+ * run closed-loop, back to back.
+ *
+ */
+class Arrivals {
+  static double rate_;  // transactions per second and worker, 0 for closed-loop runs
+  static bool poisson_;
+  thread_local static bool open_;
+
+  double gap_ = 0;  // mean ticks between two arrivals, 0 if the worker is not paced
+  double next_ = 0;
+  std::mt19937_64 gen_;
+  std::exponential_distribution<double> exponential_{1.0};
+
+ public:
+  static inline void setRate(double rate) { rate_ = rate; }
+
+  static inline void setPoisson(bool poisson) { poisson_ = poisson; }
+
+  static inline double rate() { return rate_; }
+
+  static inline bool poisson() { return poisson_; }
+
+  // called on the OLTP worker threads, the scanners of a run are never paced
+  static inline void open() { open_ = true; }
+
+  inline void start() {
+    if (!open_ || rate_ <= 0)
+      return;
+    gap_ = 1e9 / rate_ / Timer::nsPerTick();
+    next_ = Timer::now();
+    gen_.seed(std::random_device{}());
+  }
+
+  inline bool paced() const { return gap_ > 0; }
+
+  // waits for the next arrival and returns its ticks, at most now if the run stopped while waiting
+  inline uint64_t arrive() {
+    next_ += poisson_ ? exponential_(gen_) * gap_ : gap_;
+    auto arrival = static_cast<uint64_t>(next_);
+    for (uint64_t now = Timer::now(); now < arrival; now = Timer::now()) {
+      if (RunControl::phase() == RunControl::Phase::Stop)
+        break;
+      auto wait = Timer::nanoseconds(arrival - now);
+      if (wait > 200000)
+        std::this_thread::sleep_for(std::chrono::nanoseconds(wait - 100000));
+      else
+        std::this_thread::yield();
+    }
+    return std::min(arrival, Timer::now());
+  }
+};
+};  // namespace common
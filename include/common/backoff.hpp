@@ -0,0 +1,84 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <stdint.h>
+
+namespace common {
+/*
+ *
+ * Backoff is the policy of every loop waiting for another worker, e.g., for a commit dependency, a lock or the flush
+ * of the redo log. With one worker per CPU (spin, default) a waiter spins and yields after a number of attempts, the
+ * worker it waits for runs on another CPU. With more workers than CPUs (park) the worker it waits for may be
+ * descheduled in favor of the waiter, hence a waiter yields at once and sleeps after a few yields (1us doubling up to
+ * 256us). The mode is selected per run, see common::Placement::oversubscribed.
+ *
+ */
+class Backoff {
+ public:
+  enum class Mode : uint8_t { Spin, Park };
+
+  static constexpr uint32_t park_yields = 16;
+  static constexpr uint32_t max_sleep_shift = 8;
+
+ private:
+  static Mode mode_;
+
+  uint32_t spins_;
+  uint32_t attempts_;
+
+ public:
+  // spins: the attempts before a waiter yields in spin mode
+  explicit Backoff(uint32_t spins = 10000) : spins_(spins), attempts_(0) {}
+
+  static inline void configure(Mode mode) { mode_ = mode; }
+
+  static inline Mode mode() { return mode_; }
+
+  static inline const char* name() { return mode_ == Mode::Spin ? "spin" : "park"; }
+
+  // called after every unsuccessful attempt of a wait loop
+  inline void pause() {
+    if (mode_ == Mode::Spin) {
+      if (attempts_ < spins_) {
+        attempts_++;
+      } else {
+        std::this_thread::yield();
+      }
+      return;
+    }
+
+    if (attempts_ < park_yields) {
+      attempts_++;
+      std::this_thread::yield();
+      return;
+    }
+    auto shift = std::min(attempts_ - park_yields, max_sleep_shift);
+    if (shift < max_sleep_shift)
+      attempts_++;
+    std::this_thread::sleep_for(std::chrono::microseconds(1u << shift));
+  }
+};
+};  // namespace common
@@ -0,0 +1,328 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include "common/redo_log.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace common {
+/*
+ *
+ * The Checkpointer periodically writes fuzzy checkpoints of all logged columns next to the redo log while the workers
+ * keep running. Columns are copied segment by segment without synchronizing with the writers, hence a checkpoint
+ * holds a mix of values written before and during the copy. It is made consistent by replaying the redo log from the
+ * checkpoint epoch onwards, i.e., every record whose commit was still in flight when the checkpoint started. Dirty
+ * values of aborted transactions are fixed by the compensation records, see RedoLog::logAborts.
+ *
+ * The checkpointer is throttled to a share of the time: after writing a chunk it pauses until the time spent writing
+ * is at most share of the elapsed time, s.t. it takes at most that share of the I/O bandwidth from the log writer.
+ *
+ * A checkpoint is a directory checkpoint.<n> holding one file per column, a header page followed by the rows. The
+ * manifest is written last, afterwards the previous checkpoint is deleted. Indexes are not checkpointed, they are
+ * rebuilt by populating or restoring the database.
+ *
+ */
+class Checkpointer {
+ public:
+  static constexpr uint64_t page_size = 1 << 12;
+  static constexpr uint64_t magic = 0x4e464e434b505453;  // NFNCKPTS
+
+  struct Header {
+    uint64_t magic;
+    uint64_t element_size;
+    uint64_t rows;
+    uint64_t epoch;
+    uint64_t lsn;
+  };
+
+ private:
+  struct Run {
+    std::chrono::steady_clock::time_point begin;
+    std::chrono::steady_clock::time_point end;
+    uint64_t bytes;
+    uint64_t commits;
+  };
+
+  std::string path_;
+  RedoLog* log_;
+  std::chrono::milliseconds interval_;
+  double share_;
+  std::function<void(Checkpointer&)> visit_;
+
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_;
+
+  // state of the checkpoint being written
+  std::string current_;
+  uint64_t sequence_;
+  uint64_t epoch_;
+  uint64_t lsn_;
+  uint64_t bytes_;
+  uint64_t columns_;
+  bool good_;
+  std::chrono::steady_clock::time_point mark_;
+
+  std::vector<Run> runs_;
+  uint64_t failed_;
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::time_point end_;
+  uint64_t start_commits_;
+  uint64_t end_commits_;
+
+  static inline void remove(const std::string& directory) {
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr)
+      return;
+    while (auto entry = readdir(dir)) {
+      std::string name{entry->d_name};
+      if (name != "." && name != "..")
+        unlink((directory + "/" + name).c_str());
+    }
+    closedir(dir);
+    rmdir(directory.c_str());
+  }
+
+  inline bool writeAll(int fd, const void* data, uint64_t size, uint64_t offset) {
+    for (uint64_t written = 0; written < size;) {
+      auto res = pwrite(fd, reinterpret_cast<const char*>(data) + written, size - written, offset + written);
+      if (res < 0)
+        return false;
+      written += res;
+    }
+    return true;
+  }
+
+  inline bool writeHeader(int fd, uint64_t element_size, uint64_t rows) {
+    Header header{magic, element_size, rows, epoch_, lsn_};
+    char page[page_size] = {};
+    std::memcpy(page, &header, sizeof(Header));
+    return writeAll(fd, page, page_size, 0);
+  }
+
+  inline void error(const std::string& name, const char* what) {
+    if (good_ && !stopped())
+      std::cout << "Checkpoint error: " << what << " " << current_ << "/" << name << " - " << strerror(errno)
+                << std::endl;
+    good_ = false;
+  }
+
+  inline bool stopped() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return stop_;
+  }
+
+  // pauses s.t. the time spent writing since the last pause is share of the time passed, false once stopped
+  inline bool throttle(uint64_t bytes) {
+    bytes_ += bytes;
+    auto now = std::chrono::steady_clock::now();
+    auto pause = std::chrono::duration<double>(now - mark_) * ((1 - share_) / share_);
+    std::unique_lock<std::mutex> guard(mutex_);
+    bool stop = cv_.wait_for(guard, pause, [&]() { return stop_; });
+    mark_ = std::chrono::steady_clock::now();
+    return !stop;
+  }
+
+  void checkpoint() {
+    Run run;
+    run.begin = std::chrono::steady_clock::now();
+    run.commits = log_->records();
+
+    // every commit not yet in memory when the copy starts belongs to the active epoch or a later one, a reservation
+    // not yet visible in the active epoch reads a global epoch at least as new, see RedoLog::reserve
+    epoch_ = log_->activeEpoch();
+    lsn_ = log_->lsn();
+    current_ = path_ + "/checkpoint." + std::to_string(++sequence_);
+    bytes_ = 0;
+    columns_ = 0;
+    good_ = true;
+    mark_ = run.begin;
+    if (mkdir(current_.c_str(), 0755) != 0) {
+      error("", "cannot create");
+    }
+
+    visit_(*this);
+
+    int fd = good_ ? open((current_ + "/manifest").c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644) : -1;
+    if (good_ && (fd < 0 || !writeHeader(fd, 0, columns_) || fdatasync(fd) != 0)) {
+      error("manifest", "cannot write");
+    }
+    if (fd >= 0)
+      close(fd);
+
+    if (!good_) {
+      remove(current_);
+      --sequence_;
+      failed_++;
+      return;
+    }
+    if (sequence_ > 1)
+      remove(path_ + "/checkpoint." + std::to_string(sequence_ - 1));
+
+    run.end = std::chrono::steady_clock::now();
+    run.bytes = bytes_;
+    run.commits = log_->records() - run.commits;
+    runs_.push_back(run);
+  }
+
+  void loop() {
+    std::unique_lock<std::mutex> guard(mutex_);
+    while (!cv_.wait_for(guard, interval_, [&]() { return stop_; })) {
+      guard.unlock();
+      checkpoint();
+      guard.lock();
+    }
+  }
+
+ public:
+  /* The database is visited by visit, i.e., Database::snapshotDatabase, the share is clamped to (0, 1] */
+  Checkpointer(RedoLog* log, uint64_t interval_ms, double share, std::function<void(Checkpointer&)> visit)
+      : path_(log->path()),
+        log_(log),
+        interval_(interval_ms),
+        share_(std::min(std::max(share, 0.01), 1.0)),
+        visit_(std::move(visit)),
+        stop_(false),
+        sequence_(0),
+        epoch_(0),
+        lsn_(0),
+        bytes_(0),
+        columns_(0),
+        good_(true),
+        failed_(0),
+        start_commits_(0),
+        end_commits_(0) {}
+
+  Checkpointer(const Checkpointer& other) = delete;
+  Checkpointer(Checkpointer&& other) = delete;
+  Checkpointer& operator=(const Checkpointer& other) = delete;
+  Checkpointer& operator=(Checkpointer&& other) = delete;
+
+  ~Checkpointer() { stop(); }
+
+  inline double share() const { return share_; }
+
+  // removes the checkpoints of earlier runs, which do not match the new log, and starts the checkpointer thread
+  void start() {
+    DIR* dir = opendir(path_.c_str());
+    if (dir != nullptr) {
+      std::vector<std::string> stale;
+      while (auto entry = readdir(dir)) {
+        std::string name{entry->d_name};
+        if (name.compare(0, 11, "checkpoint.") == 0)
+          stale.push_back(path_ + "/" + name);
+      }
+      closedir(dir);
+      for (auto& directory : stale) {
+        remove(directory);
+      }
+    }
+    start_ = std::chrono::steady_clock::now();
+    start_commits_ = log_->records();
+    thread_ = std::thread(&Checkpointer::loop, this);
+  }
+
+  // stops the checkpointer, a checkpoint in progress is discarded
+  void stop() {
+    if (!thread_.joinable())
+      return;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+    end_ = std::chrono::steady_clock::now();
+    end_commits_ = log_->records();
+  }
+
+  template <typename Vector>
+  inline void column(const std::string& name, Vector& vector) {
+    static_assert(std::is_trivially_copyable<typename Vector::value_type>::value &&
+                      !std::is_pointer<typename Vector::value_type>::value,
+                  "only plain values can be checkpointed");
+    if (!good_)
+      return;
+
+    int fd = open((current_ + "/" + name + ".col").c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd < 0 || !writeHeader(fd, Vector::element_size, vector.size()) ||
+        !vector.write(fd, page_size, [this](uint64_t bytes) { return throttle(bytes); }) || fdatasync(fd) != 0) {
+      error(name + ".col", "cannot write");
+    }
+    if (fd >= 0)
+      close(fd);
+    columns_++;
+  }
+
+  template <typename Vector, typename Func>
+  inline void rebuild(Vector&, uint64_t, Func&&) {}
+
+  template <typename Map>
+  inline void index(const std::string&, Map&) {}
+
+  void printStatistics() {
+    uint64_t bytes = 0, commits = 0;
+    double time = 0;
+    for (auto& run : runs_) {
+      bytes += run.bytes;
+      commits += run.commits;
+      time += std::chrono::duration<double>(run.end - run.begin).count();
+    }
+    std::cout << "Checkpoints: " << runs_.size() << " written, " << failed_ << " discarded, share " << share_;
+    if (!runs_.empty()) {
+      std::cout << ", " << bytes / runs_.size() / 1024.0 / 1024.0 << "MB in " << time * 1000 / runs_.size()
+                << "ms each (" << bytes / 1024.0 / 1024.0 / std::max(time, 1e-9) << "MB/s)";
+    }
+    std::cout << std::endl;
+
+    // the throughput dip, commits per second while a checkpoint was written compared to the remaining time
+    double total = std::chrono::duration<double>(end_ - start_).count();
+    uint64_t all = end_commits_ - start_commits_;
+    if (!runs_.empty() && total > time) {
+      double during = commits / std::max(time, 1e-9);
+      double outside = (all - std::min(all, commits)) / (total - time);
+      std::cout << "Checkpoints: " << static_cast<uint64_t>(during) << " commits/s during checkpoints, "
+                << static_cast<uint64_t>(outside) << " commits/s otherwise";
+      if (outside > 0)
+        std::cout << " (" << (1 - during / outside) * 100 << "% dip)";
+      std::cout << std::endl;
+    }
+  }
+};
+};  // namespace common
@@ -64,6 +64,8 @@ class ChunkAllocator {  //: std::allocator_traits<common::ChunkAllocator<T, conc
   void freeChunk(std::pair<std::atomic<uint64_t>, std::deleted_unique_ptr<void>>* cap, bool free);
 
  public:
+  ChunkAllocator() = default;
+
   void tidyUp();
   void printDetails();
 
@@ -20,6 +20,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#pragma once
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -29,15 +30,28 @@ namespace common {
 class CSVWriter {
  private:
   std::string log_name_;
+  std::string header_;
 
  public:
   CSVWriter() { log_name_ = "result.csv"; }
 
+  /* A new or empty file starts with the header, appending to a file with another header only prints a warning */
   inline void log(const std::string s) {
+    std::string first;
+    std::ifstream existing(log_name_);
+    bool empty = !std::getline(existing, first);
+    if (!header_.empty() && !empty && first != header_) {
+      std::cout << "Warning: " << log_name_ << " was written with different columns, appending anyway" << std::endl;
+    }
     std::ofstream log_file(log_name_, std::ios_base::out | std::ios_base::app);
+    if (!header_.empty() && empty) {
+      log_file << header_ << std::endl;
+    }
     log_file << s << std::endl;
   }
 
   inline void setLogName(std::string log_name) { log_name_ = log_name; }
+
+  inline void setHeader(std::string header) { header_ = header; }
 };
 };  // namespace common
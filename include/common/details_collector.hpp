@@ -21,18 +21,39 @@
 //
 
 #pragma once
+#include "common/abort_reason.hpp"
+#include "common/arrivals.hpp"
+#include "common/latency_histogram.hpp"
+#include "common/perf_counters.hpp"
+#include "common/run_control.hpp"
+#include "common/sampler.hpp"
+#include "common/timer.hpp"
 #include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <memory>
 #include <sstream>
 
 namespace common {
 class DetailCollector {
+ public:
+  // latencies are kept per transaction type, the first two types collect all OLTP and OLAP transactions without type
+  static constexpr uint8_t max_types = 10;
+  static constexpr uint8_t first_type = 2;
+
+  // performance counters are split by run phase (warm-up, measurement, cool-down) and by section of the worker
+  enum Section : uint8_t { Execution, Commit, WaitManager, sections };
+  static constexpr uint8_t perf_phases = 3;
+  static constexpr const char* section_names[sections] = {"execution", "commit", "wait_manager"};
+  static constexpr const char* phase_names[perf_phases] = {"warm_up", "measurement", "cool_down"};
+
  private:
-  std::chrono::system_clock::time_point tx_p_;
-  std::chrono::system_clock::time_point commit_p_;
-  std::chrono::system_clock::time_point wait_manager_p_;
-  std::chrono::system_clock::time_point latency_p_;
-  std::chrono::system_clock::time_point thread_start_;
+  // Timer ticks, the sums below are in ns
+  uint64_t tx_p_ = 0;
+  uint64_t commit_p_ = 0;
+  uint64_t wait_manager_p_ = 0;
+  uint64_t latency_p_ = 0;
+  uint64_t thread_start_ = 0;
 
   uint64_t total_time_ = 0;
   uint64_t commits_ = 0;
@@ -42,6 +63,7 @@ class DetailCollector {
   uint64_t commit_ = 0;
   uint64_t wait_manager_ = 0;
   uint64_t latency_ = 0;
+  uint64_t queue_ = 0;
 
   uint64_t olap_commits_ = 0;
   uint64_t olap_aborts_ = 0;
@@ -51,7 +73,91 @@ class DetailCollector {
   uint64_t olap_wait_manager_ = 0;
   uint64_t olap_latency_ = 0;
 
+  // finished within the measurement window of a time bounded run
+  uint64_t window_commits_ = 0;
+  uint64_t window_aborts_ = 0;
+  uint64_t window_olap_commits_ = 0;
+
+  // the counters read by the Sampler while the worker runs, nullptr without sampling
+  Sampler::Counters* sample_ = nullptr;
+
+  // paces the worker in open-loop runs, queue_ is the time transactions waited behind their arrival
+  Arrivals arrivals_;
+
+  // end-to-end latency of every finished transaction including its restarts
+  uint8_t type_ = 0;
+  const char* type_names_[max_types] = {"OLTP", "OLAP"};
+  LatencyHistogram latencies_[max_types];
+
+  // aborts and not found rollbacks per transaction type, AbortReason and table
+  static constexpr uint8_t reasons = static_cast<uint8_t>(AbortReason::count);
+  uint64_t abort_reasons_[max_types][reasons][AbortReasons::max_tables] = {};
+
+  // NFN_PERF: the counters of the worker thread, read at every section switch and attributed to the phase and section
+  // of the previous reading, nullptr if disabled or not available
+  std::unique_ptr<PerfCounters> perf_;
+  PerfCounters::Values perf_last_;
+  uint8_t perf_phase_ = 0;
+  uint8_t perf_section_ = Execution;
+  PerfCounters::Values perf_values_[perf_phases][sections];
+  uint64_t perf_commits_[perf_phases] = {};
+
+  static inline uint8_t perfPhase() {
+    return std::min(static_cast<uint8_t>(RunControl::phase()), static_cast<uint8_t>(perf_phases - 1));
+  }
+
+  inline void perfSwitch(uint8_t section) {
+    if (!perf_)
+      return;
+    auto now = perf_->read();
+    perf_values_[perf_phase_][perf_section_] += now - perf_last_;
+    perf_last_ = now;
+    perf_phase_ = perfPhase();
+    perf_section_ = section;
+  }
+
+  template <typename Func>
+  void forEachPerfPhase(Func&& func) const {
+    for (uint8_t phase = 0; phase < perf_phases; ++phase) {
+      if (perf_commits_[phase] == 0)
+        continue;
+      PerfCounters::Values total;
+      for (uint8_t section = 0; section < sections; ++section) {
+        total += perf_values_[phase][section];
+      }
+      func(phase, total);
+    }
+  }
+
+  template <typename Func>
+  void forEachAbortReason(Func&& func) const {
+    for (uint8_t t = 0; t < max_types; ++t) {
+      for (uint8_t r = 0; r < reasons; ++r) {
+        for (uint8_t table = 0; table < AbortReasons::max_tables; ++table) {
+          if (abort_reasons_[t][r][table] != 0)
+            func(type_names_[t], AbortReasons::name(static_cast<AbortReason>(r)), AbortReasons::table(table),
+                 abort_reasons_[t][r][table]);
+        }
+      }
+    }
+  }
+
+  LatencyHistogram oltpLatencies() const {
+    LatencyHistogram oltp;
+    for (uint8_t t = 0; t < max_types; ++t) {
+      if (t != 1)
+        oltp.merge(latencies_[t]);
+    }
+    return oltp;
+  }
+
+  static inline double us(uint64_t ns) { return ns / 1000.0; }
+
  public:
+  // the OLTP commits and not found rollbacks, e.g., of the collector merged after a run
+  inline uint64_t commitCount() const { return commits_; }
+  inline uint64_t notFoundCount() const { return not_found_; }
+
   void merge(common::DetailCollector& dc) {
     total_time_ += dc.total_time_;
 
@@ -62,6 +168,7 @@ class DetailCollector {
     commit_ += dc.commit_;
     wait_manager_ += dc.wait_manager_;
     latency_ += dc.latency_;
+    queue_ += dc.queue_;
 
     olap_commits_ += dc.olap_commits_;
     olap_aborts_ += dc.olap_aborts_;
@@ -70,14 +177,62 @@ class DetailCollector {
     olap_commit_ += dc.olap_commit_;
     olap_wait_manager_ += dc.olap_wait_manager_;
     olap_latency_ += dc.olap_latency_;
+
+    window_commits_ += dc.window_commits_;
+    window_aborts_ += dc.window_aborts_;
+    window_olap_commits_ += dc.window_olap_commits_;
+
+    for (uint8_t phase = 0; phase < perf_phases; ++phase) {
+      perf_commits_[phase] += dc.perf_commits_[phase];
+      for (uint8_t section = 0; section < sections; ++section) {
+        perf_values_[phase][section] += dc.perf_values_[phase][section];
+      }
+    }
+
+    for (uint8_t t = 0; t < max_types; ++t) {
+      latencies_[t].merge(dc.latencies_[t]);
+      for (uint8_t r = 0; r < reasons; ++r) {
+        for (uint8_t table = 0; table < AbortReasons::max_tables; ++table) {
+          abort_reasons_[t][r][table] += dc.abort_reasons_[t][r][table];
+        }
+      }
+      if (dc.type_names_[t] != nullptr)
+        type_names_[t] = dc.type_names_[t];
+    }
+  }
+
+  // commits per second, within the measurement window of a time bounded run or over the given run time
+  double throughput(std::chrono::nanoseconds time) const {
+    if (RunControl::timed())
+      time = RunControl::window();
+    auto seconds = std::chrono::duration<double>(time).count();
+    return seconds > 0 ? (RunControl::timed() ? window_commits_ : commits_) / seconds : 0;
   }
 
+  // share of aborts among all finished OLTP transactions
+  double abortRate() const { return commits_ + aborts_ > 0 ? aborts_ / static_cast<double>(commits_ + aborts_) : 0; }
+
+  // the p-quantile of the latencies of all OLTP transactions in us
+  double latency(double p) const { return us(oltpLatencies().percentile(p)); }
+
   void printStatistics() const {
     std::cout << "Time needed (netto): "
               << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(total_time_)).count()
               << "ms" << std::endl;
     std::cout << std::endl << std::endl;
 
+    if (RunControl::timed()) {
+      auto window = std::chrono::duration_cast<std::chrono::milliseconds>(RunControl::window()).count();
+      std::cout << "Measurement Window: " << window << "ms" << std::endl;
+      std::cout << "Measurement Window OLTP Commits: " << window_commits_ << std::endl;
+      std::cout << "Measurement Window OLTP Aborts: " << window_aborts_ << std::endl;
+      std::cout << "Measurement Window OLAP Commits: " << window_olap_commits_ << std::endl;
+      std::cout << "Measurement Window Throughput: " << static_cast<uint64_t>(throughput(RunControl::window()))
+                << " tx/s" << std::endl
+                << std::endl
+                << std::endl;
+    }
+
     if (commits_ != 0) {
       std::cout << "OLTP Commits: " << commits_ << std::endl;
       std::cout << "OLTP Aborts: " << aborts_ << std::endl;
@@ -94,10 +249,31 @@ class DetailCollector {
           << "ms" << std::endl;
       std::cout << "OLTP Latency Time: "
                 << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(latency_)).count()
-                << "ms" << std::endl
-                << std::endl
-                << std::endl;
+                << "ms" << std::endl;
+      if (Arrivals::rate() > 0)
+        std::cout << "OLTP Queueing Time: "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(queue_)).count()
+                  << "ms" << std::endl;
+      std::cout << std::endl << std::endl;
+    }
+
+    for (uint8_t t = 0; t < max_types; ++t) {
+      auto& h = latencies_[t];
+      if (h.count() == 0)
+        continue;
+      std::cout << "Latency " << type_names_[t] << ": " << h.count() << " transactions, p50 " << us(h.percentile(0.5))
+                << "us, p99 " << us(h.percentile(0.99)) << "us, p99.9 " << us(h.percentile(0.999)) << "us, max "
+                << us(h.max()) << "us" << std::endl;
     }
+    std::cout << std::endl << std::endl;
+
+    bool aborts = false;
+    forEachAbortReason([&](const char* type, const char* reason, const std::string& table, uint64_t count) {
+      std::cout << "Aborts " << type << " " << reason << " " << table << ": " << count << std::endl;
+      aborts = true;
+    });
+    if (aborts)
+      std::cout << std::endl << std::endl;
 
     if (olap_commits_ != 0) {
       std::cout << "OLAP Commits: " << olap_commits_ << std::endl;
@@ -121,6 +297,34 @@ class DetailCollector {
           << std::endl
           << std::endl;
     }
+
+    bool perf = false;
+    forEachPerfPhase([&](uint8_t phase, const PerfCounters::Values& total) {
+      auto commits = static_cast<double>(perf_commits_[phase]);
+      std::cout << "Perf " << phase_names[phase] << ": " << perf_commits_[phase] << " commits, per commit";
+      for (uint8_t e = 0; e < PerfCounters::events; ++e) {
+        std::cout << (e == 0 ? " " : ", ") << PerfCounters::names[e] << " ";
+        if (PerfCounters::supported(static_cast<PerfCounters::Event>(e)))
+          std::cout << total.v[e] / commits;
+        else
+          std::cout << "n/a";
+      }
+      std::cout << std::endl;
+      for (uint8_t section = 0; section < sections; ++section) {
+        auto& values = perf_values_[phase][section];
+        auto time = total.v[PerfCounters::TaskClock];
+        std::cout << "Perf " << phase_names[phase] << " " << section_names[section] << ": "
+                  << (time > 0 ? 100.0 * values.v[PerfCounters::TaskClock] / time : 0) << "% of the task clock";
+        for (uint8_t e = PerfCounters::Cycles; e < PerfCounters::events; ++e) {
+          if (PerfCounters::supported(static_cast<PerfCounters::Event>(e)))
+            std::cout << ", " << PerfCounters::names[e] << " " << values.v[e] / commits;
+        }
+        std::cout << std::endl;
+      }
+      perf = true;
+    });
+    if (perf)
+      std::cout << std::endl << std::endl;
   }
 
   void writeCSV(std::stringstream& log) {
@@ -138,49 +342,179 @@ class DetailCollector {
         << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(olap_latency_)).count();
   }
 
-  inline void commit(bool olap = false) { ((olap) ? olap_commits_ : commits_)++; }
+  // p50;p99;p99.9;max of all OLTP transactions in us, followed by type:p50/p99/p99.9/max|... for each type
+  void writeLatencyCSV(std::stringstream& log) const {
+    auto oltp = oltpLatencies();
+    log << std::fixed << std::setprecision(1) << ";" << us(oltp.percentile(0.5)) << ";" << us(oltp.percentile(0.99))
+        << ";" << us(oltp.percentile(0.999)) << ";" << us(oltp.max()) << ";";
+    bool first = true;
+    for (uint8_t t = 0; t < max_types; ++t) {
+      auto& h = latencies_[t];
+      if (h.count() == 0)
+        continue;
+      log << (first ? "" : "|") << type_names_[t] << ":" << us(h.percentile(0.5)) << "/" << us(h.percentile(0.99))
+          << "/" << us(h.percentile(0.999)) << "/" << us(h.max());
+      first = false;
+    }
+  }
+
+  // type/reason/table:count|... for all aborts and not found rollbacks
+  void writeAbortCSV(std::stringstream& log) const {
+    log << ";";
+    bool first = true;
+    forEachAbortReason([&](const char* type, const char* reason, const std::string& table, uint64_t count) {
+      log << (first ? "" : "|") << type << "/" << reason << "/" << table << ":" << count;
+      first = false;
+    });
+  }
+
+  // phase.section:task_clock_ns/cycles/instructions/llc_misses/branch_misses per commit|... for all phases with commits
+  void writePerfCSV(std::stringstream& log) const {
+    log << ";";
+    bool first = true;
+    forEachPerfPhase([&](uint8_t phase, const PerfCounters::Values&) {
+      auto commits = static_cast<double>(perf_commits_[phase]);
+      for (uint8_t section = 0; section < sections; ++section) {
+        log << (first ? "" : "|") << phase_names[phase] << "." << section_names[section] << ":";
+        for (uint8_t e = 0; e < PerfCounters::events; ++e) {
+          log << (e == 0 ? "" : "/") << perf_values_[phase][section].v[e] / commits;
+        }
+        first = false;
+      }
+    });
+  }
+
+  /* Sets the type of the current transaction, types from first_type on are named by the benchmark */
+  inline void setType(uint8_t type, const char* name) {
+    type_ = type;
+    type_names_[type] = name;
+  }
 
-  inline void abort(bool olap = false) { ((olap) ? olap_aborts_ : aborts_)++; }
+  inline void commit(bool olap = false) {
+    ((olap) ? olap_commits_ : commits_)++;
+    if (sample_)
+      Sampler::add((olap) ? sample_->olap_commits : sample_->commits);
+    if (RunControl::measuring())
+      ((olap) ? window_olap_commits_ : window_commits_)++;
+    if (perf_) {
+      perf_commits_[perfPhase()]++;
+      // without phase timing there is no section switch, read at least once per phase
+      if (perf_phase_ != perfPhase())
+        perfSwitch(perf_section_);
+    }
+  }
 
-  inline void notFound(bool olap = false) { ((olap) ? olap_not_found_ : not_found_)++; }
+  inline void abort(bool olap = false) {
+    ((olap) ? olap_aborts_ : aborts_)++;
+    if (sample_ && !olap)
+      Sampler::add(sample_->aborts);
+    if (!olap && RunControl::measuring())
+      window_aborts_++;
+    uint8_t table;
+    auto reason = AbortReasons::take(table);
+    abort_reasons_[olap ? 1 : type_][static_cast<uint8_t>(reason)][table]++;
+  }
 
-  inline void startWorker() { thread_start_ = std::chrono::system_clock::now(); }
+  inline void notFound(bool olap = false) {
+    ((olap) ? olap_not_found_ : not_found_)++;
+    AbortReasons::reset();
+    abort_reasons_[olap ? 1 : type_][static_cast<uint8_t>(AbortReason::NotFound)][0]++;
+    if (sample_ && !olap)
+      Sampler::add(sample_->not_found);
+  }
+
+  inline void startWorker() {
+    sample_ = Sampler::attach();
+    arrivals_.start();
+    if (PerfCounters::enabled()) {
+      perf_ = std::make_unique<PerfCounters>();
+      if (perf_->open()) {
+        perf_last_ = perf_->read();
+        perf_phase_ = perfPhase();
+        perf_section_ = Execution;
+      } else {
+        perf_.reset();
+      }
+    }
+    thread_start_ = Timer::now();
+  }
 
   inline void stopWorker() {
-    auto ltx =
-        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - thread_start_).count();
-    total_time_ += ltx;
+    total_time_ += Timer::since(thread_start_);
+    perfSwitch(Execution);
+    perf_.reset();
   }
 
-  inline void startTX() { tx_p_ = std::chrono::system_clock::now(); }
+#ifndef NFN_NO_PHASE_TIMING
+  inline void startTX() { tx_p_ = Timer::now(); }
 
   inline uint64_t stopTX(bool olap = false) {
-    auto ltx = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - tx_p_).count();
+    auto ltx = Timer::since(tx_p_);
     ((olap) ? olap_tx_ : tx_) += ltx;
     return ltx;
   }
 
-  inline void startCommit() { commit_p_ = std::chrono::system_clock::now(); }
+  inline void startCommit() {
+    perfSwitch(Commit);
+    commit_p_ = Timer::now();
+  }
 
   inline void stopCommit(bool olap = false) {
-    ((olap) ? olap_commit_ : commit_) +=
-        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - commit_p_).count();
+    ((olap) ? olap_commit_ : commit_) += Timer::since(commit_p_);
+    perfSwitch(Execution);
   }
 
-  inline void startWaitManager() { wait_manager_p_ = std::chrono::system_clock::now(); }
+  inline void startWaitManager() {
+    perfSwitch(WaitManager);
+    wait_manager_p_ = Timer::now();
+  }
 
   inline void stopWaitManager(bool olap = false) {
-    ((olap) ? olap_wait_manager_ : wait_manager_) +=
-        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - wait_manager_p_)
-            .count();
+    auto wait = Timer::since(wait_manager_p_);
+    perfSwitch(Execution);
+    ((olap) ? olap_wait_manager_ : wait_manager_) += wait;
+    if (sample_ && !olap)
+      Sampler::add(sample_->wait_manager, wait);
+  }
+
+  // an open-loop worker waits for the arrival of its next transaction, which starts the latency
+  inline void startLatency() {
+    type_ = 0;
+    if (arrivals_.paced()) {
+      latency_p_ = arrivals_.arrive();
+      queue_ += Timer::since(latency_p_);
+    } else {
+      latency_p_ = Timer::now();
+    }
   }
 
-  inline void startLatency() { latency_p_ = std::chrono::system_clock::now(); }
+  // the start of the latency of the current transaction, s.t. an executor task can carry it between workers
+  inline uint64_t latencyStart() const { return latency_p_; }
+
+  inline void resumeLatency(uint64_t start) {
+    type_ = 0;
+    latency_p_ = start;
+  }
 
   inline void stopLatency(uint64_t tx_time, bool olap = false) {
-    ((olap) ? olap_latency_ : latency_) +=
-        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - latency_p_).count() -
-        tx_time;
+    uint64_t latency = Timer::since(latency_p_);
+    ((olap) ? olap_latency_ : latency_) += latency - tx_time;
+    latencies_[olap ? 1 : type_].record(latency);
+  }
+#else
+  inline void startTX() {}
+  inline uint64_t stopTX(bool = false) { return 0; }
+  inline void startCommit() {}
+  inline void stopCommit(bool = false) {}
+  inline void startWaitManager() {}
+  inline void stopWaitManager(bool = false) {}
+  inline void startLatency() {
+    if (arrivals_.paced())
+      arrivals_.arrive();
   }
+  inline uint64_t latencyStart() const { return 0; }
+  inline void resumeLatency(uint64_t) {}
+  inline void stopLatency(uint64_t, bool = false) {}
+#endif
 };
 };  // namespace common
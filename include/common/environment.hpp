@@ -0,0 +1,108 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include "common/run_control.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unistd.h>
+
+namespace common {
+/*
+ *
+ * Environment checks the NFN_* variables configuring a run before the database is populated. A malformed value, e.g.,
+ * a fourth value of NFN_DURATION or NFN_SAMPLE=10ms, is an error like a malformed option instead of silently falling
+ * back to a default or ignoring a part of it. Unknown NFN_* variables are reported, they are most likely misspelled.
+ *
+ */
+class Environment {
+  struct Variable {
+    const char* name;
+    const char* expected;
+    bool (*valid)(const char* value);
+  };
+
+  // an unsigned integer, decimal or with 0x prefix
+  static inline bool number(const char* value) {
+    char* end;
+    errno = 0;
+    std::strtoull(value, &end, 0);
+    return value[0] != '-' && end != value && *end == '\0' && errno == 0;
+  }
+
+  static inline bool positive(const char* value) { return number(value) && std::strtoull(value, nullptr, 0) > 0; }
+
+  static inline bool share(const char* value) {
+    char* end;
+    double share = std::strtod(value, &end);
+    return end != value && *end == '\0' && share > 0 && share <= 1;
+  }
+
+  static inline bool any(const char*) { return true; }
+
+  static constexpr Variable variables_[] = {
+      {"NFN_DURATION", "\"measurement\" or \"warm-up,measurement[,cool-down]\" seconds",
+       [](const char* value) { return RunControl::configure(value); }},
+      {"NFN_SAMPLE", "an interval in ms, 0 disables sampling", number},
+      {"NFN_PERF", "0 or 1", [](const char* value) { return !std::strcmp(value, "0") || !std::strcmp(value, "1"); }},
+      {"NFN_SNAPSHOT", "a directory", any},
+      {"NFN_SNAPSHOT_MAP", "populate, lazy or hugepages",
+       [](const char* value) {
+         return !std::strcmp(value, "populate") || !std::strcmp(value, "lazy") || !std::strcmp(value, "hugepages");
+       }},
+      {"NFN_TRACE", "a directory", any},
+      {"NFN_TRACE_SEED", "an unsigned integer", number},
+      {"NFN_LOG", "a directory", any},
+      {"NFN_LOG_COMMIT", "sync or epoch",
+       [](const char* value) { return !std::strcmp(value, "sync") || !std::strcmp(value, "epoch"); }},
+      {"NFN_CHECKPOINT", "a positive interval in ms", positive},
+      {"NFN_CHECKPOINT_SHARE", "a share in (0, 1]", share}};
+
+ public:
+  // false after printing an error if a variable is malformed, empty variables count as unset
+  static inline bool check() {
+    bool valid = true;
+    for (auto& variable : variables_) {
+      const char* value = std::getenv(variable.name);
+      if (value != nullptr && value[0] != '\0' && !variable.valid(value)) {
+        std::cout << "Error: " << variable.name << "=" << value << " has to be " << variable.expected << std::endl;
+        valid = false;
+      }
+    }
+    for (char** env = environ; *env != nullptr; ++env) {
+      std::string name{*env, std::strcspn(*env, "=")};
+      bool known = std::any_of(std::begin(variables_), std::end(variables_),
+                               [&](const Variable& variable) { return name == variable.name; });
+      if (name.compare(0, 4, "NFN_") == 0 && !known) {
+        std::cout << "Warning: unknown environment variable " << name << std::endl;
+      }
+    }
+    RunControl::configure(nullptr);
+    return valid;
+  }
+};
+};  // namespace common
@@ -58,13 +58,22 @@ class EpochManagerBase {
   std::array<std::vector<void*>*, 6> global_transaction_information_;  // global
   tbb::spin_mutex global_mutex_;
   thread_local static EpochManager<Allocator>* thread_em_;
+  // the base thread_em_ belongs to, a thread may outlive a database, e.g., when several are run one after another
+  thread_local static uint64_t thread_base_;
+  const uint64_t id_;
   std::unordered_map<uint64_t, EpochManager<Allocator>*> thread_epoch_map_;
 
+  static inline uint64_t nextId() {
+    static std::atomic<uint64_t> ids{0};
+    return ++ids;
+  }
+
   inline EpochManager<Allocator>* get() {
-    if (thread_em_ != nullptr)
+    if (thread_em_ != nullptr && thread_base_ == id_)
       return thread_em_;
 
     thread_em_ = new EpochManager<Allocator>(alloc_, this);
+    thread_base_ = id_;
     global_mutex_.lock();
     thread_epoch_map_.insert(std::make_pair(pthread_self(), thread_em_));
     global_mutex_.unlock();
@@ -72,7 +81,7 @@ class EpochManagerBase {
   }
 
   inline void remove() {
-    if (thread_em_ != nullptr) {
+    if (thread_em_ != nullptr && thread_base_ == id_) {
       global_mutex_.lock();
       thread_epoch_map_.erase(pthread_self());
       global_mutex_.unlock();
@@ -90,6 +99,7 @@ class EpochManagerBase {
         same_epoch_ctr_(),
         global_transaction_information_(),
         global_mutex_(),
+        id_(nextId()),
         thread_epoch_map_(std::thread::hardware_concurrency()) {}
 
   ~EpochManagerBase() {
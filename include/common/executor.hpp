@@ -0,0 +1,131 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include <atomic>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
+namespace common {
+/*
+ *
+ * An Executor runs transactions as tasks on the workers of a run. Every worker owns a queue, submits its transactions
+ * to the back of it and runs them from the front. A worker whose queue is empty steals the newest task of another
+ * worker. A task aborted by the concurrency control is deferred to the back of the queue of the worker running it,
+ * i.e., the worker runs the other ready transactions before the restart instead of waiting for the conflicting ones.
+ *
+ * Tasks run to completion once started: the coordinators keep the state of the running transaction per thread, hence a
+ * worker cannot switch tasks within the commit wait.
+ *
+ */
+template <typename Task>
+class Executor {
+ public:
+  // transactions queued per worker, s.t. idle workers find work to steal
+  static constexpr uint64_t window = 4;
+
+ private:
+  struct alignas(64) Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    std::atomic<uint64_t> size{0};
+  };
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::atomic<uint64_t> submitted_{0};
+  std::atomic<uint64_t> stolen_{0};
+  std::atomic<uint64_t> deferred_{0};
+
+  inline void push(uint64_t worker, Task&& task) {
+    auto& queue = *queues_[worker];
+    std::lock_guard<std::mutex> guard{queue.mutex};
+    queue.tasks.push_back(std::move(task));
+    queue.size.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  inline bool pop(Queue& queue, Task& task, bool front) {
+    if (queue.size.load(std::memory_order_relaxed) == 0)
+      return false;
+    std::lock_guard<std::mutex> guard{queue.mutex};
+    if (queue.tasks.empty())
+      return false;
+    if (front) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    } else {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    }
+    queue.size.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+ public:
+  // empties the queues for a run with workers, before the workers start
+  inline void start(uint64_t workers) {
+    queues_.clear();
+    for (uint64_t i = 0; i < workers; ++i)
+      queues_.push_back(std::make_unique<Queue>());
+    submitted_ = 0;
+    stolen_ = 0;
+    deferred_ = 0;
+  }
+
+  inline uint64_t queued(uint64_t worker) const { return queues_[worker]->size.load(std::memory_order_relaxed); }
+
+  inline void submit(uint64_t worker, Task&& task) {
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    push(worker, std::move(task));
+  }
+
+  // queues an aborted task for its restart
+  inline void defer(uint64_t worker, Task&& task) {
+    deferred_.fetch_add(1, std::memory_order_relaxed);
+    push(worker, std::move(task));
+  }
+
+  // the next task of worker, false if all queues are empty
+  inline bool take(uint64_t worker, Task& task) {
+    if (pop(*queues_[worker], task, true))
+      return true;
+    for (uint64_t n = 1; n < queues_.size(); ++n) {
+      if (pop(*queues_[(worker + n) % queues_.size()], task, false)) {
+        stolen_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  inline void printStatistics() const {
+    if (submitted_ == 0)
+      return;
+    std::cout << "Executor: " << submitted_ << " transactions, " << stolen_ << " stolen, " << deferred_
+              << " restarts deferred" << std::endl;
+  }
+};
+};  // namespace common
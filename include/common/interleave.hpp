@@ -0,0 +1,141 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include <vector>
+#include <stdint.h>
+#ifdef NFN_COROUTINES
+#include <coroutine>
+#include <exception>
+#include <utility>
+#endif
+
+namespace common {
+/*
+ *
+ * Interleave hides the cache misses of the index lookups of a transaction: the hash slot, the bucket, the row and its
+ * read-write list are dependent loads, but the lookups of the keys of a transaction are independent of each other.
+ * Built with NFN_COROUTINES (C++20), a worker runs up to width lookups as coroutines, each one prefetches its next
+ * load and suspends instead of stalling on it, and the worker resumes them round-robin. The transaction then runs on
+ * cached rows. The transactions themselves are not interleaved, the coordinators keep the state of the running
+ * transaction per thread.
+ *
+ */
+class Interleave {
+  static uint64_t width_;  // lookups in flight per worker, 0 runs the transactions without prefetching
+
+ public:
+#ifdef NFN_COROUTINES
+  static constexpr bool supported = true;
+#else
+  static constexpr bool supported = false;
+#endif
+
+  static inline void configure(uint64_t width) { width_ = width; }
+
+  static inline uint64_t width() { return width_; }
+
+#ifdef NFN_COROUTINES
+  // a lookup suspended at its next prefetch, it starts suspended and is destroyed with its handle
+  class Prefetch {
+   public:
+    struct promise_type {
+      Prefetch get_return_object() { return Prefetch{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+      std::suspend_always initial_suspend() noexcept { return {}; }
+      std::suspend_always final_suspend() noexcept { return {}; }
+      void return_void() {}
+      void unhandled_exception() { std::terminate(); }
+    };
+
+   private:
+    std::coroutine_handle<promise_type> handle_;
+
+   public:
+    Prefetch() = default;
+    explicit Prefetch(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+    Prefetch(Prefetch&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Prefetch& operator=(Prefetch&& other) noexcept {
+      if (this != &other) {
+        if (handle_)
+          handle_.destroy();
+        handle_ = std::exchange(other.handle_, nullptr);
+      }
+      return *this;
+    }
+    ~Prefetch() {
+      if (handle_)
+        handle_.destroy();
+    }
+
+    explicit operator bool() const { return static_cast<bool>(handle_); }
+
+    // runs the lookup to its next prefetch, true if it has finished
+    inline bool resume() {
+      handle_.resume();
+      return handle_.done();
+    }
+  };
+
+  // looks up key in index and prefetches the concurrency control columns of the row, columns(offset) prefetches the
+  // values the transaction accesses
+  template <typename Index, typename Key, typename Table, typename Columns>
+  static Prefetch lookup(const Index& index, Key key, const Table& table, Columns columns) {
+    index.prefetch(key);
+    co_await std::suspend_always{};
+    index.prefetchBucket(key);
+    co_await std::suspend_always{};
+    uint64_t offset = 0;
+    if (!index.lookup(key, offset))
+      co_return;
+    table.lsn.prefetch(offset);
+    table.locked.prefetch(offset);
+    table.read_write_table.prefetch(offset);
+    columns(offset);
+    co_await std::suspend_always{};
+    __builtin_prefetch(table.read_write_table[offset]);
+  }
+
+  // runs the lookups start(0) to start(count - 1), at most width of them at a time, until all have finished
+  template <typename Start>
+  static void run(uint64_t count, Start&& start) {
+    thread_local std::vector<Prefetch> lanes;
+    lanes.clear();
+    uint64_t next = 0;
+    for (; next < count && next < width_; ++next) {
+      lanes.push_back(start(next));
+    }
+    for (uint64_t active = lanes.size(); active > 0;) {
+      for (auto& lane : lanes) {
+        if (!lane || !lane.resume())
+          continue;
+        if (next < count) {
+          lane = start(next++);
+        } else {
+          lane = Prefetch{};
+          --active;
+        }
+      }
+    }
+  }
+#endif
+};
+};  // namespace common
@@ -0,0 +1,106 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+
+namespace common {
+/*
+ *
+ * A LatencyHistogram counts latencies in log-linear buckets (HDR-style): values below 2 * sub_buckets are counted
+ * exactly, larger ones in sub_buckets linear buckets per power of two, i.e., with a relative error of at most 1 /
+ * sub_buckets. Every worker records into its own histogram without synchronization, histograms are merged at the end.
+ *
+ */
+class LatencyHistogram {
+ public:
+  static constexpr uint32_t sub_bits = 5;
+  static constexpr uint64_t sub_buckets = 1 << sub_bits;
+  static constexpr uint32_t max_bits = 40;  // 2^40ns, i.e., about 18 minutes
+  static constexpr uint64_t max_value = (1ull << max_bits) - 1;
+
+ private:
+  static inline uint32_t index(uint64_t value) {
+    value = std::min(value, max_value);
+    if (value < 2 * sub_buckets)
+      return value;
+    uint32_t shift = 63 - __builtin_clzll(value) - sub_bits;
+    return shift * sub_buckets + (value >> shift);
+  }
+
+  // the highest value counted in bucket i
+  static inline uint64_t value(uint32_t i) {
+    if (i < 2 * sub_buckets)
+      return i;
+    uint32_t shift = i / sub_buckets - 1;
+    return ((i % sub_buckets + sub_buckets + 1) << shift) - 1;
+  }
+
+ public:
+  static constexpr uint32_t buckets = (max_bits - sub_bits + 1) * sub_buckets;
+
+ private:
+  uint64_t counts_[buckets] = {};
+  uint64_t count_ = 0;
+  uint64_t sum_ = 0;
+  uint64_t max_ = 0;
+
+ public:
+  inline void record(uint64_t value) {
+    counts_[index(value)]++;
+    count_++;
+    sum_ += value;
+    max_ = std::max(max_, value);
+  }
+
+  void merge(const LatencyHistogram& other) {
+    for (uint32_t i = 0; i < buckets; ++i) {
+      counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    max_ = std::max(max_, other.max_);
+  }
+
+  inline uint64_t count() const { return count_; }
+
+  inline uint64_t max() const { return max_; }
+
+  inline double mean() const { return count_ > 0 ? sum_ / static_cast<double>(count_) : 0; }
+
+  // the smallest recorded value, up to the bucket precision, s.t. a fraction q of all values is at most as large
+  uint64_t percentile(double q) const {
+    if (count_ == 0)
+      return 0;
+    uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(q * count_)), 1);
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < buckets; ++i) {
+      seen += counts_[i];
+      if (seen >= rank)
+        return std::min(value(i), max_);
+    }
+    return max_;
+  }
+};
+};  // namespace common
@@ -0,0 +1,205 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace common {
+/*
+ *
+ * Options holds the configuration of a benchmark invocation, given as --name=value (or --name value) arguments, as
+ * name=value lines of a --config file or positionally as in earlier versions:
+ *   benchmark protocol size transactions cores [custom1 custom2 custom3 custom4]
+ * The custom values have a benchmark specific meaning and are reachable by their aliases, e.g., --theta is custom4.
+ * Values may be comma separated lists and ranges first-last[:step], e.g., --cores=1,2,4 or --cores=1-32:4. Options
+ * without value, e.g., --sweep, are set to the empty string. Flags never take the next argument as their value, i.e.,
+ * they may precede the positional arguments and an optional value is given as --sweep=file.
+ *
+ */
+class Options {
+  static constexpr const char* positional_[] = {"benchmark", "protocol", "size",    "transactions", "cores",
+                                                "custom1",   "custom2",  "custom3", "custom4"};
+  static constexpr const char* named_[] = {"repeat", "sweep", "rate", "arrival", "workload", "fields", "scramble",
+                                           "placement", "oversubscribe", "executor", "interleave"};
+  static constexpr const char* flags_[] = {"recover", "sweep", "scramble", "executor", "interleave"};
+
+  std::map<std::string, std::string> values_;
+  bool recover_ = false;
+
+  static inline std::string canonical(const std::string& name) {
+    static const std::map<std::string, std::string> aliases = {
+        {"algorithm", "protocol"}, {"scanners", "custom1"}, {"variant", "custom1"}, {"ops", "custom1"},
+        {"read", "custom2"},       {"scan", "custom3"},     {"theta", "custom4"}};
+    auto alias = aliases.find(name);
+    return alias != aliases.end() ? alias->second : name;
+  }
+
+  static inline bool known(const std::string& name) {
+    auto is = [&](const char* p) { return name == p; };
+    return std::any_of(std::begin(positional_), std::end(positional_), is) ||
+           std::any_of(std::begin(named_), std::end(named_), is);
+  }
+
+  inline bool set(const std::string& name, const std::string& value) {
+    auto key = canonical(name);
+    if (key == "recover") {
+      recover_ = value.empty() || value == "1" || value == "true";
+      return true;
+    }
+    if (key == "config")
+      return load(value);
+    if (!known(key)) {
+      std::cout << "Error: unknown option --" << name << std::endl;
+      return false;
+    }
+    values_[key] = value;
+    return true;
+  }
+
+  inline bool load(const std::string& file) {
+    std::ifstream in{file};
+    if (!in) {
+      std::cout << "Error: cannot read config file " << file << std::endl;
+      return false;
+    }
+    for (std::string line; std::getline(in, line);) {
+      line.erase(std::find(line.begin(), line.end(), '#'), line.end());
+      line.erase(std::remove_if(line.begin(), line.end(), [](char c) { return std::isspace(c); }), line.end());
+      if (line.empty())
+        continue;
+      auto eq = line.find('=');
+      if (eq == std::string::npos || !set(line.substr(0, eq), line.substr(eq + 1)))
+        return false;
+    }
+    return true;
+  }
+
+ public:
+  // parses the arguments, the first positional argument may be "recover"
+  inline bool parse(int argc, char** argv) {
+    uint32_t position = 0;
+    for (int i = 1; i < argc; ++i) {
+      std::string arg{argv[i]};
+      if (arg.compare(0, 2, "--") == 0) {
+        auto eq = arg.find('=');
+        auto name = arg.substr(2, eq - 2);
+        bool flag = std::any_of(std::begin(flags_), std::end(flags_), [&](const char* f) { return name == f; }) ||
+                    i + 1 == argc || std::string{argv[i + 1]}.compare(0, 2, "--") == 0;
+        if (eq == std::string::npos && !flag) {
+          if (!set(name, argv[++i]))
+            return false;
+        } else if (!set(name, eq == std::string::npos ? "" : arg.substr(eq + 1))) {
+          return false;
+        }
+      } else if (position == 0 && i == 1 && arg == "recover") {
+        recover_ = true;
+      } else if (position < std::size(positional_)) {
+        values_[positional_[position++]] = arg;
+      } else {
+        std::cout << "Error: unexpected argument " << arg << std::endl;
+        return false;
+      }
+    }
+    for (auto name : {"benchmark", "protocol", "size", "transactions", "cores"}) {
+      if (!has(name)) {
+        std::cout << "Error: missing option --" << name << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  inline bool recover() const { return recover_; }
+
+  inline bool has(const std::string& name) const { return values_.count(canonical(name)) > 0; }
+
+  inline std::string get(const std::string& name, const std::string& fallback = "") const {
+    auto value = values_.find(canonical(name));
+    return value != values_.end() ? value->second : fallback;
+  }
+
+  inline uint64_t number(const std::string& name, uint64_t fallback = 0) const {
+    auto values = list(name);
+    return values.empty() ? fallback : static_cast<uint64_t>(values.front());
+  }
+
+  inline double real(const std::string& name, double fallback = 0) const {
+    auto values = list(name);
+    return values.empty() ? fallback : values.front();
+  }
+
+  // the comma separated values, e.g., of --protocol=2PL,TicToc
+  inline std::vector<std::string> names(const std::string& name) const {
+    std::vector<std::string> names;
+    std::stringstream value{get(name)};
+    for (std::string n; std::getline(value, n, ',');) {
+      if (!n.empty())
+        names.push_back(n);
+    }
+    return names;
+  }
+
+  // the expanded list of values, e.g., 1-7:2,8 is 1,3,5,7,8
+  inline std::vector<double> list(const std::string& name) const {
+    std::vector<double> values;
+    std::string value = get(name);
+    for (const char* p = value.c_str(); *p != '\0';) {
+      char* end;
+      double first = std::strtod(p, &end);
+      double last = first, step = 1;
+      if (end == p)
+        break;
+      if (*end == '-') {
+        p = end + 1;
+        last = std::strtod(p, &end);
+        if (*end == ':') {
+          p = end + 1;
+          step = std::strtod(p, &end);
+        }
+      }
+      for (double v = first; step > 0 && v <= last + 1e-9; v += step) {
+        values.push_back(v);
+      }
+      p = *end == ',' ? end + 1 : end;
+      if (*end != ',' && *end != '\0')
+        break;
+    }
+    return values;
+  }
+
+  template <typename T>
+  inline std::vector<T> list(const std::string& name) const {
+    auto values = list(name);
+    return std::vector<T>(values.begin(), values.end());
+  }
+};
+};  // namespace common
@@ -0,0 +1,98 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include "common/thread_handler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+namespace common {
+/*
+ *
+ * The ParallelLoader populates a database on all cores. The rows of a table are split into fixed partitions which are
+ * handed out dynamically to pinned worker threads. Every partition seeds its own generator from the load seed, the
+ * stream (table) and its partition number, s.t. the generated content only depends on the seed and neither on the
+ * number of threads nor on the schedule.
+ *
+ */
+class ParallelLoader {
+ private:
+  uint64_t seed_;
+  uint32_t threads_;
+  std::atomic<uint64_t> rows_;
+
+ public:
+  static constexpr uint64_t default_seed = 0x4e464e;
+  static constexpr uint64_t partition_size = 1 << 14;
+
+  ParallelLoader(uint64_t seed = default_seed, uint32_t threads = std::thread::hardware_concurrency())
+      : seed_(seed), threads_(threads > 0 ? threads : 1), rows_(0) {}
+
+  ParallelLoader(const ParallelLoader& other) = delete;
+  ParallelLoader(ParallelLoader&& other) = delete;
+  ParallelLoader& operator=(const ParallelLoader& other) = delete;
+  ParallelLoader& operator=(ParallelLoader&& other) = delete;
+
+  static inline uint64_t partitions(uint64_t rows) { return (rows + partition_size - 1) / partition_size; }
+
+  static inline uint64_t partitionBegin(uint64_t partition) { return partition * partition_size; }
+
+  static inline uint64_t partitionEnd(uint64_t partition, uint64_t rows) {
+    return std::min((partition + 1) * partition_size, rows);
+  }
+
+  // func(partition, gen) loads one partition and returns the number of inserted rows
+  template <typename Func>
+  void run(uint64_t stream, uint64_t partitions, Func&& func) {
+    std::atomic<uint64_t> next{0};
+    auto worker = [&]() {
+      uint64_t rows = 0;
+      for (uint64_t p = next++; p < partitions; p = next++) {
+        std::seed_seq seq{static_cast<uint32_t>(seed_), static_cast<uint32_t>(seed_ >> 32),
+                          static_cast<uint32_t>(stream), static_cast<uint32_t>(p), static_cast<uint32_t>(p >> 32)};
+        std::mt19937 gen(seq);
+        rows += func(p, gen);
+      }
+      rows_ += rows;
+    };
+
+    uint64_t threads = std::min<uint64_t>(threads_, partitions);
+    std::vector<std::unique_ptr<ThreadHandler>> handler;
+    for (uint64_t i = 0; i < threads; ++i) {
+      handler.emplace_back(std::make_unique<ThreadHandler>(i % std::thread::hardware_concurrency()));
+      handler.back()->run(worker);
+    }
+    for (auto& h : handler) {
+      h->join();
+    }
+  }
+
+  inline uint64_t rows() const { return rows_; }
+
+  inline uint64_t seed() const { return seed_; }
+};
+};  // namespace common
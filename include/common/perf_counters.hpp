@@ -0,0 +1,160 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace common {
+/*
+ *
+ * PerfCounters reads the performance counters of the calling thread with perf_event_open: task clock, cycles,
+ * instructions, last level cache misses and branch misses. Thread counters form one group read by a single system
+ * call; inherited counters (e.g., of the population, which includes the loader threads started afterwards) are read
+ * one by one. Events the machine does not support, e.g., hardware events in VMs without PMU, are skipped and read 0.
+ * The counters are enabled at runtime by NFN_PERF=1.
+ *
+ */
+class PerfCounters {
+ public:
+  enum Event : uint8_t { TaskClock, Cycles, Instructions, LLCMisses, BranchMisses, events };
+
+  struct Values {
+    uint64_t v[events] = {};
+
+    inline Values& operator+=(const Values& other) {
+      for (uint8_t e = 0; e < events; ++e) {
+        v[e] += other.v[e];
+      }
+      return *this;
+    }
+
+    inline Values operator-(const Values& other) const {
+      Values diff;
+      for (uint8_t e = 0; e < events; ++e) {
+        diff.v[e] = v[e] - other.v[e];
+      }
+      return diff;
+    }
+  };
+
+  static constexpr const char* names[events] = {"task_clock_ns", "cycles", "instructions", "llc_misses",
+                                                "branch_misses"};
+
+ private:
+  static bool enabled_;
+  static std::atomic<uint8_t> supported_;  // bit per event which could be opened at least once
+
+  bool inherit_ = false;
+  int fds_[events] = {-1, -1, -1, -1, -1};
+
+  static inline perf_event_attr attribute(Event event, bool inherit) {
+    static constexpr uint32_t types[events] = {PERF_TYPE_SOFTWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+                                               PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE};
+    static constexpr uint64_t configs[events] = {PERF_COUNT_SW_TASK_CLOCK, PERF_COUNT_HW_CPU_CYCLES,
+                                                 PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+                                                 PERF_COUNT_HW_BRANCH_MISSES};
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = types[event];
+    attr.config = configs[event];
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.inherit = inherit;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    if (!inherit)
+      attr.read_format |= PERF_FORMAT_GROUP;
+    return attr;
+  }
+
+  // scales a value of a multiplexed counter to the time it was enabled
+  static inline uint64_t scale(uint64_t value, uint64_t enabled, uint64_t running) {
+    return running > 0 && running < enabled ? static_cast<uint64_t>(value * (enabled / static_cast<double>(running)))
+                                            : value;
+  }
+
+ public:
+  static inline void configure(const char* perf) {
+    enabled_ = perf != nullptr && perf[0] != '\0' && std::strcmp(perf, "0") != 0;
+  }
+
+  static inline bool enabled() { return enabled_; }
+
+  static inline bool supported(Event event) { return supported_.load() & (1 << event); }
+
+  PerfCounters() = default;
+  PerfCounters(const PerfCounters& other) = delete;
+  PerfCounters& operator=(const PerfCounters& other) = delete;
+
+  ~PerfCounters() {
+    for (auto fd : fds_) {
+      if (fd >= 0)
+        close(fd);
+    }
+  }
+
+  // opens the counters of the calling thread, false if not even the task clock is available
+  inline bool open(bool inherit = false) {
+    inherit_ = inherit;
+    int leader = -1;
+    for (uint8_t e = 0; e < events; ++e) {
+      auto attr = attribute(static_cast<Event>(e), inherit);
+      fds_[e] = syscall(SYS_perf_event_open, &attr, 0, -1, inherit ? -1 : leader, 0);
+      if (fds_[e] >= 0) {
+        supported_.fetch_or(1 << e);
+        if (leader < 0)
+          leader = fds_[e];
+      }
+    }
+    return fds_[TaskClock] >= 0;
+  }
+
+  inline Values read() const {
+    Values values;
+    if (inherit_) {
+      for (uint8_t e = 0; e < events; ++e) {
+        uint64_t data[3];
+        if (fds_[e] >= 0 && ::read(fds_[e], data, sizeof(data)) == sizeof(data))
+          values.v[e] = scale(data[0], data[1], data[2]);
+      }
+      return values;
+    }
+    uint64_t data[3 + events];  // nr, time enabled, time running and the values in the order of opening
+    auto size = ::read(fds_[TaskClock], data, sizeof(data));
+    if (size < static_cast<ssize_t>(3 * sizeof(uint64_t)))
+      return values;
+    uint64_t n = 0;
+    for (uint8_t e = 0; e < events && n < data[0]; ++e) {
+      if (fds_[e] >= 0)
+        values.v[e] = scale(data[3 + n++], data[1], data[2]);
+    }
+    return values;
+  }
+};
+};  // namespace common
@@ -0,0 +1,246 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include "common/backoff.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include <sched.h>
+#include <stdint.h>
+
+namespace common {
+/*
+ *
+ * Placement maps the workers of a run onto CPUs. The topology, i.e., the socket and the physical core of every online
+ * CPU, is read from /sys/devices/system/cpu and limited to the affinity mask of the process (cpusets of containers,
+ * taskset). A policy orders the CPUs and worker i runs on the i-th CPU of the order (modulo the number of CPUs):
+ *   linear   the CPU numbering of the kernel (default)
+ *   compact  all hardware threads of a core, then the next core of the socket, then the next socket
+ *   scatter  one thread per core alternating between the sockets, then the second threads
+ *   cores    one thread per core socket by socket, then the second threads (physical cores first)
+ *   a list   the given CPUs, e.g., 0,2,4-7
+ *   none     the workers are not pinned, the scheduler places them on the CPUs of the linear order
+ *
+ * A run may be limited to the first CPUs of the order, s.t. several workers share a CPU (oversubscription).
+ *
+ */
+class Placement {
+ public:
+  struct Cpu {
+    uint32_t id;
+    uint32_t socket;
+    uint32_t core;
+    uint32_t thread;  // the rank among the hardware threads of its core
+  };
+
+ private:
+  static std::string policy_;
+  static std::vector<Cpu> cpus_;
+  static std::vector<uint32_t> order_;
+  static uint64_t limit_;
+
+  static inline bool readNumber(const std::string& file, uint32_t& number) {
+    std::ifstream in{file};
+    return static_cast<bool>(in >> number);
+  }
+
+  // the online CPUs the process may run on, all CPUs of hardware_concurrency on machines without sysfs
+  static inline std::vector<Cpu> readTopology() {
+    std::vector<uint32_t> ids;
+    std::ifstream online{"/sys/devices/system/cpu/online"};
+    std::string list;
+    if (online >> list)
+      ids = parseList(list);
+    if (ids.empty()) {
+      for (uint32_t id = 0; id < std::max(std::thread::hardware_concurrency(), 1u); ++id)
+        ids.push_back(id);
+    }
+
+    cpu_set_t mask;
+    bool masked = sched_getaffinity(0, sizeof(cpu_set_t), &mask) == 0;
+    std::vector<Cpu> cpus;
+    for (auto id : ids) {
+      if (!masked || (id < CPU_SETSIZE && CPU_ISSET(id, &mask)))
+        cpus.push_back(Cpu{id, 0, id, 0});
+    }
+    if (cpus.empty()) {
+      for (auto id : ids)
+        cpus.push_back(Cpu{id, 0, id, 0});
+    }
+
+    for (auto& cpu : cpus) {
+      std::string topology = "/sys/devices/system/cpu/cpu" + std::to_string(cpu.id) + "/topology/";
+      uint32_t socket, core;
+      if (readNumber(topology + "physical_package_id", socket) && readNumber(topology + "core_id", core)) {
+        cpu.socket = socket;
+        cpu.core = core;
+      }
+    }
+    for (auto& cpu : cpus) {
+      cpu.thread = std::count_if(cpus.begin(), cpus.end(), [&](const Cpu& other) {
+        return other.socket == cpu.socket && other.core == cpu.core && other.id < cpu.id;
+      });
+    }
+    return cpus;
+  }
+
+  template <typename Key>
+  static inline void orderBy(Key&& key) {
+    auto cpus = cpus_;
+    std::stable_sort(cpus.begin(), cpus.end(), [&](const Cpu& a, const Cpu& b) { return key(a) < key(b); });
+    order_.clear();
+    for (auto& cpu : cpus)
+      order_.push_back(cpu.id);
+  }
+
+  // the rank of the core of cpu within its socket
+  static inline uint32_t coreRank(const Cpu& cpu) {
+    std::vector<uint32_t> cores;
+    for (auto& other : cpus_) {
+      if (other.socket == cpu.socket && other.thread == 0 && other.core < cpu.core)
+        cores.push_back(other.core);
+    }
+    return cores.size();
+  }
+
+ public:
+  // selects a policy by name, false if it is unknown
+  static inline bool configure(const std::string& policy) {
+    if (cpus_.empty())
+      cpus_ = readTopology();
+    policy_ = policy;
+    if (policy == "linear" || policy == "none") {
+      orderBy([](const Cpu& cpu) { return cpu.id; });
+    } else if (policy == "compact") {
+      orderBy([](const Cpu& cpu) { return std::make_tuple(cpu.socket, cpu.core, cpu.thread); });
+    } else if (policy == "scatter") {
+      orderBy([](const Cpu& cpu) { return std::make_tuple(cpu.thread, coreRank(cpu), cpu.socket); });
+    } else if (policy == "cores") {
+      orderBy([](const Cpu& cpu) { return std::make_tuple(cpu.thread, cpu.socket, cpu.core); });
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  // places the workers on the given CPUs, false if one of them is not online or not in the affinity mask
+  static inline bool configure(const std::string& policy, const std::vector<uint32_t>& cpus) {
+    if (cpus_.empty())
+      cpus_ = readTopology();
+    for (auto id : cpus) {
+      if (std::none_of(cpus_.begin(), cpus_.end(), [&](const Cpu& cpu) { return cpu.id == id; }))
+        return false;
+    }
+    policy_ = policy;
+    order_ = cpus;
+    return !order_.empty();
+  }
+
+  // the CPUs of a list of the kernel, e.g., 0-3,8 of /sys/devices/system/cpu/online, empty if it is malformed
+  static inline std::vector<uint32_t> parseList(const std::string& list) {
+    std::vector<uint32_t> ids;
+    std::stringstream ranges{list};
+    try {
+      for (std::string range; std::getline(ranges, range, ',');) {
+        auto dash = range.find('-');
+        uint32_t first = std::stoul(range.substr(0, dash));
+        uint32_t last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+        for (uint32_t id = first; id <= last; ++id)
+          ids.push_back(id);
+      }
+    } catch (const std::logic_error&) {
+      return {};
+    }
+    return ids;
+  }
+
+  static inline const std::string& policy() { return policy_; }
+
+  static inline bool pinned() { return policy_ != "none"; }
+
+  // restricts the workers to the first cpus CPUs of the order, 0 for all
+  static inline void limit(uint64_t cpus) { limit_ = cpus; }
+
+  // the number of CPUs the workers run on
+  static inline uint64_t cpus() {
+    if (order_.empty())
+      configure("linear");
+    return limit_ == 0 ? order_.size() : std::min<uint64_t>(limit_, order_.size());
+  }
+
+  static inline uint32_t cpu(uint64_t worker) { return order_[worker % cpus()]; }
+
+  // the CPUs worker may run on, i.e., its CPU or all CPUs of the run if the workers are not pinned
+  static inline std::vector<uint32_t> allowed(uint64_t worker) {
+    if (pinned())
+      return {cpu(worker)};
+    return std::vector<uint32_t>(order_.begin(), order_.begin() + cpus());
+  }
+
+  // more workers than CPUs or unpinned workers, i.e., a waiting worker may hold the CPU of the one it waits for
+  static inline bool oversubscribed(uint64_t workers) { return !pinned() || workers > cpus(); }
+
+  // pins the calling worker onto its CPU and waits until the scheduler moved it there, a worker whose CPU can not be
+  // set runs unpinned instead of waiting for a CPU it never gets
+  static inline void wait(uint64_t worker) {
+    if (!pinned())
+      return;
+    auto id = cpu(worker);
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(id, &mask);
+    if (sched_setaffinity(0, sizeof(cpu_set_t), &mask) != 0)
+      return;
+    for (Backoff backoff; static_cast<uint32_t>(sched_getcpu()) != id;) {
+      backoff.pause();
+    }
+  }
+
+  static inline void printTopology() {
+    if (cpus_.empty())
+      cpus_ = readTopology();
+    uint64_t sockets = 0, cores = 0;
+    for (auto& cpu : cpus_) {
+      sockets = std::max<uint64_t>(sockets, cpu.socket + 1);
+      cores += cpu.thread == 0;
+    }
+    std::cout << "Topology: " << sockets << " sockets, " << cores << " cores, " << cpus_.size() << " threads"
+              << std::endl;
+  }
+
+  static inline void print(uint64_t workers) {
+    std::cout << "Placement: " << policy_ << ", " << workers << " workers on " << cpus() << " cpus";
+    if (pinned()) {
+      for (uint64_t i = 0; i < workers; ++i)
+        std::cout << (i == 0 ? " " : ",") << cpu(i);
+    }
+    std::cout << ", " << Backoff::name() << " backoff" << std::endl;
+  }
+};
+};  // namespace common
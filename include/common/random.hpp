@@ -0,0 +1,86 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include <random>
+#include <stdint.h>
+
+namespace common {
+/*
+ *
+ * Random is xoshiro256** (Blackman and Vigna), a small and fast generator for the benchmark clients. Its state is
+ * seeded by splitmix64, it satisfies UniformRandomBitGenerator and can be used with the standard distributions, but
+ * real and below avoid their overhead in the hot paths of the clients.
+ *
+ */
+class Random {
+  uint64_t s_[4];
+
+  static inline uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+ public:
+  using result_type = uint64_t;
+
+  explicit Random(uint64_t seed = 0) { this->seed(seed); }
+
+  inline void seed(uint64_t seed) {
+    for (auto& s : s_) {
+      uint64_t z = (seed += 0x9e3779b97f4a7c15);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+      s = z ^ (z >> 31);
+    }
+  }
+
+  static constexpr result_type min() { return 0; }
+
+  static constexpr result_type max() { return ~0ull; }
+
+  inline result_type operator()() {
+    uint64_t result = rotl(s_[1] * 5, 7) * 9;
+    uint64_t t = s_[1] << 17;
+    s_[2] ^= s_[0];
+    s_[3] ^= s_[1];
+    s_[1] ^= s_[2];
+    s_[0] ^= s_[3];
+    s_[2] ^= t;
+    s_[3] = rotl(s_[3], 45);
+    return result;
+  }
+
+  // uniform in [0, 1)
+  inline double real() { return static_cast<double>(operator()() >> 11) * 0x1.0p-53; }
+
+  // uniform in [0, n), by multiplication instead of modulo
+  inline uint64_t below(uint64_t n) {
+    return static_cast<uint64_t>((static_cast<__uint128_t>(operator()()) * n) >> 64);
+  }
+};
+
+// uniform in [0, 1) for any generator, the overload for Random takes its fast path
+template <typename Generator>
+inline double canonical(Generator& gen) {
+  return std::generate_canonical<double, 53>(gen);
+}
+
+inline double canonical(Random& gen) { return gen.real(); }
+};  // namespace common
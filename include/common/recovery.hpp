@@ -0,0 +1,392 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include "common/checkpointer.hpp"
+#include "common/parallel_loader.hpp"
+#include "common/redo_log.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace common {
+/*
+ *
+ * Recovery restores the logged columns of a populated database from the latest complete checkpoint and the redo log
+ * in its directory. The checkpoint columns are read in parallel row partitions. Afterwards, the log records of the
+ * checkpoint epoch up to the durable epoch, and with synchronous commits up to the first missing lsn, are replayed.
+ * Their entries are partitioned by column and row across all threads. Every thread sorts its entries by lsn and
+ * applies them in this order, i.e., the last writer in commit order wins, while entries of one record keep their
+ * write order.
+ *
+ * Columns and indexes which are not logged, e.g., rows inserted by the benchmarks, are left as populated.
+ *
+ */
+class Recovery {
+ private:
+  struct Column {
+    std::string name;
+    void* vector;
+    uint64_t element_size;
+    uint64_t rows;
+    void (*apply)(void*, uint64_t, const char*);
+    bool (*read)(void*, int, uint64_t, uint64_t, uint64_t);
+  };
+
+  struct Entry {
+    uint64_t lsn;
+    const RedoLog::EntryHeader* entry;
+  };
+
+  std::string path_;
+  uint32_t threads_;
+  std::vector<std::string> names_;
+  std::vector<Column> columns_;
+  std::string population_;
+
+  std::string checkpoint_;
+  uint64_t epoch_;
+  uint64_t durable_;
+
+  uint64_t checkpoint_bytes_;
+  uint64_t checkpoint_time_;
+  uint64_t log_bytes_;
+  uint64_t records_;
+  uint64_t dropped_;
+  uint64_t rows_;
+  uint64_t replay_time_;
+
+  template <typename Vector>
+  static void apply(void* vector, uint64_t offset, const char* value) {
+    typename Vector::value_type v;
+    std::memcpy(&v, value, sizeof(v));
+    reinterpret_cast<Vector*>(vector)->replace(offset, v);
+  }
+
+  template <typename Vector>
+  static bool read(void* vector, int fd, uint64_t offset, uint64_t begin, uint64_t end) {
+    return reinterpret_cast<Vector*>(vector)->read(fd, offset, begin, end);
+  }
+
+  inline std::string file(const std::string& name) const { return path_ + "/" + name; }
+
+  inline bool error(const std::string& name, const char* what) const {
+    std::cout << "Recovery error: " << what << " " << name << " - " << strerror(errno) << std::endl;
+    return false;
+  }
+
+  // the complete checkpoint with the highest sequence number, if any
+  inline bool findCheckpoint() {
+    DIR* dir = opendir(path_.c_str());
+    if (dir == nullptr)
+      return error(path_, "cannot open");
+    uint64_t sequence = 0;
+    while (auto entry = readdir(dir)) {
+      std::string name{entry->d_name};
+      struct stat st;
+      if (name.compare(0, 11, "checkpoint.") != 0 || stat((file(name) + "/manifest").c_str(), &st) != 0)
+        continue;
+      uint64_t n = std::strtoull(name.c_str() + 11, nullptr, 10);
+      if (n > sequence) {
+        sequence = n;
+        checkpoint_ = file(name);
+      }
+    }
+    closedir(dir);
+    if (checkpoint_.empty())
+      return true;
+
+    Checkpointer::Header header;
+    int fd = readHeader(checkpoint_ + "/manifest", 0, header);
+    if (fd < 0)
+      return false;
+    close(fd);
+    epoch_ = header.epoch;
+    return true;
+  }
+
+  inline int readHeader(const std::string& name, uint64_t element_size, Checkpointer::Header& header) const {
+    int fd = ::open(name.c_str(), O_RDONLY);
+    if (fd < 0) {
+      error(name, "cannot open");
+      return -1;
+    }
+    if (pread(fd, &header, sizeof(header), 0) != sizeof(header) || header.magic != Checkpointer::magic ||
+        header.element_size != element_size) {
+      errno = EINVAL;
+      error(name, "incompatible file");
+      close(fd);
+      return -1;
+    }
+    return fd;
+  }
+
+  inline bool loadCheckpoint() {
+    ParallelLoader loader{ParallelLoader::default_seed, threads_};
+    std::atomic<bool> good{true};
+    for (auto& c : columns_) {
+      Checkpointer::Header header;
+      int fd = readHeader(checkpoint_ + "/" + c.name + ".col", c.element_size, header);
+      if (fd < 0)
+        return false;
+      uint64_t rows = std::min(header.rows, c.rows);
+      loader.run(0, ParallelLoader::partitions(rows), [&](uint64_t partition, std::mt19937&) {
+        auto begin = ParallelLoader::partitionBegin(partition);
+        auto end = ParallelLoader::partitionEnd(partition, rows);
+        if (!c.read(c.vector, fd, Checkpointer::page_size, begin, end))
+          good = false;
+        return 0;
+      });
+      close(fd);
+      if (!good)
+        return error(c.name, "cannot read checkpoint column");
+      checkpoint_bytes_ += rows * c.element_size;
+    }
+    return true;
+  }
+
+  // collects the records of the checkpoint epoch up to the durable epoch, a torn record ends the log; with synchronous
+  // commits the log also ends at the first missing lsn, no record behind it has been acknowledged
+  inline void scan(const char* log, uint64_t size, std::vector<const RedoLog::RecordHeader*>& records) {
+    std::vector<const RedoLog::RecordHeader*> scanned;
+    for (uint64_t pos = RedoLog::page_size; pos + sizeof(RedoLog::RecordHeader) <= size;) {
+      auto record = reinterpret_cast<const RedoLog::RecordHeader*>(log + pos);
+      uint64_t end = pos + sizeof(RedoLog::RecordHeader) + record->size;
+      if (record->lsn == 0 || end > size)
+        break;
+      scanned.push_back(record);
+      pos = end;
+    }
+
+    uint64_t gap = RedoLog::idle;
+    if (durable_ == RedoLog::idle) {
+      std::vector<uint64_t> lsns;
+      for (auto record : scanned) {
+        lsns.push_back(record->lsn);
+      }
+      std::sort(lsns.begin(), lsns.end());
+      gap = lsns.size() + 1;
+      for (uint64_t i = 0; i < lsns.size(); ++i) {
+        if (lsns[i] != i + 1) {
+          gap = i + 1;
+          break;
+        }
+      }
+    }
+
+    for (auto record : scanned) {
+      if (record->lsn >= gap)
+        dropped_++;
+      else if (record->epoch >= epoch_ && record->epoch <= durable_)
+        records.push_back(record);
+    }
+  }
+
+  inline void replay(const std::vector<const RedoLog::RecordHeader*>& records) {
+    uint64_t partitions = threads_;
+    std::vector<std::vector<std::vector<Entry>>> entries(partitions, std::vector<std::vector<Entry>>(partitions));
+    ParallelLoader loader{ParallelLoader::default_seed, threads_};
+
+    // every chunk of records distributes its entries to the partitions of their rows
+    loader.run(0, partitions, [&](uint64_t chunk, std::mt19937&) {
+      auto begin = records.size() * chunk / partitions;
+      auto end = records.size() * (chunk + 1) / partitions;
+      for (auto n = begin; n < end; ++n) {
+        auto data = reinterpret_cast<const char*>(records[n] + 1);
+        for (uint64_t pos = 0; pos < records[n]->size;) {
+          auto entry = reinterpret_cast<const RedoLog::EntryHeader*>(data + pos);
+          pos += sizeof(RedoLog::EntryHeader) + ((entry->size + 7) & ~7ull);
+          if (entry->column >= columns_.size() || columns_[entry->column].vector == nullptr ||
+              entry->size != columns_[entry->column].element_size || entry->offset >= columns_[entry->column].rows)
+            continue;
+          auto p = (entry->offset * 0x9e3779b97f4a7c15 + entry->column) % partitions;
+          entries[chunk][p].push_back(Entry{records[n]->lsn, entry});
+        }
+      }
+      return 0;
+    });
+
+    // chunks are concatenated in log order, s.t. the stable sort keeps the entry order within a record
+    std::atomic<uint64_t> rows{0};
+    loader.run(0, partitions, [&](uint64_t p, std::mt19937&) {
+      std::vector<Entry> partition;
+      for (uint64_t chunk = 0; chunk < partitions; ++chunk) {
+        partition.insert(partition.end(), entries[chunk][p].begin(), entries[chunk][p].end());
+        std::vector<Entry>().swap(entries[chunk][p]);
+      }
+      std::stable_sort(partition.begin(), partition.end(),
+                       [](const Entry& a, const Entry& b) { return a.lsn < b.lsn; });
+      for (auto& e : partition) {
+        auto& c = columns_[e.entry->column];
+        c.apply(c.vector, e.entry->offset, reinterpret_cast<const char*>(e.entry + 1));
+      }
+      rows += partition.size();
+      return 0;
+    });
+    rows_ = rows;
+  }
+
+ public:
+  Recovery(const std::string& directory, uint32_t threads = std::thread::hardware_concurrency())
+      : path_(directory),
+        threads_(threads > 0 ? threads : 1),
+        epoch_(0),
+        durable_(RedoLog::idle),
+        checkpoint_bytes_(0),
+        checkpoint_time_(0),
+        log_bytes_(0),
+        records_(0),
+        dropped_(0),
+        rows_(0),
+        replay_time_(0) {}
+
+  Recovery(const Recovery& other) = delete;
+  Recovery(Recovery&& other) = delete;
+  Recovery& operator=(const Recovery& other) = delete;
+  Recovery& operator=(Recovery&& other) = delete;
+
+  // the population the database was loaded with, if set, the log has to be based on the same population
+  inline void setPopulation(const std::string& population) { population_ = population; }
+
+  // reads the column names of the log, checks its population and locates the latest checkpoint
+  bool open() {
+    if (!population_.empty()) {
+      std::ifstream population(file("population"));
+      std::string name;
+      if (!population || !std::getline(population, name))
+        return error(file("population"), "cannot read");
+      if (name != population_) {
+        std::cout << "Recovery error: the log is based on " << name << ", the database on " << population_ << std::endl;
+        return false;
+      }
+    }
+    std::ifstream columns(file("columns"));
+    if (!columns)
+      return error(file("columns"), "cannot open");
+    for (std::string name; std::getline(columns, name);) {
+      names_.push_back(name);
+    }
+    columns_.resize(names_.size(), Column{"", nullptr, 0, 0, nullptr, nullptr});
+    return findCheckpoint();
+  }
+
+  inline const std::string& checkpoint() const { return checkpoint_; }
+
+  // the records behind the first missing lsn, which were not replayed
+  inline uint64_t dropped() const { return dropped_; }
+
+  /* Maps a column of the database to its log id, visitor interface shared with common::Snapshot */
+  template <typename Vector>
+  inline void column(const std::string& name, Vector& vector) {
+    auto it = std::find(names_.begin(), names_.end(), name);
+    if (it == names_.end())
+      return;
+    columns_[it - names_.begin()] =
+        Column{name, &vector, Vector::element_size, vector.size(), &Recovery::apply<Vector>, &Recovery::read<Vector>};
+  }
+
+  template <typename Vector, typename Func>
+  inline void rebuild(Vector&, uint64_t, Func&&) {}
+
+  template <typename Map>
+  inline void index(const std::string&, Map&) {}
+
+  // loads the checkpoint and replays the log on top of it, must be called after visiting the database
+  bool run() {
+    for (auto& c : columns_) {
+      if (c.vector == nullptr) {
+        errno = EINVAL;
+        return error(file("columns"), "does not match the database");
+      }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (!checkpoint_.empty() && !loadCheckpoint())
+      return false;
+    checkpoint_time_ =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    int fd = ::open(file("redo.log").c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0)
+      return error(file("redo.log"), "cannot open");
+    uint64_t size = st.st_size;
+    void* ptr = size > 0 ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (ptr == MAP_FAILED)
+      return error(file("redo.log"), "cannot map");
+    auto log = reinterpret_cast<const char*>(ptr);
+    auto header = reinterpret_cast<const RedoLog::LogHeader*>(log);
+    if (size < RedoLog::page_size || header->magic != RedoLog::magic) {
+      munmap(ptr, size);
+      errno = EINVAL;
+      return error(file("redo.log"), "incompatible file");
+    }
+
+    // only records of durable epochs have been acknowledged
+    durable_ = header->durable_epoch;
+    std::vector<const RedoLog::RecordHeader*> records;
+    scan(log, size, records);
+    replay(records);
+    munmap(ptr, size);
+
+    records_ = records.size();
+    log_bytes_ = size - RedoLog::page_size;
+    replay_time_ =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    return true;
+  }
+
+  void printStatistics() {
+    auto ms = [](uint64_t us) { return us / 1000.0; };
+    auto mbs = [](uint64_t bytes, uint64_t us) { return bytes / 1024.0 / 1024.0 / std::max<uint64_t>(us, 1) * 1e6; };
+    if (!checkpoint_.empty()) {
+      std::cout << "Recovery: checkpoint " << checkpoint_ << " (epoch " << epoch_ << "), "
+                << checkpoint_bytes_ / 1024.0 / 1024.0 << "MB in " << ms(checkpoint_time_) << "ms ("
+                << mbs(checkpoint_bytes_, checkpoint_time_) << "MB/s)" << std::endl;
+    } else {
+      std::cout << "Recovery: no checkpoint, replaying the whole log" << std::endl;
+    }
+    std::cout << "Recovery: replayed " << records_ << " records, " << rows_ << " rows of "
+              << log_bytes_ / 1024.0 / 1024.0 << "MB log in " << ms(replay_time_) << "ms ("
+              << mbs(log_bytes_, replay_time_) << "MB/s, "
+              << static_cast<uint64_t>(rows_ / (std::max<uint64_t>(replay_time_, 1) / 1e6)) << " rows/s) on "
+              << threads_ << " threads" << std::endl;
+    if (dropped_ > 0)
+      std::cout << "Recovery: dropped " << dropped_ << " records behind the first missing lsn" << std::endl;
+  }
+};
+};  // namespace common
@@ -0,0 +1,573 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include "common/backoff.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace common {
+/*
+ *
+ * The RedoLog makes the write sets of committing transactions durable before the commit is acknowledged. Every worker
+ * serializes its write set into a private ring buffer. A dedicated writer thread collects the pending records of all
+ * buffers, writes them to one log file and forces them with a single fdatasync (group commit). Afterwards, it
+ * publishes the flushed lsn, i.e., the largest lsn up to which every reserved lsn is flushed, and the workers waiting
+ * for their records are released. A commit is only acknowledged once the flushed lsn covers its own, hence the log
+ * never holds an acknowledged record without the records of its predecessors and recovery stops at the first gap.
+ *
+ * With asynchronous commits (Silo-style), workers do not wait for the flush. Every record carries the epoch of the
+ * EpochManagerBase counter at its commit and the writer publishes the durable epoch, i.e., the largest epoch whose
+ * records are all flushed, in the log header. A commit is acknowledged once its epoch is durable, hence the client
+ * observes a bounded durability delay while the workers never block on I/O.
+ *
+ * A record is a RecordHeader followed by one entry per written value in write order. Columns are identified by the
+ * order in which they are registered through Database::snapshotDatabase; their names are stored in the columns file
+ * next to the log s.t. the log can be mapped back onto the tables. Entries address rows by their offset, hence the
+ * population file names the population the log is based on.
+ *
+ * Fuzzy checkpoints (common::Checkpointer) may copy the dirty values of transactions which abort later on. Hence, with
+ * logAborts the undo of an aborted transaction is logged as a compensation record holding the restored values.
+ *
+ */
+class RedoLog {
+ public:
+  static constexpr uint64_t page_size = 1 << 12;
+  static constexpr uint64_t magic = 0x4e464e5245444f4c;  // NFNREDOL
+  static constexpr uint64_t default_capacity = 1 << 24;
+  static constexpr uint64_t idle = std::numeric_limits<uint64_t>::max();
+
+  struct LogHeader {
+    uint64_t magic;
+    uint64_t durable_epoch;
+  };
+
+  struct RecordHeader {
+    uint64_t lsn;
+    uint64_t epoch;
+    uint32_t size;
+    uint32_t entries;
+  };
+
+  struct EntryHeader {
+    uint32_t column;
+    uint32_t size;
+    uint64_t offset;
+  };
+
+ private:
+  struct Buffer {
+    std::unique_ptr<char[]> data;
+    uint64_t capacity;
+    uint64_t written = 0;  // owned by the writer
+    std::atomic<uint64_t> records{0};  // committed, sampled by the checkpointer
+    uint64_t epoch = 0;
+    std::vector<char> record;
+    std::vector<uint64_t> entries;
+
+    // commits waiting for their epoch to become durable, only used with asynchronous commits, acknowledged by the
+    // writer once it published their epoch s.t. the delay does not include the time until the worker commits again
+    std::mutex pending_mutex;
+    std::deque<std::pair<uint64_t, std::chrono::steady_clock::time_point>> pending;
+    uint64_t acknowledged = 0;
+    uint64_t delay = 0;
+    uint64_t max_delay = 0;
+
+    alignas(64) std::atomic<uint64_t> tail{0};
+    alignas(64) std::atomic<uint64_t> flushed{0};
+    alignas(64) std::atomic<uint64_t> active{idle};  // epoch of the commit in flight
+    alignas(64) std::atomic<uint64_t> reserved{idle};  // lower bound of the reserved lsn not yet emitted
+
+    Buffer(uint64_t capacity) : data(new char[capacity]), capacity(capacity) {}
+
+    inline void copy(uint64_t pos, const char* src, uint64_t size) {
+      auto begin = pos % capacity;
+      auto first = std::min(size, capacity - begin);
+      std::memcpy(data.get() + begin, src, first);
+      std::memcpy(data.get(), src + first, size - first);
+    }
+
+    inline void acknowledge(uint64_t durable, std::chrono::steady_clock::time_point now) {
+      std::lock_guard<std::mutex> guard(pending_mutex);
+      while (!pending.empty() && pending.front().first <= durable) {
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(now - pending.front().second).count();
+        delay += us;
+        max_delay = std::max<uint64_t>(max_delay, us);
+        acknowledged++;
+        pending.pop_front();
+      }
+    }
+  };
+
+  static thread_local Buffer* local_buffer_;
+  static thread_local uint64_t local_id_;
+  static std::atomic<uint64_t> instances_;
+
+  std::string path_;
+  bool async_;
+  uint64_t id_;
+  uint64_t capacity_;
+  std::chrono::microseconds interval_;
+  int fd_;
+  uint64_t file_size_;
+
+  std::unordered_map<const void*, uint32_t> columns_;
+  std::vector<std::string> names_;
+  std::string population_;
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+  std::thread writer_;
+  std::atomic<bool> stop_;
+  bool log_aborts_;
+  std::atomic<uint64_t> lsn_;
+  std::atomic<uint64_t> flushed_lsn_;
+  std::atomic<uint64_t>* epochs_;
+  std::atomic<uint64_t> durable_;
+
+  uint64_t bytes_;
+  uint64_t flushes_;
+  uint64_t flush_time_;
+
+  inline std::string file(const std::string& name) const { return path_ + "/" + name; }
+
+  inline bool writeAll(const char* data, uint64_t size, uint64_t offset) {
+    for (uint64_t written = 0; written < size;) {
+      auto res = pwrite(fd_, data + written, size - written, offset + written);
+      if (res < 0)
+        return false;
+      written += res;
+    }
+    return true;
+  }
+
+  inline Buffer& local() {
+    if (local_id_ != id_) {
+      std::lock_guard<std::mutex> guard(mutex_);
+      buffers_.emplace_back(new Buffer(capacity_));
+      local_buffer_ = buffers_.back().get();
+      local_id_ = id_;
+    }
+    return *local_buffer_;
+  }
+
+  // copies the staged record into the ring buffer and returns its end, entries are reversed if requested
+  inline uint64_t emit(Buffer& b, uint64_t lsn, bool reverse) {
+    RecordHeader header{lsn, b.epoch, static_cast<uint32_t>(b.record.size()), static_cast<uint32_t>(b.entries.size())};
+    uint64_t size = sizeof(RecordHeader) + b.record.size();
+    if (size > b.capacity) {
+      std::cout << "Redo log error: record of " << size << "B exceeds the log buffer" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+
+    uint64_t tail = b.tail.load(std::memory_order_relaxed);
+    for (Backoff backoff{100}; tail + size - b.flushed.load(std::memory_order_acquire) > b.capacity;) {
+      backoff.pause();
+    }
+
+    b.copy(tail, reinterpret_cast<const char*>(&header), sizeof(RecordHeader));
+    uint64_t pos = tail + sizeof(RecordHeader);
+    for (uint64_t n = 0; n < b.entries.size(); ++n) {
+      auto i = reverse ? b.entries.size() - n - 1 : n;
+      auto end = i + 1 < b.entries.size() ? b.entries[i + 1] : b.record.size();
+      b.copy(pos, b.record.data() + b.entries[i], end - b.entries[i]);
+      pos += end - b.entries[i];
+    }
+    b.tail.store(pos, std::memory_order_release);
+    b.reserved.store(idle);
+    return pos;
+  }
+
+  void writer() {
+    std::vector<Buffer*> buffers;
+    std::vector<uint64_t> tails;
+    bool stop = false;
+    uint64_t persisted = 0;
+    while (!stop) {
+      stop = stop_.load();
+
+      // a record missing in this round belongs at least to the epoch of its in-flight commit or the current one and
+      // has a larger lsn than the one reserved when the round starts or its reserved lsn is in flight
+      uint64_t epoch = epochs_->load();
+      uint64_t flushed = lsn_.load();
+      {
+        std::lock_guard<std::mutex> guard(mutex_);
+        buffers.clear();
+        for (auto& b : buffers_) {
+          buffers.push_back(b.get());
+        }
+      }
+
+      uint64_t group = 0;
+      tails.resize(buffers.size());
+      for (uint64_t i = 0; i < buffers.size(); ++i) {
+        auto b = buffers[i];
+        epoch = std::min(epoch, b->active.load());
+        flushed = std::min(flushed, b->reserved.load() - 1);
+        tails[i] = b->tail.load(std::memory_order_acquire);
+        for (uint64_t pos = b->written; pos < tails[i];) {
+          auto begin = pos % b->capacity;
+          auto size = std::min(tails[i] - pos, b->capacity - begin);
+          if (!writeAll(b->data.get() + begin, size, file_size_)) {
+            std::cout << "Redo log error: cannot write " << file("redo.log") << " - " << strerror(errno) << std::endl;
+            std::exit(EXIT_FAILURE);
+          }
+          file_size_ += size;
+          pos += size;
+        }
+        group += tails[i] - b->written;
+        b->written = tails[i];
+      }
+
+      // after the workers stopped, every record is part of this round
+      uint64_t durable = stop ? epochs_->load() : (epoch > 0 ? epoch - 1 : 0);
+      bool publish = async_ && durable > persisted;
+      if (publish) {
+        LogHeader header{magic, durable};
+        if (!writeAll(reinterpret_cast<const char*>(&header), sizeof(LogHeader), 0)) {
+          std::cout << "Redo log error: cannot write " << file("redo.log") << " - " << strerror(errno) << std::endl;
+          std::exit(EXIT_FAILURE);
+        }
+      }
+
+      if (group == 0 && !publish) {
+        // the records up to the flushed lsn were forced by earlier rounds
+        if (flushed > flushed_lsn_.load(std::memory_order_relaxed))
+          flushed_lsn_.store(flushed, std::memory_order_release);
+        if (!stop)
+          std::this_thread::sleep_for(interval_);
+        continue;
+      }
+
+      auto start = std::chrono::steady_clock::now();
+      if (fdatasync(fd_) != 0) {
+        std::cout << "Redo log error: cannot sync " << file("redo.log") << " - " << strerror(errno) << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      flush_time_ += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start)
+                         .count();
+      for (uint64_t i = 0; i < buffers.size(); ++i) {
+        buffers[i]->flushed.store(tails[i], std::memory_order_release);
+      }
+      if (flushed > flushed_lsn_.load(std::memory_order_relaxed))
+        flushed_lsn_.store(flushed, std::memory_order_release);
+      if (publish) {
+        persisted = durable;
+        durable_.store(durable, std::memory_order_release);
+        auto now = std::chrono::steady_clock::now();
+        for (auto b : buffers) {
+          b->acknowledge(durable, now);
+        }
+      }
+      bytes_ += group;
+      flushes_++;
+      stop = false;  // drain until a round finds nothing left
+    }
+  }
+
+ public:
+  /* Without an epoch counter every lsn is an epoch of its own */
+  RedoLog(const std::string& directory,
+          bool async = false,
+          std::atomic<uint64_t>* epochs = nullptr,
+          uint64_t capacity = default_capacity,
+          uint64_t interval_us = 20)
+      : path_(directory),
+        async_(async),
+        id_(++instances_),
+        capacity_(capacity),
+        interval_(interval_us),
+        fd_(-1),
+        file_size_(page_size),
+        stop_(false),
+        log_aborts_(false),
+        lsn_(0),
+        flushed_lsn_(0),
+        epochs_(epochs != nullptr ? epochs : &lsn_),
+        durable_(0),
+        bytes_(0),
+        flushes_(0),
+        flush_time_(0) {}
+
+  RedoLog(const RedoLog& other) = delete;
+  RedoLog(RedoLog&& other) = delete;
+  RedoLog& operator=(const RedoLog& other) = delete;
+  RedoLog& operator=(RedoLog&& other) = delete;
+
+  ~RedoLog() { close(); }
+
+  inline const std::string& path() const { return path_; }
+
+  inline bool async() const { return async_; }
+
+  inline uint64_t durableEpoch() const { return durable_.load(std::memory_order_acquire); }
+
+  inline uint64_t epoch() const { return epochs_->load(); }
+
+  inline uint64_t lsn() const { return lsn_.load(); }
+
+  /* Every lsn up to the flushed lsn is durable */
+  inline uint64_t flushedLsn() const { return flushed_lsn_.load(std::memory_order_acquire); }
+
+  /* The oldest epoch a record can have which is not yet complete in memory, i.e., still being committed */
+  inline uint64_t activeEpoch() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    uint64_t epoch = epochs_->load();
+    for (auto& b : buffers_) {
+      epoch = std::min(epoch, b->active.load());
+    }
+    return epoch;
+  }
+
+  inline bool logAborts() const { return log_aborts_; }
+
+  inline void logAborts(bool log_aborts) { log_aborts_ = log_aborts; }
+
+  inline uint64_t records() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    uint64_t records = 0;
+    for (auto& b : buffers_) {
+      records += b->records.load(std::memory_order_relaxed);
+    }
+    return records;
+  }
+
+  /* Asynchronous commits acknowledged so far, i.e., whose epoch the writer published as durable */
+  inline uint64_t acknowledged() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    uint64_t acknowledged = 0;
+    for (auto& b : buffers_) {
+      std::lock_guard<std::mutex> pending(b->pending_mutex);
+      acknowledged += b->acknowledged;
+    }
+    return acknowledged;
+  }
+
+  /*
+   * Reserves the lsn and the epoch of a committing transaction. It has to be called after all conflicting
+   * predecessors committed and before any conflicting successor can commit, s.t. every later writer of the same rows
+   * receives a higher lsn and no smaller epoch: the serialization graph testers reserve between their commit check
+   * and marking their node committed, the locking protocols while they hold their locks. The epoch stays in flight,
+   * i.e., holds back the durable and the checkpoint epoch, until the record is emitted. It is published before it is
+   * used and re-read until stable, hence the writer and the checkpointer either see it or read a global epoch that is
+   * not newer than the one of the record. Likewise, a lower bound of the lsn is published before the lsn is drawn and
+   * holds back the flushed lsn until the record is emitted. A reserved lsn always leads to a record, if need be an
+   * empty one, s.t. the lsns in the log have no gaps.
+   */
+  inline uint64_t reserve() {
+    auto& b = local();
+    uint64_t epoch = epochs_->load();
+    b.active.store(epoch);
+    for (uint64_t current = epochs_->load(); current != epoch; current = epochs_->load()) {
+      epoch = current;
+      b.active.store(epoch);
+    }
+    b.epoch = epoch;
+    b.reserved.store(lsn_.load() + 1);
+    return ++lsn_;
+  }
+
+  /* Registers a column s.t. its writes are logged, visitor interface shared with common::Snapshot */
+  template <typename Vector>
+  inline void column(const std::string& name, Vector& vector) {
+    columns_.emplace(&vector, static_cast<uint32_t>(names_.size()));
+    names_.push_back(name);
+  }
+
+  template <typename Vector, typename Func>
+  inline void rebuild(Vector&, uint64_t, Func&&) {}
+
+  template <typename Map>
+  inline void index(const std::string&, Map&) {}
+
+  // names the population the log is based on, recovery refuses a database of another population
+  inline void setPopulation(const std::string& population) { population_ = population; }
+
+  // creates the log directory, the columns and population files and the log file and starts the writer
+  bool open() {
+    for (auto pos = path_.find('/', 1);; pos = path_.find('/', pos + 1)) {
+      if (mkdir(path_.substr(0, pos).c_str(), 0755) != 0 && errno != EEXIST) {
+        std::cout << "Redo log error: cannot create " << path_ << " - " << strerror(errno) << std::endl;
+        return false;
+      }
+      if (pos == std::string::npos)
+        break;
+    }
+
+    std::string columns;
+    for (auto& name : names_) {
+      columns += name + "\n";
+    }
+    fd_ = ::open(file("columns").c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd_ < 0 || !writeAll(columns.data(), columns.size(), 0) || fdatasync(fd_) != 0) {
+      std::cout << "Redo log error: cannot write " << file("columns") << " - " << strerror(errno) << std::endl;
+      return false;
+    }
+    ::close(fd_);
+
+    std::string population = population_ + "\n";
+    fd_ = ::open(file("population").c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd_ < 0 || !writeAll(population.data(), population.size(), 0) || fdatasync(fd_) != 0) {
+      std::cout << "Redo log error: cannot write " << file("population") << " - " << strerror(errno) << std::endl;
+      return false;
+    }
+    ::close(fd_);
+
+    // synchronous commits are acknowledged per record, i.e., every record in the log is durable
+    LogHeader header{magic, async_ ? 0 : idle};
+    char page[page_size] = {};
+    std::memcpy(page, &header, sizeof(LogHeader));
+    fd_ = ::open(file("redo.log").c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd_ < 0 || !writeAll(page, page_size, 0) || fdatasync(fd_) != 0) {
+      std::cout << "Redo log error: cannot write " << file("redo.log") << " - " << strerror(errno) << std::endl;
+      return false;
+    }
+    writer_ = std::thread(&RedoLog::writer, this);
+    return true;
+  }
+
+  // flushes all pending records and stops the writer, must not be called before the workers finished
+  void close() {
+    if (writer_.joinable()) {
+      stop_ = true;
+      writer_.join();
+      auto now = std::chrono::steady_clock::now();
+      for (auto& b : buffers_) {
+        b->acknowledge(durable_, now);
+      }
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  /* Serializes a written value of the current transaction, called by the write set elements */
+  template <typename Value>
+  inline void append(const void* column, uint64_t offset, const Value& value) {
+    static_assert(std::is_trivially_copyable<Value>::value, "only plain values can be logged");
+    auto it = columns_.find(column);
+    if (it == columns_.end())
+      return;
+
+    auto& b = *local_buffer_;
+    EntryHeader entry{it->second, sizeof(Value), offset};
+    auto pos = b.record.size();
+    b.entries.push_back(pos);
+    b.record.resize(pos + sizeof(EntryHeader) + ((sizeof(Value) + 7) & ~7ull));
+    std::memcpy(b.record.data() + pos, &entry, sizeof(EntryHeader));
+    std::memcpy(b.record.data() + pos + sizeof(EntryHeader), &value, sizeof(Value));
+  }
+
+  /*
+   * Logs the write set of a committing transaction and returns as soon as it and all records of smaller lsns are
+   * durable, or right away with asynchronous commits. Without a reserved lsn it has to be called before the
+   * transaction releases its writes, s.t. the lsn order follows the conflict order. Write sets kept newest first are
+   * reversed, i.e., replaying the entries of a record in order always yields the final values.
+   */
+  template <typename WriteSet>
+  void commit(WriteSet& write_set, bool newest_first, uint64_t lsn = 0) {
+    auto& b = local();
+    b.record.clear();
+    b.entries.clear();
+    for (auto t : write_set) {
+      t->redo(*this);
+    }
+    if (b.entries.empty()) {
+      // the reserved lsn of a transaction without logged writes is filled with an empty record
+      if (lsn != 0)
+        emit(b, lsn, false);
+      b.active.store(idle);
+      return;
+    }
+    if (lsn == 0) {
+      lsn = reserve();
+    }
+
+    emit(b, lsn, newest_first);
+    b.records.fetch_add(1, std::memory_order_relaxed);
+    b.active.store(idle);
+
+    if (async_) {
+      std::lock_guard<std::mutex> guard(b.pending_mutex);
+      b.pending.emplace_back(b.epoch, std::chrono::steady_clock::now());
+      return;
+    }
+
+    for (Backoff backoff{100}; flushed_lsn_.load(std::memory_order_acquire) < lsn;) {
+      backoff.pause();
+    }
+  }
+
+  /*
+   * Logs the undo of an aborted transaction as compensation record, only if aborts are logged. The lsn has to be
+   * reserved before the undo is applied, s.t. every later writer of the restored rows receives a higher lsn. The
+   * entries keep the undo order of the write set, i.e., replaying them in order yields the restored values. Aborts
+   * are never acknowledged, hence the worker does not wait for the flush.
+   */
+  template <typename WriteSet>
+  void abort(WriteSet& write_set, uint64_t lsn) {
+    auto& b = local();
+    b.record.clear();
+    b.entries.clear();
+    for (auto t : write_set) {
+      t->undo(*this);
+    }
+    emit(b, lsn, false);
+    b.active.store(idle);
+  }
+
+  void printStatistics() {
+    auto records = this->records();
+    std::cout << "Redo log: " << records << " records, " << bytes_ / 1024.0 / 1024.0 << "MB in " << flushes_
+              << " group commits (" << (flushes_ ? records / static_cast<double>(flushes_) : 0) << " records, "
+              << (flushes_ ? flush_time_ / flushes_ : 0) << "us fdatasync per group commit)" << std::endl;
+    if (async_) {
+      uint64_t acknowledged = 0, delay = 0, max_delay = 0;
+      for (auto& b : buffers_) {
+        acknowledged += b->acknowledged;
+        delay += b->delay;
+        max_delay = std::max(max_delay, b->max_delay);
+      }
+      std::cout << "Redo log: durable epoch " << durable_ << ", durability delay "
+                << (acknowledged ? delay / acknowledged : 0) << "us average, " << max_delay << "us max" << std::endl;
+    }
+  }
+};
+};  // namespace common
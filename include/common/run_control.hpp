@@ -0,0 +1,128 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <stdint.h>
+
+namespace common {
+/*
+ *
+ * The RunControl bounds a benchmark run by time instead of a number of transactions per worker. The workers run
+ * through a warm-up, a measurement and a cool-down phase and check a shared stop flag before every transaction. Only
+ * transactions finished within the measurement window are counted for the throughput, s.t. ramp-up and stragglers
+ * do not skew the comparison of protocols. Without a duration every worker runs its fixed number of transactions.
+ *
+ */
+class RunControl {
+ public:
+  enum class Phase : uint8_t { WarmUp, Measure, CoolDown, Stop };
+
+ private:
+  static bool timed_;
+  static std::atomic<Phase> phase_;
+  static std::chrono::milliseconds warm_up_;
+  static std::chrono::milliseconds measure_;
+  static std::chrono::milliseconds cool_down_;
+  static std::chrono::nanoseconds window_;
+
+ public:
+  /* Parses "measure" or "warm-up,measure[,cool-down]" in seconds, e.g., NFN_DURATION=2,10,1 */
+  static inline bool configure(const char* duration) {
+    timed_ = false;
+    phase_ = Phase::Measure;
+    if (duration == nullptr || duration[0] == '\0')
+      return true;
+
+    double seconds[3] = {0, 0, 0};
+    int n = 0;
+    for (const char* p = duration;; ++p) {
+      char* end;
+      if (n == 3)
+        return false;  // more than three values
+      seconds[n] = std::strtod(p, &end);
+      if (end == p || seconds[n] < 0)
+        return false;
+      n++;
+      p = end;
+      if (*p == '\0')
+        break;
+      if (*p != ',')
+        return false;
+    }
+    if (n == 1) {
+      seconds[1] = seconds[0];
+      seconds[0] = 0;
+    }
+    if (seconds[1] <= 0)
+      return false;
+
+    auto ms = [](double s) { return std::chrono::milliseconds(static_cast<uint64_t>(s * 1000)); };
+    warm_up_ = ms(seconds[0]);
+    measure_ = ms(seconds[1]);
+    cool_down_ = ms(seconds[2]);
+    timed_ = true;
+    phase_ = Phase::WarmUp;
+    return true;
+  }
+
+  static inline bool timed() { return timed_; }
+
+  // whether a worker starts its next transaction i
+  static inline bool proceed(int64_t i, int64_t max_transactions) {
+    return timed_ ? phase_.load(std::memory_order_relaxed) != Phase::Stop : i < max_transactions;
+  }
+
+  static inline Phase phase() { return phase_.load(std::memory_order_relaxed); }
+
+  // whether a finished transaction counts towards the measurement window, always without a duration
+  static inline bool measuring() { return phase_.load(std::memory_order_relaxed) == Phase::Measure; }
+
+  // drives the phases on the calling thread while the workers run and returns once they have to stop
+  static void run() {
+    if (!timed_)
+      return;
+    std::this_thread::sleep_for(warm_up_);
+    auto start = std::chrono::steady_clock::now();
+    phase_ = Phase::Measure;
+    std::this_thread::sleep_for(measure_);
+    phase_ = Phase::CoolDown;
+    window_ = std::chrono::steady_clock::now() - start;
+    std::this_thread::sleep_for(cool_down_);
+    phase_ = Phase::Stop;
+  }
+
+  // the length of the measurement window, only valid for timed runs
+  static inline std::chrono::nanoseconds window() { return window_; }
+
+  static void print() {
+    if (timed_)
+      std::cout << "Time bounded run: " << warm_up_.count() << "ms warm-up, " << measure_.count()
+                << "ms measurement, " << cool_down_.count() << "ms cool-down" << std::endl;
+  }
+};
+};  // namespace common
@@ -0,0 +1,208 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include "common/csv_writer.hpp"
+#include "common/run_control.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+#include <unistd.h>
+
+namespace common {
+/*
+ *
+ * The Sampler reads the counters of all workers at a fixed interval while the benchmark runs and writes the resulting
+ * time series to samples.csv, s.t. a throughput collapse during the run (e.g., by growing epoch limbo lists or
+ * serialization graphs) becomes visible, which the totals of result.csv hide. Every worker owns one cache line of
+ * counters which only it writes (relaxed load and store, no atomic read-modify-write) and the sampler only reads.
+ *
+ */
+class Sampler {
+ public:
+  struct alignas(64) Counters {
+    std::atomic<uint64_t> commits{0};
+    std::atomic<uint64_t> aborts{0};
+    std::atomic<uint64_t> not_found{0};
+    std::atomic<uint64_t> olap_commits{0};
+    std::atomic<uint64_t> wait_manager{0};  // ns
+  };
+
+  // increments a counter of the calling worker, which is its only writer
+  static inline void add(std::atomic<uint64_t>& counter, uint64_t value = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+
+  // the counters of a starting worker, nullptr if no sampler runs
+  static inline Counters* attach() {
+    if (!slots_)
+      return nullptr;
+    auto slot = attached_.fetch_add(1);
+    return slot < workers_ ? &slots_[slot] : nullptr;
+  }
+
+ private:
+  struct Sample {
+    uint64_t time;  // ms since the start
+    uint8_t phase;
+    uint64_t commits;
+    uint64_t aborts;
+    uint64_t not_found;
+    uint64_t olap_commits;
+    uint64_t wait_manager;
+    uint64_t memory;  // resident set in KB
+  };
+
+  static std::unique_ptr<Counters[]> slots_;
+  static uint64_t workers_;
+  static std::atomic<uint64_t> attached_;
+
+  std::chrono::milliseconds interval_;
+  std::chrono::steady_clock::time_point start_;
+  std::vector<Sample> samples_;
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_ = false;
+
+  static uint64_t residentMemory() {
+    uint64_t pages = 0, resident = 0;
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (file == nullptr)
+      return 0;
+    if (fscanf(file, "%lu %lu", &pages, &resident) != 2)
+      resident = 0;
+    fclose(file);
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+  }
+
+  void sample() {
+    Sample s{static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                       std::chrono::steady_clock::now() - start_)
+                                       .count()),
+             static_cast<uint8_t>(RunControl::phase()),
+             0,
+             0,
+             0,
+             0,
+             0,
+             residentMemory()};
+    for (uint64_t w = 0; w < workers_; ++w) {
+      s.commits += slots_[w].commits.load(std::memory_order_relaxed);
+      s.aborts += slots_[w].aborts.load(std::memory_order_relaxed);
+      s.not_found += slots_[w].not_found.load(std::memory_order_relaxed);
+      s.olap_commits += slots_[w].olap_commits.load(std::memory_order_relaxed);
+      s.wait_manager += slots_[w].wait_manager.load(std::memory_order_relaxed);
+    }
+    samples_.push_back(s);
+  }
+
+ public:
+  explicit Sampler(uint64_t interval_ms) : interval_(interval_ms) {}
+
+  Sampler(const Sampler& other) = delete;
+  Sampler(Sampler&& other) = delete;
+  Sampler& operator=(const Sampler& other) = delete;
+  Sampler& operator=(Sampler&& other) = delete;
+
+  ~Sampler() {
+    stop();
+    slots_.reset();
+  }
+
+  /* Provides counters for workers and starts sampling, has to be called before the workers start */
+  void start(uint64_t workers) {
+    workers_ = workers;
+    attached_ = 0;
+    slots_ = std::make_unique<Counters[]>(workers);
+    start_ = std::chrono::steady_clock::now();
+    sample();
+    thread_ = std::thread([&]() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (!cv_.wait_for(lock, interval_, [&]() { return stop_; })) {
+        sample();
+      }
+    });
+  }
+
+  /* Takes a last sample after the workers finished */
+  void stop() {
+    if (!thread_.joinable())
+      return;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+    sample();
+  }
+
+  /*
+   * Appends one line per interval to samples.csv: prefix;time_ms;phase;commits;aborts;not_found;olap_commits;
+   * wait_manager_ms;memory_mb followed by the commits and aborts per second within the interval
+   */
+  void writeCSV(const std::string& prefix) const {
+    CSVWriter csvwriter;
+    csvwriter.setLogName("samples.csv");
+    for (uint64_t i = 1; i < samples_.size(); ++i) {
+      auto& s = samples_[i];
+      auto& p = samples_[i - 1];
+      double seconds = (s.time - p.time) / 1000.0;
+      std::stringstream log;
+      log << prefix << ";" << s.time << ";" << static_cast<uint32_t>(s.phase) << ";" << s.commits - p.commits << ";"
+          << s.aborts - p.aborts << ";" << s.not_found - p.not_found << ";" << s.olap_commits - p.olap_commits << ";"
+          << (s.wait_manager - p.wait_manager) / 1000000 << ";" << s.memory / 1024 << ";"
+          << static_cast<uint64_t>(seconds > 0 ? (s.commits - p.commits) / seconds : 0) << ";"
+          << static_cast<uint64_t>(seconds > 0 ? (s.aborts - p.aborts) / seconds : 0);
+      csvwriter.log(log.str());
+    }
+  }
+
+  void printStatistics() const {
+    if (samples_.size() < 2)
+      return;
+    double min = -1, max = 0;
+    for (uint64_t i = 1; i < samples_.size(); ++i) {
+      double seconds = (samples_[i].time - samples_[i - 1].time) / 1000.0;
+      if (seconds < interval_.count() / 2000.0)
+        continue;  // the last, partial interval
+      double rate = (samples_[i].commits - samples_[i - 1].commits) / seconds;
+      min = (min < 0) ? rate : std::min(min, rate);
+      max = std::max(max, rate);
+    }
+    std::cout << "Samples: " << samples_.size() - 1 << " intervals of " << interval_.count() << "ms";
+    if (min >= 0)
+      std::cout << ", throughput " << static_cast<uint64_t>(min) << " - " << static_cast<uint64_t>(max) << " tx/s";
+    std::cout << ", written to samples.csv" << std::endl;
+  }
+};
+};  // namespace common
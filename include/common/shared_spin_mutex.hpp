@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "common/backoff.hpp"
 #include <atomic>
 #include <cassert>
 #include <stdint.h>
@@ -37,9 +38,12 @@ struct SharedSpinMutex {
   inline void lock() {
     auto xchg = false;
     auto l = lock_.load();
+    Backoff backoff;
     while (!xchg) {
       if (l == 0) {
         xchg = lock_.compare_exchange_weak(l, (1u << 7));
+      } else {
+        backoff.pause();
       }
       l = lock_;
     }
@@ -57,9 +61,12 @@ struct SharedSpinMutex {
   inline void lock_shared() {
     auto xchg = false;
     auto l = lock_.load();
+    Backoff backoff;
     while (!xchg) {
       if (l != (1u << 7) && l < (1u << 7) - 2) {
         xchg = lock_.compare_exchange_weak(l, (l + 1));
+      } else {
+        backoff.pause();
       }
       l = lock_;
     }
@@ -0,0 +1,305 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include "common/parallel_loader.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace common {
+/*
+ *
+ * A Snapshot is a directory holding a populated database as binary images, one file per column and per index. Each
+ * file starts with a header page followed by the raw rows, padded to the reserved capacity, s.t. columns can be mapped
+ * copy-on-write at startup without generating or copying them. Indexes store their (key, value) pairs grouped by hash
+ * slot and are rebuilt in parallel, which reproduces the exact chain order of the snapshotted table. Columns holding
+ * pointers (read-write tables, version chains) and concurrency control state are never stored, they are rebuilt empty.
+ *
+ * The same visitor (Database::snapshotDatabase) is used to write and to restore a database. The manifest is written
+ * last, i.e., a snapshot without manifest is incomplete and will be regenerated.
+ *
+ */
+class Snapshot {
+ public:
+  static constexpr uint64_t page_size = 1 << 12;
+  static constexpr uint64_t magic = 0x4e464e534e415053;  // NFNSNAPS
+
+ private:
+  struct Header {
+    uint64_t magic;
+    uint64_t element_size;
+    uint64_t rows;
+    uint64_t capacity;
+  };
+
+  template <typename Key, typename Value>
+  struct IndexEntry {
+    Key key;
+    Value val;
+    uint64_t slot;
+  };
+
+  std::string path_;
+  bool enabled_;
+  bool writing_;
+  bool populate_;
+  bool hugepages_;
+  bool good_;
+  uint64_t bytes_;
+
+  inline std::string file(const std::string& name) const { return path_ + "/" + name; }
+
+  inline void error(const std::string& name, const char* what) {
+    std::cout << "Snapshot error: " << what << " " << file(name) << " - " << strerror(errno) << std::endl;
+    good_ = false;
+  }
+
+  inline bool writeAll(int fd, const void* data, uint64_t size, uint64_t offset) {
+    for (uint64_t written = 0; written < size;) {
+      auto res = pwrite(fd, reinterpret_cast<const char*>(data) + written, size - written, offset + written);
+      if (res < 0)
+        return false;
+      written += res;
+    }
+    return true;
+  }
+
+  inline int openHeader(const std::string& name, uint64_t element_size, Header& header) {
+    int fd = open(file(name).c_str(), O_RDONLY);
+    if (fd < 0) {
+      error(name, "cannot open");
+      return -1;
+    }
+    if (pread(fd, &header, sizeof(Header), 0) != sizeof(Header) || header.magic != magic ||
+        header.element_size != element_size) {
+      errno = EINVAL;
+      error(name, "incompatible file");
+      close(fd);
+      return -1;
+    }
+    return fd;
+  }
+
+  inline bool writeHeader(int fd, uint64_t element_size, uint64_t rows, uint64_t capacity = 0) {
+    Header header{magic, element_size, rows, capacity};
+    char page[page_size] = {};
+    std::memcpy(page, &header, sizeof(Header));
+    return writeAll(fd, page, page_size, 0);
+  }
+
+  // partitions may only start at a new slot, s.t. one slot is always rebuilt by one thread in the stored order
+  template <typename Entry>
+  static inline uint64_t slotBegin(const Entry* entries, uint64_t rows, uint64_t n) {
+    while (n > 0 && n < rows && entries[n].slot == entries[n - 1].slot) {
+      n++;
+    }
+    return std::min(n, rows);
+  }
+
+ public:
+  Snapshot() : enabled_(false), writing_(false), populate_(true), hugepages_(false), good_(true), bytes_(0) {}
+
+  Snapshot(const std::string& directory, const std::string& name, bool populate = true, bool hugepages = false)
+      : path_(directory + "/" + name),
+        enabled_(true),
+        writing_(false),
+        populate_(populate),
+        hugepages_(hugepages),
+        good_(true),
+        bytes_(0) {}
+
+  Snapshot(const Snapshot& other) = delete;
+  Snapshot(Snapshot&& other) = delete;
+  Snapshot& operator=(const Snapshot& other) = delete;
+  Snapshot& operator=(Snapshot&& other) = delete;
+
+  inline bool enabled() const { return enabled_; }
+
+  inline bool writing() const { return writing_; }
+
+  inline bool good() const { return good_; }
+
+  inline uint64_t bytes() const { return bytes_; }
+
+  inline const std::string& path() const { return path_; }
+
+  inline bool exists() const {
+    struct stat st;
+    return enabled_ && stat((path_ + "/manifest").c_str(), &st) == 0;
+  }
+
+  // switches to write mode and creates the snapshot directory
+  inline bool startWrite() {
+    writing_ = true;
+    bytes_ = 0;
+    for (auto pos = path_.find('/', 1); good_; pos = path_.find('/', pos + 1)) {
+      if (mkdir(path_.substr(0, pos).c_str(), 0755) != 0 && errno != EEXIST) {
+        error("", "cannot create");
+      }
+      if (pos == std::string::npos)
+        break;
+    }
+    unlink((path_ + "/manifest").c_str());
+    return good_;
+  }
+
+  // writes the manifest which marks the snapshot as complete
+  inline bool finish(uint64_t rows) {
+    if (!good_)
+      return false;
+    int fd = open(file("manifest").c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd < 0 || !writeHeader(fd, 0, rows) || fdatasync(fd) != 0) {
+      error("manifest", "cannot write");
+    }
+    if (fd >= 0)
+      close(fd);
+    return good_;
+  }
+
+  // the number of rows stored in a complete snapshot
+  inline uint64_t rows() {
+    Header header;
+    int fd = openHeader("manifest", 0, header);
+    if (fd < 0)
+      return 0;
+    close(fd);
+    return header.rows;
+  }
+
+  template <typename Vector>
+  inline void column(const std::string& name, Vector& vector) {
+    static_assert(std::is_trivially_copyable<typename Vector::value_type>::value &&
+                      !std::is_pointer<typename Vector::value_type>::value,
+                  "only plain values can be stored in a snapshot");
+    if (!good_)
+      return;
+
+    if (writing_) {
+      int fd = open(file(name + ".col").c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+      if (fd < 0 || !writeHeader(fd, Vector::element_size, vector.size(), vector.max_size()) ||
+          !vector.write(fd, page_size)) {
+        error(name + ".col", "cannot write");
+      }
+      if (fd >= 0)
+        close(fd);
+    } else {
+      Header header;
+      int fd = openHeader(name + ".col", Vector::element_size, header);
+      if (fd < 0)
+        return;
+      if (!vector.map(fd, page_size, header.rows, header.capacity, populate_, hugepages_)) {
+        error(name + ".col", "cannot map");
+      }
+      close(fd);
+    }
+    bytes_ += vector.size() * Vector::element_size;
+  }
+
+  // restores a column which is not part of the snapshot, e.g., read-write tables or lsns, by func() for each row
+  template <typename Vector, typename Func>
+  inline void rebuild(Vector& vector, uint64_t rows, Func&& func) {
+    if (writing_ || !good_)
+      return;
+
+    ParallelLoader loader;
+    loader.run(0, ParallelLoader::partitions(rows), [&](uint64_t partition, std::mt19937&) {
+      auto end = ParallelLoader::partitionEnd(partition, rows);
+      for (uint64_t n = ParallelLoader::partitionBegin(partition); n < end; ++n) {
+        vector.store(n, func());
+      }
+      return 0;
+    });
+  }
+
+  template <template <typename, typename, typename, typename, bool> class Map,
+            typename Value,
+            typename Key,
+            typename Bucket,
+            typename Allocator,
+            bool Size>
+  inline void index(const std::string& name, Map<Value, Key, Bucket, Allocator, Size>& map) {
+    using Entry = IndexEntry<Key, Value>;
+    static_assert(std::is_trivially_copyable<Entry>::value, "only plain keys and values can be stored in a snapshot");
+    if (!good_)
+      return;
+
+    if (writing_) {
+      // chains are stored reversed, since inserting prepends to a chain
+      std::vector<Entry> entries;
+      uint64_t chain = 0;
+      map.unsafe_for_each([&](uint64_t slot, const Bucket& bucket) {
+        if (entries.empty() || entries.back().slot != slot) {
+          std::reverse(entries.begin() + chain, entries.end());
+          chain = entries.size();
+        }
+        entries.push_back(Entry{bucket.key, bucket.val.load(), slot});
+      });
+      std::reverse(entries.begin() + chain, entries.end());
+
+      int fd = open(file(name + ".idx").c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+      if (fd < 0 || !writeHeader(fd, sizeof(Entry), entries.size()) ||
+          !writeAll(fd, entries.data(), entries.size() * sizeof(Entry), page_size)) {
+        error(name + ".idx", "cannot write");
+      }
+      if (fd >= 0)
+        close(fd);
+      bytes_ += entries.size() * sizeof(Entry);
+    } else {
+      Header header;
+      int fd = openHeader(name + ".idx", sizeof(Entry), header);
+      if (fd < 0)
+        return;
+      uint64_t rows = header.rows;
+      uint64_t size = page_size + rows * sizeof(Entry);
+      void* ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+      close(fd);
+      if (ptr == MAP_FAILED) {
+        error(name + ".idx", "cannot map");
+        return;
+      }
+
+      const Entry* entries = reinterpret_cast<const Entry*>(reinterpret_cast<const char*>(ptr) + page_size);
+      ParallelLoader loader;
+      loader.run(0, ParallelLoader::partitions(rows), [&](uint64_t partition, std::mt19937&) {
+        auto begin = slotBegin(entries, rows, ParallelLoader::partitionBegin(partition));
+        auto end = slotBegin(entries, rows, ParallelLoader::partitionEnd(partition, rows));
+        for (uint64_t n = begin; n < end; ++n) {
+          map.insert(entries[n].key, Value{entries[n].val});
+        }
+        return 0;
+      });
+      munmap(ptr, size);
+      bytes_ += rows * sizeof(Entry);
+    }
+  }
+};
+};  // namespace common
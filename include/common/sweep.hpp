@@ -0,0 +1,134 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include "common/csv_writer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iterator>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
+namespace common {
+/*
+ *
+ * The Sweep collects the results of repeated runs of the same configuration (benchmark, protocol, size, workers,
+ * scanners and the YCSB parameters) and summarizes them into one line per configuration: the number of runs, the
+ * median throughput with the 95% confidence interval of its mean (Student's t), the median abort rate and the median
+ * p99 latency.
+ *
+ */
+class Sweep {
+ public:
+  struct Result {
+    double throughput;
+    double abort_rate;
+    double p99;
+  };
+
+ private:
+  static bool enabled_;
+  static std::vector<std::pair<std::string, std::vector<Result>>> results_;  // in the order of the first run
+
+  template <typename Func>
+  static inline double median(const std::vector<Result>& results, Func&& value) {
+    std::vector<double> values;
+    for (auto& r : results) {
+      values.push_back(value(r));
+    }
+    std::sort(values.begin(), values.end());
+    auto n = values.size();
+    return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+  }
+
+  // the half width of the 95% confidence interval of the mean throughput
+  static inline double confidence(const std::vector<Result>& results) {
+    static constexpr double t[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                   2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                   2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    auto n = results.size();
+    if (n < 2)
+      return 0;
+    double mean = 0, variance = 0;
+    for (auto& r : results) {
+      mean += r.throughput / n;
+    }
+    for (auto& r : results) {
+      variance += (r.throughput - mean) * (r.throughput - mean) / (n - 1);
+    }
+    double quantile = n - 1 <= std::size(t) ? t[n - 2] : 1.96;
+    return quantile * std::sqrt(variance / n);
+  }
+
+  static inline double mean(const std::vector<Result>& results) {
+    double mean = 0;
+    for (auto& r : results) {
+      mean += r.throughput / results.size();
+    }
+    return mean;
+  }
+
+ public:
+  static inline void enable() { enabled_ = true; }
+
+  static inline bool enabled() { return enabled_; }
+
+  static void record(const std::string& configuration, const Result& result) {
+    auto it = std::find_if(results_.begin(), results_.end(), [&](auto& r) { return r.first == configuration; });
+    if (it == results_.end()) {
+      results_.emplace_back(configuration, std::vector<Result>{});
+      it = results_.end() - 1;
+    }
+    it->second.push_back(result);
+  }
+
+  // configuration;runs;throughput_median;ci_low;ci_high;abort_rate_median;p99_us_median
+  static void writeCSV(const std::string& file) {
+    CSVWriter csvwriter;
+    csvwriter.setLogName(file);
+    for (auto& [configuration, results] : results_) {
+      double ci = confidence(results);
+      std::stringstream log;
+      log << configuration << ";" << results.size() << ";" << std::fixed << std::setprecision(0)
+          << median(results, [](auto& r) { return r.throughput; }) << ";" << mean(results) - ci << ";"
+          << mean(results) + ci << ";" << std::setprecision(6)
+          << median(results, [](auto& r) { return r.abort_rate; }) << ";" << std::setprecision(1)
+          << median(results, [](auto& r) { return r.p99; });
+      csvwriter.log(log.str());
+    }
+  }
+
+  static void printStatistics() {
+    for (auto& [configuration, results] : results_) {
+      std::cout << "Sweep " << configuration << ": " << results.size() << " runs, median "
+                << static_cast<uint64_t>(median(results, [](auto& r) { return r.throughput; })) << " tx/s, +-"
+                << static_cast<uint64_t>(confidence(results)) << " (95%), abort rate "
+                << median(results, [](auto& r) { return r.abort_rate; }) << std::endl;
+    }
+  }
+};
+};  // namespace common
@@ -20,8 +20,10 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#pragma once
 #include <iostream>
 #include <thread>
+#include <vector>
 #include <pthread.h>
 #include <stdint.h>
 
@@ -29,10 +31,13 @@ namespace common {
 class ThreadHandler {
  private:
   std::thread this_thread_;
-  uint16_t core_id_;
+  std::vector<uint32_t> cpus_;
 
  public:
-  ThreadHandler(uint16_t pinned_core) : this_thread_(), core_id_(pinned_core) {}
+  ThreadHandler(uint16_t pinned_core) : this_thread_(), cpus_{pinned_core} {}
+
+  // runs on any of the cpus, on any CPU if empty
+  ThreadHandler(std::vector<uint32_t> cpus) : this_thread_(), cpus_(std::move(cpus)) {}
 
   ThreadHandler(const ThreadHandler& other) = delete;
   ThreadHandler(ThreadHandler&& other) = delete;
@@ -42,12 +47,15 @@ class ThreadHandler {
   template <typename Function, typename... Args>
   inline void run(Function&& f, Args&&... args) {
     this_thread_ = std::thread(std::forward<Function>(f), std::forward<Args>(args)...);
+    if (cpus_.empty())
+      return;
 
     cpu_set_t cpuset;
     pthread_t pthread = this_thread_.native_handle();
 
     CPU_ZERO(&cpuset);
-    CPU_SET(core_id_, &cpuset);
+    for (auto cpu : cpus_)
+      CPU_SET(cpu, &cpuset);
 
     int s = pthread_setaffinity_np(pthread, sizeof(cpu_set_t), &cpuset);
     if (s != 0) {
@@ -0,0 +1,85 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include <chrono>
+#include <stdint.h>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+// measures with steady_clock instead of the time stamp counter, e.g., on machines without an invariant TSC
+//#define NFN_STEADY_TIMER 1
+// disables the per phase timing of the DetailCollector (transaction, commit, wait manager and latency) for peak
+// throughput runs, only the worker time, commits and aborts are collected
+//#define NFN_NO_PHASE_TIMING 1
+
+#if !defined(__x86_64__) && !defined(NFN_STEADY_TIMER)
+#define NFN_STEADY_TIMER 1
+#endif
+
+namespace common {
+/*
+ *
+ * The Timer reads the time stamp counter, which costs a few cycles compared to a clock_gettime call, and converts
+ * tick differences to nanoseconds by a factor calibrated once against steady_clock at startup. This assumes an
+ * invariant TSC (constant_tsc and nonstop_tsc), which holds for all recent x86 server CPUs.
+ *
+ */
+class Timer {
+  static double ns_per_tick_;
+
+ public:
+  static inline uint64_t now() {
+#ifdef NFN_STEADY_TIMER
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#else
+    return __rdtsc();
+#endif
+  }
+
+  static inline uint64_t nanoseconds(uint64_t ticks) { return static_cast<uint64_t>(ticks * ns_per_tick_); }
+
+  // nanoseconds passed since the ticks start were taken by now()
+  static inline uint64_t since(uint64_t start) { return nanoseconds(now() - start); }
+
+  static inline double nsPerTick() { return ns_per_tick_; }
+
+  // measures the ticks of now() during a few milliseconds of steady_clock
+  static double calibrate() {
+#ifdef NFN_STEADY_TIMER
+    return 1.0;
+#else
+    auto clock_start = std::chrono::steady_clock::now();
+    auto tick_start = now();
+    std::chrono::steady_clock::time_point clock_end;
+    do {
+      clock_end = std::chrono::steady_clock::now();
+    } while (clock_end - clock_start < std::chrono::milliseconds(10));
+    auto ticks = now() - tick_start;
+    return std::chrono::duration<double, std::nano>(clock_end - clock_start).count() / ticks;
+#endif
+  }
+};
+};  // namespace common
@@ -0,0 +1,179 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include "common/parallel_loader.hpp"
+#include <cstdio>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
+namespace common {
+/*
+ *
+ * A Trace holds the pre-generated transactions of every worker as a stream of plain operations (Op). Replaying a
+ * trace takes the generators out of the measured loop and issues the identical transactions in every run: the streams
+ * only depend on the seed (see ParallelLoader), and a trace file written by one run is read by the later ones. Workers
+ * running past the end of their stream, e.g., in timed runs, start over at its beginning.
+ *
+ */
+template <typename Op>
+class Trace {
+  static_assert(std::is_trivially_copyable<Op>::value, "only plain operations can be stored in a trace");
+
+ public:
+  static constexpr uint64_t magic = 0x4e464e5452414345;  // NFNTRACE
+  // the stream of the trace generators, the loaders use the streams of the tables
+  static constexpr uint64_t stream = 0x74726163;
+  // transactions per worker if the run has no transaction count, i.e., is timed
+  static constexpr uint64_t default_transactions = 1 << 16;
+
+ private:
+  struct Header {
+    uint64_t magic;
+    uint64_t element_size;
+    uint64_t workers;
+    uint64_t transactions;
+  };
+
+  // begin holds the offset of every transaction into ops and the end of the last one
+  struct Stream {
+    std::vector<uint64_t> begin;
+    std::vector<Op> ops;
+  };
+
+  std::vector<Stream> streams_;
+  uint64_t transactions_ = 0;
+
+ public:
+  class Cursor {
+    const Stream* stream_;
+    uint64_t next_;
+    uint64_t wraps_;
+
+   public:
+    Cursor(const Stream* stream) : stream_(stream), next_(0), wraps_(0) {}
+
+    // the operations of the next transaction as [first, second)
+    inline std::pair<const Op*, const Op*> next() {
+      if (next_ + 1 >= stream_->begin.size()) {
+        next_ = 0;
+        wraps_++;
+      }
+      const Op* ops = stream_->ops.data();
+      auto transaction = std::make_pair(ops + stream_->begin[next_], ops + stream_->begin[next_ + 1]);
+      next_++;
+      return transaction;
+    }
+
+    inline uint64_t wraps() const { return wraps_; }
+  };
+
+  inline bool empty() const { return streams_.empty(); }
+
+  inline uint64_t workers() const { return streams_.size(); }
+
+  inline uint64_t transactions() const { return transactions_; }
+
+  inline uint64_t operations() const {
+    uint64_t ops = 0;
+    for (auto& stream : streams_)
+      ops += stream.ops.size();
+    return ops;
+  }
+
+  // the cursor of an empty trace must not be used
+  inline Cursor cursor(uint64_t worker) const {
+    return Cursor{streams_.empty() ? nullptr : &streams_[worker % streams_.size()]};
+  }
+
+  inline void clear() {
+    streams_.clear();
+    transactions_ = 0;
+  }
+
+  // func(gen, ops) appends the operations of one transaction to ops, the workers are generated in parallel
+  template <typename Func>
+  void generate(uint64_t workers, uint64_t transactions, uint64_t seed, Func&& func) {
+    streams_.clear();
+    streams_.resize(workers);
+    transactions_ = transactions;
+    ParallelLoader loader{seed};
+    loader.run(stream, workers, [&](uint64_t worker, std::mt19937& gen) {
+      auto& s = streams_[worker];
+      s.begin.reserve(transactions + 1);
+      s.begin.push_back(0);
+      for (uint64_t t = 0; t < transactions; ++t) {
+        func(gen, s.ops);
+        s.begin.push_back(s.ops.size());
+      }
+      return 0;
+    });
+  }
+
+  bool write(const std::string& path) const {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+      return false;
+    Header header{magic, sizeof(Op), streams_.size(), transactions_};
+    bool good = std::fwrite(&header, sizeof(Header), 1, file) == 1;
+    for (auto& s : streams_) {
+      uint64_t ops = s.ops.size();
+      good = good && std::fwrite(&ops, sizeof(uint64_t), 1, file) == 1 &&
+             std::fwrite(s.begin.data(), sizeof(uint64_t), s.begin.size(), file) == s.begin.size() &&
+             std::fwrite(s.ops.data(), sizeof(Op), ops, file) == ops;
+    }
+    return std::fclose(file) == 0 && good;
+  }
+
+  // reads a trace written for workers workers, false if it cannot be read or does not match
+  bool read(const std::string& path, uint64_t workers) {
+    clear();
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr)
+      return false;
+    Header header;
+    bool good = std::fread(&header, sizeof(Header), 1, file) == 1 && header.magic == magic &&
+                header.element_size == sizeof(Op) && header.workers == workers;
+    if (good) {
+      streams_.resize(workers);
+      transactions_ = header.transactions;
+    }
+    for (uint64_t w = 0; good && w < workers; ++w) {
+      auto& s = streams_[w];
+      uint64_t ops = 0;
+      good = std::fread(&ops, sizeof(uint64_t), 1, file) == 1;
+      s.begin.resize(transactions_ + 1);
+      s.ops.resize(good ? ops : 0);
+      good = good && std::fread(s.begin.data(), sizeof(uint64_t), s.begin.size(), file) == s.begin.size() &&
+             std::fread(s.ops.data(), sizeof(Op), ops, file) == ops && s.begin.back() == ops;
+    }
+    std::fclose(file);
+    if (!good)
+      clear();
+    return good;
+  }
+};
+};  // namespace common
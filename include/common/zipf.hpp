@@ -0,0 +1,121 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+#include "common/random.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <stdint.h>
+
+namespace common {
+/*
+ *
+ * Zipf draws keys 1 to items with a zipfian distribution of skew theta by the method of Gray et al. ("Quickly
+ * generating billion-record synthetic databases"), as YCSB does. All constants, including the zeta of the population,
+ * are computed once by configure, a draw costs a single pow. Scrambled draws hash the rank onto the keys (FNV-1a, as
+ * the scrambled zipfian of YCSB), s.t. the hot keys are spread over the table instead of being neighbours.
+ *
+ */
+class Zipf {
+  uint64_t items_ = 0;
+  double theta_ = 0;
+  double alpha_ = 0;
+  double zetan_ = 0;
+  double eta_ = 0;
+  double second_ = 0;  // the first two ranks are drawn without pow
+  bool scrambled_ = false;
+
+ public:
+  // zeta sums the first exact_terms terms, the tail is approximated
+  static constexpr uint64_t exact_terms = 1 << 20;
+
+  // the generalized harmonic number of n and theta; the tail beyond exact_terms is given by the Euler-Maclaurin
+  // formula, its error is far below double precision, and the results are cached for later databases
+  static inline double zeta(uint64_t n, double theta) {
+    static std::mutex mutex;
+    static std::map<std::pair<uint64_t, double>, double> cache;
+    std::lock_guard<std::mutex> lock{mutex};
+    auto cached = cache.find({n, theta});
+    if (cached != cache.end())
+      return cached->second;
+
+    uint64_t m = std::min(n, exact_terms);
+    double sum = 0;
+    for (uint64_t i = 1; i <= m; i++)
+      sum += std::pow(1.0 / i, theta);
+    if (n > m) {
+      double a = m, b = n;
+      double integral =
+          theta == 1 ? std::log(b / a) : (std::pow(b, 1 - theta) - std::pow(a, 1 - theta)) / (1 - theta);
+      sum += integral + (std::pow(b, -theta) - std::pow(a, -theta)) / 2 -
+             theta * (std::pow(b, -theta - 1) - std::pow(a, -theta - 1)) / 12;
+    }
+    cache[{n, theta}] = sum;
+    return sum;
+  }
+
+  inline void configure(uint64_t items, double theta, bool scrambled = false) {
+    scrambled_ = scrambled;
+    if (items == items_ && theta == theta_ && zetan_ > 0)
+      return;
+    items_ = items;
+    theta_ = theta;
+    zetan_ = zeta(items, theta);
+    alpha_ = 1 / (1 - theta);
+    eta_ = (1 - std::pow(2.0 / (items - 1), 1 - theta)) / (1 - zeta(2, theta) / zetan_);
+    second_ = 1 + std::pow(0.5, theta);
+  }
+
+  inline uint64_t items() const { return items_; }
+
+  inline bool scrambled() const { return scrambled_; }
+
+  // the rank of a draw, 1 is the most popular one
+  template <typename Generator>
+  inline uint64_t rank(Generator& gen) const {
+    double u = canonical(gen);
+    double uz = u * zetan_;
+    if (uz < 1)
+      return 1;
+    if (uz < second_)
+      return 2;
+    return 1 + static_cast<uint64_t>((items_ - 1) * std::pow(eta_ * u - eta_ + 1, alpha_));
+  }
+
+  inline uint64_t scramble(uint64_t rank) const {
+    uint64_t hash = 0xcbf29ce484222325;
+    for (int i = 0; i < 8; ++i) {
+      hash ^= (rank >> (8 * i)) & 0xff;
+      hash *= 0x100000001b3;
+    }
+    return 1 + hash % items_;
+  }
+
+  template <typename Generator>
+  inline uint64_t operator()(Generator& gen) const {
+    return scrambled_ ? scramble(rank(gen)) : rank(gen);
+  }
+};
+};  // namespace common
@@ -21,18 +21,39 @@
 //
 
 #pragma once
+#include "common/abort_reason.hpp"
+#include "common/arrivals.hpp"
+#include "common/checkpointer.hpp"
 #include "common/chunk_allocator.hpp"
 #include "common/csv_writer.hpp"
+#include "common/details_collector.hpp"
+#include "common/perf_counters.hpp"
+#include "common/placement.hpp"
+#include "common/recovery.hpp"
+#include "common/redo_log.hpp"
+#include "common/run_control.hpp"
+#include "common/sampler.hpp"
+#include "common/snapshot.hpp"
+#include "common/sweep.hpp"
 #include "common/thread_handler.hpp"
-#include "perfevent/PerfEvent.hpp"
+#include "common/trace.hpp"
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <functional>
 #include <future>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <string>
 #include <thread>
+#include <type_traits>
+#include <vector>
+#include <sys/stat.h>
 #include <tbb/tbb.h>
 
-//#define perf 1
+// set by bin/db recover, runBenchmark then recovers the database from the log in NFN_LOG instead of running it
+extern bool recoveryMode;
 
 int parseLine(char* line) {
   int i = strlen(line);
@@ -59,38 +80,326 @@ int getValue() {  // Note: this value is in KB!
   return result;
 }
 
-template <typename Database, typename Func>
-void runBenchmark(Database* db,
-                  Func client,
-                  const char* benchmark,
-                  const char* algorithm,
+// names the population of a benchmark and size, i.e., its snapshot and the base state of its redo log
+inline std::string populationName(const std::string& benchmark, uint64_t database_size) {
+  std::stringstream name;
+  name << benchmark.substr(0, benchmark.find(';')) << "_" << database_size << "_" << std::hex
+       << common::ParallelLoader::default_seed;
+  return name.str();
+}
+
+/*
+ * Populates the database or, if NFN_SNAPSHOT names a directory, restores it from a snapshot written by an earlier run
+ * with the same benchmark and size. NFN_SNAPSHOT_MAP selects how snapshot columns are mapped: populate (default, all
+ * pages are faulted in by MAP_POPULATE), lazy or hugepages (columns are read into anonymous huge pages).
+ */
+template <typename Database>
+uint64_t loadDatabase(Database* db, const char* benchmark, uint64_t database_size) {
+  auto start = std::chrono::steady_clock::now();
+  auto elapsed = [&]() {
+    auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    return std::max<uint64_t>(diff.count(), 1);
+  };
+
+  const char* directory = std::getenv("NFN_SNAPSHOT");
+  if (directory == nullptr || directory[0] == '\0') {
+    uint64_t rows = db->populateDatabase(database_size);
+    auto ms = elapsed();
+    std::cout << "Database population: " << rows << " rows in " << ms << "ms (" << rows * 1000 / ms << " rows/s)"
+              << std::endl;
+    return rows;
+  }
+
+  const char* map = std::getenv("NFN_SNAPSHOT_MAP");
+  std::string mode{map != nullptr ? map : "populate"};
+  common::Snapshot snapshot{directory, populationName(benchmark, database_size), mode != "lazy", mode == "hugepages"};
+
+  if (snapshot.exists()) {
+    uint64_t rows = db->restoreDatabase(database_size, snapshot);
+    if (!snapshot.good()) {
+      std::cout << "Error: snapshot " << snapshot.path() << " is corrupt, delete it to regenerate it" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    std::cout << "Database restored: " << rows << " rows (" << snapshot.bytes() / 1024.0 / 1024.0 << "MB) in "
+              << elapsed() << "ms from " << snapshot.path() << std::endl;
+    return rows;
+  }
+
+  uint64_t rows = db->populateDatabase(database_size);
+  auto ms = elapsed();
+  std::cout << "Database population: " << rows << " rows in " << ms << "ms (" << rows * 1000 / ms << " rows/s)"
+            << std::endl;
+  start = std::chrono::steady_clock::now();
+  if (snapshot.startWrite()) {
+    db->snapshotDatabase(snapshot);
+    if (snapshot.finish(rows)) {
+      std::cout << "Snapshot written: " << snapshot.bytes() / 1024.0 / 1024.0 << "MB in " << elapsed() << "ms to "
+                << snapshot.path() << std::endl;
+    }
+  }
+  return rows;
+}
+
+/*
+ * Opens the redo log in the directory named by NFN_LOG, s.t. commits are acknowledged after their write set is durable.
+ * NFN_LOG_COMMIT selects sync (default, workers wait for the group commit) or epoch (workers continue and commits are
+ * acknowledged once their epoch is durable). Only the single version coordinators log their write sets, i.e., the
+ * multi version benchmarks run without log. The log records the population it was written against, since its records
+ * address rows by their offset.
+ */
+template <typename Database>
+auto openRedoLog(Database* db, const char* directory, const std::string& population, int)
+    -> decltype(db->tc.setRedoLog(nullptr), std::unique_ptr<common::RedoLog>()) {
+  const char* commit = std::getenv("NFN_LOG_COMMIT");
+  bool async = commit != nullptr && std::string{commit} == "epoch";
+  auto redo_log = std::make_unique<common::RedoLog>(directory, async, &db->emp.global_counter_);
+  db->snapshotDatabase(*redo_log);
+  redo_log->setPopulation(population);
+  if (!redo_log->open()) {
+    std::exit(EXIT_FAILURE);
+  }
+  db->tc.setRedoLog(redo_log.get());
+  std::cout << "Redo log: " << (async ? "epoch" : "group") << " commit to " << redo_log->path() << std::endl;
+  return redo_log;
+}
+
+template <typename Database>
+std::unique_ptr<common::RedoLog> openRedoLog(Database*, const char*, const std::string&, long) {
+  std::cout << "Redo log: not supported by the multi version benchmarks, running without log" << std::endl;
+  return nullptr;
+}
+
+/*
+ * Starts fuzzy checkpoints of the logged columns every NFN_CHECKPOINT ms into the log directory, throttled to the
+ * NFN_CHECKPOINT_SHARE (default 0.25) of the time. Aborts are logged from now on, since checkpoints may hold their
+ * dirty values.
+ */
+template <typename Database>
+auto startCheckpointer(Database* db, common::RedoLog* redo_log, int)
+    -> decltype(db->tc.setRedoLog(nullptr), std::unique_ptr<common::Checkpointer>()) {
+  const char* interval = std::getenv("NFN_CHECKPOINT");
+  if (interval == nullptr || interval[0] == '\0' || redo_log == nullptr)
+    return nullptr;
+  const char* share = std::getenv("NFN_CHECKPOINT_SHARE");
+  auto checkpointer = std::make_unique<common::Checkpointer>(
+      redo_log, std::strtoull(interval, nullptr, 10), share != nullptr ? std::atof(share) : 0.25,
+      [db](common::Checkpointer& checkpoint) { db->snapshotDatabase(checkpoint); });
+  redo_log->logAborts(true);
+  checkpointer->start();
+  std::cout << "Checkpoints: every " << interval << "ms at share " << checkpointer->share() << " to "
+            << redo_log->path() << std::endl;
+  return checkpointer;
+}
+
+template <typename Database>
+std::unique_ptr<common::Checkpointer> startCheckpointer(Database*, common::RedoLog*, long) {
+  return nullptr;
+}
+
+/*
+ * Recovers the populated database from the latest checkpoint and the redo log in directory on threads threads and
+ * reports the recovery throughput. The log has to be written against the same population, i.e., benchmark, size and
+ * load seed, whose layout does not depend on the loader threads.
+ */
+template <typename Database>
+auto recoverDatabase(Database* db, const char* directory, const std::string& population, uint64_t threads, int)
+    -> decltype(db->tc.setRedoLog(nullptr), void()) {
+  if (directory == nullptr || directory[0] == '\0') {
+    std::cout << "Recovery: NFN_LOG has to name the log directory" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  auto start = std::chrono::steady_clock::now();
+  common::Recovery recovery{directory, static_cast<uint32_t>(threads)};
+  recovery.setPopulation(population);
+  if (!recovery.open()) {
+    std::exit(EXIT_FAILURE);
+  }
+  db->snapshotDatabase(recovery);
+  if (!recovery.run()) {
+    std::exit(EXIT_FAILURE);
+  }
+  recovery.printStatistics();
+  auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  std::cout << "Time needed (recovery): " << diff.count() << "ms" << std::endl;
+}
+
+template <typename Database>
+void recoverDatabase(Database*, const char*, const std::string&, uint64_t, long) {
+  std::cout << "Recovery: not supported by the multi version benchmarks" << std::endl;
+}
+
+/*
+ * Prepares the transaction traces of a run if NFN_TRACE names a directory: the workers replay a trace file of the same
+ * configuration written by an earlier run or, if there is none, traces generated now, which are written for later
+ * runs. A trace holds transaction_iterations (timed runs: Trace::default_transactions) transactions per worker,
+ * generated from NFN_TRACE_SEED (default: the load seed).
+ */
+template <typename Database>
+auto prepareTrace(Database* db,
+                  const std::string& benchmark,
                   uint64_t database_size,
+                  uint64_t workers,
                   uint64_t transaction_iterations,
-                  uint64_t cores,
-                  uint64_t scanners = 0,
-                  Func scan = nullptr) {
-  db->populateDatabase(database_size);
-  std::cout << "Memory Needed for Database population: " << getValue() / 1024.0 << "MB" << std::endl;
+                  int) -> decltype(db->generateTrace(0, 0, 0), void()) {
+  using Trace = std::remove_reference_t<decltype(db->trace())>;
+  Trace& trace = db->trace();
+  trace.clear();
+  const char* directory = std::getenv("NFN_TRACE");
+  if (directory == nullptr || directory[0] == '\0')
+    return;
+
+  const char* seed_env = std::getenv("NFN_TRACE_SEED");
+  uint64_t seed = seed_env != nullptr ? std::strtoull(seed_env, nullptr, 0) : common::ParallelLoader::default_seed;
+  uint64_t transactions = transaction_iterations > 0 ? transaction_iterations : Trace::default_transactions;
+  std::string name{benchmark};
+  std::replace(name.begin(), name.end(), ';', '_');
+  std::stringstream path;
+  path << directory << "/" << name << "_" << database_size << "_" << workers << "_" << transactions << "_" << std::hex
+       << seed << ".trace";
+
+  auto start = std::chrono::steady_clock::now();
+  struct stat st;
+  if (stat(path.str().c_str(), &st) == 0) {
+    if (!trace.read(path.str(), workers) || trace.transactions() != transactions) {
+      std::cout << "Error: trace " << path.str() << " is corrupt, delete it to regenerate it" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    std::cout << "Trace: replaying " << path.str();
+  } else {
+    db->generateTrace(workers, transactions, seed);
+    mkdir(directory, 0755);
+    if (!trace.write(path.str())) {
+      std::cout << "Trace: cannot write " << path.str() << " - " << strerror(errno) << std::endl;
+    }
+    std::cout << "Trace: generated " << path.str();
+  }
+  auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  std::cout << ", " << trace.operations() << " operations in " << transactions << " transactions per worker ("
+            << diff.count() << "ms)" << std::endl;
+}
+
+template <typename Database>
+void prepareTrace(Database*, const std::string&, uint64_t, uint64_t, uint64_t, long) {
+  const char* directory = std::getenv("NFN_TRACE");
+  if (directory != nullptr && directory[0] != '\0')
+    std::cout << "Trace: not supported by this benchmark, running with generators" << std::endl;
+}
 
-#ifdef perf
-  PerfEvent p;
-  p.startCounters();
-#endif
+// empties the executor queues for the workers of a run, only benchmarks with task clients have an executor
+template <typename Database>
+auto prepareExecutor(Database* db, uint64_t workers, int) -> decltype(db->executor(), void()) {
+  db->executor().start(workers);
+}
+
+template <typename Database>
+void prepareExecutor(Database*, uint64_t, long) {}
+
+template <typename Database>
+auto printExecutor(Database* db, int) -> decltype(db->executor(), void()) {
+  db->executor().printStatistics();
+}
+
+template <typename Database>
+void printExecutor(Database*, long) {}
+
+/*
+ * A Run is one measurement on the populated database with cores workers, of which scanners run the scan client.
+ * benchmark is the name written to result.csv, prepare (if set) adapts the database before the workers start. With a
+ * rate (transactions per second of all OLTP workers) the run is open-loop, see common::Arrivals. oversubscription
+ * workers share one CPU, i.e., the workers run on cores / oversubscription CPUs.
+ */
+struct Run {
+  std::string benchmark;
+  uint64_t cores;
+  uint64_t scanners;
+  double rate;
+  uint64_t oversubscription;
+  std::function<void()> prepare;
+};
+
+// the columns of result.csv, the five ycsb values are zero for the other benchmarks
+constexpr const char* result_columns =
+    "benchmark;protocol;size;transactions;workers;scanners;time_ms;total_time_ms;commits;not_found;aborts;"
+    "olap_commits;olap_not_found;olap_aborts;tx_ms;commit_ms;wait_manager_ms;latency_ms;olap_tx_ms;olap_commit_ms;"
+    "olap_wait_manager_ms;olap_latency_ms;ops;read;scan;theta;fields;log;throughput;p50_us;p99_us;p999_us;max_us;"
+    "type_latencies;aborts_by_reason;rate;perf;placement;oversubscription";
+
+/*
+ * Measures a single run for transaction_iterations transactions per worker or, if NFN_DURATION is set to
+ * "warm-up,measurement[,cool-down]" seconds, until the duration has passed. The throughput of timed runs is only
+ * computed over the measurement window. NFN_SAMPLE=<ms> samples the counters of all workers at this interval into
+ * samples.csv. The OLTP workers of an open-loop run are paced by common::Arrivals, scanners always run closed-loop.
+ */
+template <typename Database, typename Func>
+void measureRun(Database* db,
+                Func client,
+                const Run& run,
+                const char* algorithm,
+                uint64_t database_size,
+                uint64_t transaction_iterations,
+                Func scan) {
+  uint64_t cores = run.cores;
+  uint64_t scanners = run.scanners;
+  if (run.prepare) {
+    run.prepare();
+  }
+  prepareTrace(db, run.benchmark, database_size, cores - scanners, transaction_iterations, 0);
+  prepareExecutor(db, cores - scanners, 0);
+  db->global_details_collector = common::DetailCollector{};
+
+  std::unique_ptr<common::RedoLog> redo_log;
+  const char* log_directory = std::getenv("NFN_LOG");
+  if (log_directory != nullptr && log_directory[0] != '\0') {
+    redo_log = openRedoLog(db, log_directory, populationName(run.benchmark, database_size), 0);
+  }
+  auto checkpointer = startCheckpointer(db, redo_log.get(), 0);
 
   assert(cores - scanners >= scanners);
 
+  if (!common::RunControl::configure(std::getenv("NFN_DURATION"))) {
+    std::cout << "Error: NFN_DURATION has to be \"measurement\" or \"warm-up,measurement[,cool-down]\" seconds"
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  common::RunControl::print();
+  common::Placement::limit(cores / run.oversubscription);
+  common::Backoff::configure(common::Placement::oversubscribed(cores) ? common::Backoff::Mode::Park
+                                                                       : common::Backoff::Mode::Spin);
+  common::Placement::print(cores);
+
+  common::Arrivals::setRate(run.rate / (cores - scanners));
+  if (run.rate > 0) {
+    std::cout << "Open-loop run: " << run.rate << " tx/s with "
+              << (common::Arrivals::poisson() ? "poisson" : "constant") << " arrivals, " << common::Arrivals::rate()
+              << " tx/s per worker" << std::endl;
+  }
+
+  std::unique_ptr<common::Sampler> sampler;
+  const char* sample_interval = std::getenv("NFN_SAMPLE");
+  if (sample_interval != nullptr && std::atoi(sample_interval) > 0) {
+    sampler = std::make_unique<common::Sampler>(std::atoi(sample_interval));
+    sampler->start(cores);
+  }
+
   auto start = std::chrono::steady_clock::now();
-  common::ThreadHandler* threads[255];
+  std::vector<std::unique_ptr<common::ThreadHandler>> threads(cores);
   for (uint32_t i = 0; i < cores - scanners; ++i) {
-    threads[i] = new common::ThreadHandler((1 * i) % std::thread::hardware_concurrency());
-    threads[i]->run(client, std::ref(*db), database_size, transaction_iterations, (1 * i));
+    threads[i] = std::make_unique<common::ThreadHandler>(common::Placement::allowed(i));
+    threads[i]->run(
+        [client](Database& db, uint32_t population, int max_transactions, uint16_t core_id) {
+          common::Arrivals::open();
+          client(db, population, max_transactions, core_id);
+        },
+        std::ref(*db), database_size, transaction_iterations, (1 * i));
   }
 
   for (uint32_t i = cores - scanners; i < cores; ++i) {
-    threads[i] = new common::ThreadHandler((1 * i) % std::thread::hardware_concurrency());
+    threads[i] = std::make_unique<common::ThreadHandler>(common::Placement::allowed(i));
     threads[i]->run(scan, std::ref(*db), database_size, (cores - scanners), (1 * i));
   }
 
+  common::RunControl::run();
+
   for (uint32_t i = 0; i < cores - scanners; ++i) {
     threads[i]->join();
   }
@@ -101,25 +410,35 @@ void runBenchmark(Database* db,
 
   auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
   std::cout << "Time needed (brutto): " << diff.count() << "ms" << std::endl;
+  printExecutor(db, 0);
 
-#ifdef perf
-  p.stopCounters();
-  p.printReport(std::cout, transaction_iterations * cores);
-#endif
+  if (sampler) {
+    sampler->stop();
+  }
+  if (checkpointer) {
+    checkpointer->stop();
+    checkpointer->printStatistics();
+  }
+  if (redo_log) {
+    redo_log->close();
+    redo_log->printStatistics();
+  }
 
   common::CSVWriter csvwriter;
+  csvwriter.setHeader(result_columns);
   auto log = std::stringstream{};
-  std::string bench{benchmark};
+  std::string bench{run.benchmark};
   std::string algo{algorithm};
 
   if (!algo.substr(0, 3).compare("SGT") && bench.front() == 'm') {
     algo = "M" + algo;
   }
 
-  std::string ycsb{";0;0;0;0"};
+  std::string ycsb{";0;0;0;0;0"};
   if (!bench.substr(5, 4).compare("ycsb")) {
-    ycsb = bench.substr(9);
-    bench = bench.substr(0, 9);
+    auto parameters = bench.find(';');
+    ycsb = bench.substr(parameters);
+    bench = bench.substr(0, parameters);
   }
 
   log << bench << ";" << algo << ";" << database_size << ";" << transaction_iterations << ";" << (cores - scanners)
@@ -127,13 +446,92 @@ void runBenchmark(Database* db,
 
   db->global_details_collector.writeCSV(log);
 
-  log << ycsb;
+  log << ycsb << ";" << (redo_log ? (redo_log->async() ? "wal_epoch" : "wal") : "none");
+
+  log << ";" << static_cast<uint64_t>(db->global_details_collector.throughput(diff));
+  db->global_details_collector.writeLatencyCSV(log);
+  db->global_details_collector.writeAbortCSV(log);
+  log << ";" << run.rate;
+  db->global_details_collector.writePerfCSV(log);
+  log << ";" << common::Placement::policy() << ";" << run.oversubscription;
 
   csvwriter.log(log.str());
 
+  if (common::Sweep::enabled()) {
+    std::stringstream configuration;
+    configuration << bench << ";" << algo << ";" << database_size << ";" << (cores - scanners) << ";" << scanners
+                  << ycsb << ";" << run.rate << ";" << common::Placement::policy() << ";" << run.oversubscription;
+    common::Sweep::record(configuration.str(), {db->global_details_collector.throughput(diff),
+                                                db->global_details_collector.abortRate(),
+                                                db->global_details_collector.latency(0.99)});
+  }
+
+  if (sampler) {
+    std::stringstream prefix;
+    prefix << bench << ";" << algo << ";" << database_size << ";" << (cores - scanners) << ";" << scanners;
+    sampler->writeCSV(prefix.str());
+    sampler->printStatistics();
+  }
+
   db->global_details_collector.printStatistics();
 
   std::cout << "Total Memory Needed: " << getValue() / 1024.0 << "MB" << std::endl;
+}
+
+/*
+ * Populates (or restores) the database once and measures all runs on it, s.t., e.g., a sweep over core counts does
+ * not repopulate the database for every run. See measureRun for the run configuration by environment variables.
+ */
+template <typename Database, typename Func>
+void runBenchmark(Database* db,
+                  Func client,
+                  const std::vector<Run>& runs,
+                  const char* algorithm,
+                  uint64_t database_size,
+                  uint64_t transaction_iterations,
+                  Func scan = nullptr) {
+  common::PerfCounters::configure(std::getenv("NFN_PERF"));
+  common::PerfCounters population;
+  if (common::PerfCounters::enabled() && !population.open(true)) {
+    std::cout << "Perf: performance counters not available (" << strerror(errno) << "), running without" << std::endl;
+    common::PerfCounters::configure(nullptr);
+  }
+
+  uint64_t rows = loadDatabase(db, runs.front().benchmark.c_str(), database_size);
+  if (common::PerfCounters::enabled()) {
+    // the loader threads have exited, their inherited counts are part of the population counters now
+    auto values = population.read();
+    std::cout << "Perf population: " << rows << " rows, per row";
+    for (uint8_t e = 0; e < common::PerfCounters::events; ++e) {
+      std::cout << (e == 0 ? " " : ", ") << common::PerfCounters::names[e] << " ";
+      if (common::PerfCounters::supported(static_cast<common::PerfCounters::Event>(e)))
+        std::cout << values.v[e] / static_cast<double>(std::max<uint64_t>(rows, 1));
+      else
+        std::cout << "n/a";
+    }
+    std::cout << std::endl;
+  }
+  std::cout << "Memory Needed for Database population: " << getValue() / 1024.0 << "MB" << std::endl;
+
+  if (recoveryMode) {
+    auto population = populationName(runs.front().benchmark, database_size);
+    recoverDatabase(db, std::getenv("NFN_LOG"), population, runs.front().cores, 0);
+    db->deleteDatabase();
+    delete db;
+    return;
+  }
+
+  common::AbortReasons::Tables tables;
+  db->snapshotDatabase(tables);
+
+  for (uint64_t i = 0; i < runs.size(); ++i) {
+    if (runs.size() > 1) {
+      std::cout << "Run " << (i + 1) << "/" << runs.size() << ": " << runs[i].benchmark << " " << algorithm << " on "
+                << runs[i].cores << " cores" << std::endl;
+    }
+    measureRun(db, client, runs[i], algorithm, database_size, transaction_iterations, scan);
+  }
+
   db->deleteDatabase();
   delete db;
 }
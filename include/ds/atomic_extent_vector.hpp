@@ -23,6 +23,7 @@
 #pragma once
 
 #include "common/shared_spin_mutex.hpp"
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <cstring>
@@ -30,6 +31,7 @@
 #include <vector>
 #include <stdint.h>
 #include <sys/mman.h>
+#include <unistd.h>
 
 namespace atom {
 template <typename Value>
@@ -38,8 +40,12 @@ class AtomicExtentVectorIterator;
 template <typename Value>
 class AtomicExtentVector {
  public:
+  using value_type = Value;
+  static constexpr uint64_t element_size = sizeof(std::atomic<Value>);
+
  private:
   static constexpr uint8_t max_power_size_ = 64;
+  static constexpr uint64_t write_chunk = 1 << 20;
   std::atomic<Value>** buckets_;
   std::atomic<Value>** deallocations[3];
   std::atomic<bool>** alive_;
@@ -61,9 +67,12 @@ class AtomicExtentVector {
   AtomicExtentVector() : extent_(0), size_(0), lowest_alive_(0), safe_read_(0), mutex_(){};
 
   AtomicExtentVector(const AtomicExtentVector&) = default;
-  ~AtomicExtentVector() {
+  ~AtomicExtentVector() { release(); }
+
+  // frees all segments, s.t. the vector is empty and unreserved
+  inline void release() {
     for (uint64_t i = 0; i < extent_; i++) {
-      auto size = 1ul << (i + reserved_ - 1);
+      auto size = i == 0 ? 1ul << reserved_ : 1ul << (i + reserved_ - 1);
       deallocate(buckets_[i], sizeof(std::atomic<Value>) * size);
       deallocate(alive_[i], sizeof(std::atomic<bool>) * size);
     }
@@ -84,8 +93,13 @@ class AtomicExtentVector {
       delete[] deallocations[2];
       delete[] alive_deallocations[2];
     }
+    extent_ = 0;
+    reserved_ = 0;
+    size_ = 0;
+    safe_read_ = 0;
   }
 
+
   inline constexpr uint64_t safe_size() const { return safe_read_; }
 
   inline constexpr uint64_t size() const { return size_; }
@@ -122,6 +136,12 @@ class AtomicExtentVector {
 
   inline Value lookup(const uint8_t segment, const uint64_t off_n) const { return buckets_[segment][off_n].load(); }
 
+  // loads the cache line of the n-th value without waiting for it
+  inline void prefetch(const uint64_t n) const {
+    uint8_t v = get_segment_base_offset(n);
+    __builtin_prefetch(&buckets_[v][n - get_segment_base(v)]);
+  }
+
   inline Value atomic_replace(const uint64_t n, const Value& value) {
     uint8_t v = get_segment_base_offset(n);
     uint64_t off_n = n - get_segment_base(v);
@@ -187,6 +207,112 @@ class AtomicExtentVector {
     return new_n;
   }
 
+  // writes slot n of a reserved vector, s.t. disjoint ranges can be populated by multiple threads
+  template <typename T>
+  inline void store(const uint64_t n, T&& value) {
+    uint64_t size = size_;
+    while (size <= n && !size_.compare_exchange_weak(size, n + 1)) {
+    }
+    while (n >= max_size()) {
+      resize();
+    }
+    uint8_t v = get_segment_base_offset(n);
+    uint64_t off_n = n - get_segment_base(v);
+    buckets_[v][off_n].store(std::forward<T>(value));
+    alive_[v][off_n].store(true);
+    safe_read_++;
+  }
+
+  // writes the rows of the vector consecutively to fd at offset and pads the file to the reserved capacity
+  inline bool write(int fd, uint64_t offset) const {
+    return write(fd, offset, [](uint64_t) { return true; });
+  }
+
+  // as above, but in chunks of at most write_chunk bytes after each of which throttle(bytes) decides whether to go
+  // on; rows are not synchronized with concurrent writers, i.e., the image is fuzzy unless the vector is quiescent
+  template <typename Throttle>
+  inline bool write(int fd, uint64_t offset, Throttle&& throttle) const {
+    uint64_t rows = size_;
+    for (uint64_t n = 0; n < rows;) {
+      uint8_t v = get_segment_base_offset(n);
+      uint64_t count = std::min(rows, get_segment_base(v + 1)) - n;
+      const char* data = reinterpret_cast<const char*>(buckets_[v]);
+      for (uint64_t written = 0; written < count * sizeof(std::atomic<Value>);) {
+        auto chunk = std::min(count * sizeof(std::atomic<Value>) - written, write_chunk);
+        auto res = pwrite(fd, data + written, chunk, offset + written);
+        if (res < 0 || !throttle(res))
+          return false;
+        written += res;
+      }
+      offset += count * sizeof(std::atomic<Value>);
+      n += count;
+    }
+    uint64_t capacity = upper_power_of_two(std::max<uint64_t>(max_size(), 2));
+    return ftruncate(fd, offset + (capacity - rows) * sizeof(std::atomic<Value>)) == 0;
+  }
+
+  // overwrites the rows [begin, end) by the values stored consecutively at offset of fd, i.e., an image of write
+  inline bool read(int fd, uint64_t offset, uint64_t begin, uint64_t end) {
+    for (uint64_t n = begin; n < end;) {
+      uint8_t v = get_segment_base_offset(n);
+      uint64_t count = std::min(end, get_segment_base(v + 1)) - n;
+      char* data = reinterpret_cast<char*>(buckets_[v] + (n - get_segment_base(v)));
+      for (uint64_t read = 0; read < count * sizeof(std::atomic<Value>);) {
+        auto res = pread(fd, data + read, count * sizeof(std::atomic<Value>) - read, offset + n * sizeof(std::atomic<Value>) + read);
+        if (res <= 0)
+          return false;
+        read += res;
+      }
+      n += count;
+    }
+    return true;
+  }
+
+  // replaces the empty vector by rows values stored at offset of fd, which are mapped copy-on-write as first segment
+  // of the given capacity; with hugepages the values are read into anonymous memory instead, since file mappings are
+  // not backed by huge pages
+  inline bool map(int fd, uint64_t offset, uint64_t rows, uint64_t capacity, bool populate, bool hugepages) {
+    mutex_.lock();
+    assert(size_ == 0);
+    release();
+    uint64_t n = upper_power_of_two(std::max<uint64_t>(std::max(rows, capacity), 2));
+    void* ptr = nullptr;
+    if (hugepages) {
+      ptr = allocate(sizeof(std::atomic<Value>) * n);
+      char* data = reinterpret_cast<char*>(ptr);
+      for (uint64_t read = 0; ptr != (void*)-1 && read < rows * sizeof(std::atomic<Value>);) {
+        auto res = pread(fd, data + read, rows * sizeof(std::atomic<Value>) - read, offset + read);
+        if (res <= 0) {
+          deallocate(ptr, sizeof(std::atomic<Value>) * n);
+          ptr = (void*)-1;
+          break;
+        }
+        read += res;
+      }
+    } else {
+      int flags = MAP_PRIVATE | (populate ? MAP_POPULATE : 0);
+      ptr = mmap(nullptr, sizeof(std::atomic<Value>) * n, PROT_READ | PROT_WRITE, flags, fd, offset);
+    }
+    if (ptr == (void*)-1) {
+      mutex_.unlock();
+      return false;
+    }
+
+    buckets_ = new std::atomic<Value>*[8]();
+    alive_ = new std::atomic<bool>*[8]();
+    buckets_[0] = reinterpret_cast<std::atomic<Value>*>(ptr);
+    alive_[0] = new (allocate(sizeof(std::atomic<bool>) * n)) std::atomic<bool>[n]();
+    for (uint64_t i = 0; i < rows; i++) {
+      alive_[0][i] = true;
+    }
+    reserved_ = 64 - __builtin_clzl(n) - 1;
+    extent_ = 1;
+    size_ = rows;
+    safe_read_ = rows;
+    mutex_.unlock();
+    return true;
+  }
+
   inline void reserve(std::size_t n) {
     mutex_.lock();
     if (extent_ == 0 && n > 0) {
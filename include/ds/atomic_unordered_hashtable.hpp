@@ -150,6 +150,26 @@ class AtomicUnorderedHashtable {
   inline constexpr uint64_t size() const { return size_; }
   inline constexpr uint64_t max_size() const { return max_size_; }
 
+  // the two dependent loads of a lookup without waiting for them: the slot of key and, once the slot is cached, the
+  // first bucket of its chain; prefetches never fault, hence a bucket removed meanwhile is harmless
+  inline void prefetch(const Key key) const { __builtin_prefetch(&buckets_[hashKey(key) % max_size_]); }
+
+  inline void prefetchBucket(const Key key) const {
+    Bucket* elem = buckets_[hashKey(key) % max_size_].load(std::memory_order_relaxed);
+    if (elem != nullptr)
+      __builtin_prefetch(elem);
+  }
+
+  // visits every bucket with its slot without any synchronization, i.e., the table must not be modified concurrently
+  template <typename Func>
+  inline void unsafe_for_each(Func&& func) const {
+    for (uint64_t i = 0; i < max_size_; i++) {
+      for (Bucket* elem = buckets_[i].load(); elem != nullptr; elem = elem->next.load()) {
+        func(i, *elem);
+      }
+    }
+  }
+
   inline bool erase(const Key key) {
     uint64_t hash = hashKey(key) % max_size_;
     std::atomic<Bucket*> prv;
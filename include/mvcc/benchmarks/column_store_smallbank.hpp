@@ -22,12 +22,16 @@
 
 #pragma once
 #include "common/details_collector.hpp"
+#include "common/parallel_loader.hpp"
+#include "common/placement.hpp"
+#include "common/snapshot.hpp"
 #include "ds/atomic_extent_vector.hpp"
 #include "ds/atomic_singly_linked_list.hpp"
 #include "ds/atomic_unordered_map.hpp"
 #include "ds/extent_vector.hpp"
 #include "mvcc/benchmarks/read_guard.hpp"
 #include "mvcc/benchmarks/write_guard.hpp"
+#include <cstring>
 #include <iomanip>
 #include <memory>
 #include <random>
@@ -199,20 +203,19 @@ struct Database {
     checking_map = nullptr;
   }
 
-  static void client(Database<TC, WM, Locking>& db, uint32_t population, int max_transactions, uint8_t core_id) {
+  static void client(Database<TC, WM, Locking>& db, uint32_t population, int max_transactions, uint16_t core_id) {
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
     // uint64_t transactions[10];
-    while ((core_id % std::thread::hardware_concurrency()) != (unsigned)sched_getcpu()) {
-    }
+    common::Placement::wait(core_id);
 
     db.active_thr_++;
 
     common::DetailCollector dc;
     dc.startWorker();
 
-    for (int i = 0; i < max_transactions; ++i) {
+    for (int i = 0; common::RunControl::proceed(i, max_transactions); ++i) {
       bool restart = false;
       uint16_t transaction_select = dis(gen) % 100;
       StringStruct<20> name1;
@@ -228,21 +231,27 @@ struct Database {
       int res = 0;
       dc.startTX();
       if (transaction_select < 25) {
+        dc.setType(common::DetailCollector::first_type + 0, "SendPayment");
         res = db.sendPayment(transaction, name1, name2, 5.0);
       } else if (transaction_select < 40) {
         double balance = 0;
+        dc.setType(common::DetailCollector::first_type + 1, "Balance");
         res = db.getBalance(transaction, name1, balance);
 
       } else if (transaction_select < 55) {
+        dc.setType(common::DetailCollector::first_type + 2, "DepositChecking");
         res = db.depositChecking(transaction, name1, 1.3);
 
       } else if (transaction_select < 70) {
+        dc.setType(common::DetailCollector::first_type + 3, "TransactSaving");
         res = db.transactSaving(transaction, name1, 20.20);
 
       } else if (transaction_select < 85) {
+        dc.setType(common::DetailCollector::first_type + 4, "WriteCheck");
         res = db.writeCheck(transaction, name1, 5.0);
 
       } else {
+        dc.setType(common::DetailCollector::first_type + 5, "Amalgamate");
         res = db.amalgamate(transaction, name1, name2);
       }
 
@@ -294,20 +303,19 @@ struct Database {
   static void clientHighContention(Database<TC, WM, Locking>& db,
                                    uint32_t population,
                                    int max_transactions,
-                                   uint8_t core_id) {
+                                   uint16_t core_id) {
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
     // uint64_t transactions[10];
-    while ((core_id % std::thread::hardware_concurrency()) != (unsigned)sched_getcpu()) {
-    }
+    common::Placement::wait(core_id);
 
     db.active_thr_++;
 
     common::DetailCollector dc;
     dc.startWorker();
 
-    for (int i = 0; i < max_transactions; ++i) {
+    for (int i = 0; common::RunControl::proceed(i, max_transactions); ++i) {
       bool restart = false;
       uint16_t transaction_select[8];
       StringStruct<20> name1[8];
@@ -327,21 +335,27 @@ struct Database {
       dc.startTX();
       for (auto i = 0; i < 8; i++) {
         if (transaction_select[i] < 25) {
+          dc.setType(common::DetailCollector::first_type + 0, "SendPayment");
           res = db.sendPayment(transaction, name1[i], name2[i], 5.0);
         } else if (transaction_select[i] < 40) {
           double balance = 0;
+          dc.setType(common::DetailCollector::first_type + 1, "Balance");
           res = db.getBalance(transaction, name1[i], balance);
 
         } else if (transaction_select[i] < 55) {
+          dc.setType(common::DetailCollector::first_type + 2, "DepositChecking");
           res = db.depositChecking(transaction, name1[i], 1.3);
 
         } else if (transaction_select[i] < 70) {
+          dc.setType(common::DetailCollector::first_type + 3, "TransactSaving");
           res = db.transactSaving(transaction, name1[i], 20.20);
 
         } else if (transaction_select[i] < 85) {
+          dc.setType(common::DetailCollector::first_type + 4, "WriteCheck");
           res = db.writeCheck(transaction, name1[i], 5.0);
 
         } else {
+          dc.setType(common::DetailCollector::first_type + 5, "Amalgamate");
           res = db.amalgamate(transaction, name1[i], name2[i]);
         }
       }
@@ -392,13 +406,12 @@ struct Database {
   }
 
   template <int test = 0, bool OLAP = false>
-  static void clientTest(Database<TC, WM, Locking>& db, uint32_t population, int max_transactions, uint8_t core_id) {
+  static void clientTest(Database<TC, WM, Locking>& db, uint32_t population, int max_transactions, uint16_t core_id) {
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
     // uint64_t transactions[10];
-    while ((core_id % std::thread::hardware_concurrency()) != (unsigned)sched_getcpu()) {
-    }
+    common::Placement::wait(core_id);
     double total_old = 0, total = 0;
 
     db.active_thr_++;
@@ -406,7 +419,7 @@ struct Database {
     common::DetailCollector dc;
     dc.startWorker();
 
-    for (int i = 0; i < max_transactions; ++i) {
+    for (int i = 0; common::RunControl::proceed(i, max_transactions); ++i) {
       bool restart = false;
       uint16_t transaction_select = dis(gen) % 100;
       StringStruct<20> name1;
@@ -423,26 +436,33 @@ struct Database {
       /// NOCHANGE
       if (test == 0) {
         if (transaction_select < 70) {
+          dc.setType(common::DetailCollector::first_type + 0, "SendPayment");
           res = db.sendPayment(transaction, name1, name2, 500);
         } else if (transaction_select < 90) {
           double balance = 0;
+          dc.setType(common::DetailCollector::first_type + 1, "Balance");
           res = db.getBalance(transaction, name1, balance);
         } else {
           total = 0;
+          dc.setType(common::DetailCollector::first_type + 6, "TotalChecking");
           res = db.getTotalChecking<OLAP>(transaction, total);
         }
       }
       // Monotone Increasing
       else if (test == 1) {
         if (transaction_select < 70) {
+          dc.setType(common::DetailCollector::first_type + 0, "SendPayment");
           res = db.sendPayment(transaction, name1, name2, 500);
         } else if (transaction_select < 80) {
           double balance = 0;
+          dc.setType(common::DetailCollector::first_type + 1, "Balance");
           res = db.getBalance(transaction, name1, balance);
         } else if (transaction_select < 90) {
+          dc.setType(common::DetailCollector::first_type + 2, "DepositChecking");
           res = db.depositChecking(transaction, name1, 1300);
         } else {
           total = 0;
+          dc.setType(common::DetailCollector::first_type + 6, "TotalChecking");
           res = db.getTotalChecking<OLAP>(transaction, total);
         }
       }
@@ -500,20 +520,19 @@ struct Database {
     db.emp.remove();
   }
 
-  static void clientScan(Database<TC, WM, Locking>& db, uint32_t population, int max_transactions, uint8_t core_id) {
+  static void clientScan(Database<TC, WM, Locking>& db, uint32_t population, int max_transactions, uint16_t core_id) {
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
     // uint64_t transactions[10];
-    while ((core_id % std::thread::hardware_concurrency()) != (unsigned)sched_getcpu()) {
-    }
+    common::Placement::wait(core_id);
 
     db.active_thr_++;
 
     common::DetailCollector dc;
     dc.startWorker();
 
-    for (int i = 0; i < max_transactions; ++i) {
+    for (int i = 0; common::RunControl::proceed(i, max_transactions); ++i) {
       bool restart = false;
       uint16_t transaction_select = dis(gen) % 100;
       StringStruct<20> name1;
@@ -530,26 +549,33 @@ struct Database {
       bool olap = false;
       dc.startTX();
       if (transaction_select < 24) {
+        dc.setType(common::DetailCollector::first_type + 0, "SendPayment");
         res = db.sendPayment(transaction, name1, name2, 5.0);
 
       } else if (transaction_select < 38) {
         double balance;
+        dc.setType(common::DetailCollector::first_type + 1, "Balance");
         res = db.getBalance(transaction, name1, balance);
 
       } else if (transaction_select < 52) {
+        dc.setType(common::DetailCollector::first_type + 2, "DepositChecking");
         res = db.depositChecking(transaction, name1, 1.3);
 
       } else if (transaction_select < 66) {
+        dc.setType(common::DetailCollector::first_type + 3, "TransactSaving");
         res = db.transactSaving(transaction, name1, 20.20);
 
       } else if (transaction_select < 80) {
+        dc.setType(common::DetailCollector::first_type + 4, "WriteCheck");
         res = db.writeCheck(transaction, name1, 5.0);
 
       } else if (transaction_select < 95) {
+        dc.setType(common::DetailCollector::first_type + 5, "Amalgamate");
         res = db.amalgamate(transaction, name1, name2);
       } else {
         double total;
         olap = true;
+        dc.setType(common::DetailCollector::first_type + 6, "TotalChecking");
         res = db.getTotalChecking(transaction, total);
       }
 
@@ -598,13 +624,12 @@ struct Database {
     db.emp.remove();
   }
 
-  static void clienOLAPOnly(Database<TC, WM, Locking>& db, uint32_t population, int oltp_worker, uint8_t core_id) {
+  static void clienOLAPOnly(Database<TC, WM, Locking>& db, uint32_t population, int oltp_worker, uint16_t core_id) {
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
     // uint64_t transactions[10];
-    while ((core_id % std::thread::hardware_concurrency()) != (unsigned)sched_getcpu()) {
-    }
+    common::Placement::wait(core_id);
 
     while (db.active_thr_ < (unsigned)oltp_worker) {
     }
@@ -625,6 +650,7 @@ struct Database {
 
       double total = 0;
       bool olap = true;
+      dc.setType(common::DetailCollector::first_type + 6, "TotalChecking");
       res = db.getTotalChecking(transaction, total);
 
       if (restart != 0) {
@@ -673,20 +699,19 @@ struct Database {
   static void clientReadOnly(Database<TC, WM, Locking>& db,
                              uint32_t population,
                              int max_transactions,
-                             uint8_t core_id) {
+                             uint16_t core_id) {
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
     // uint64_t transactions[10];
-    while ((core_id % std::thread::hardware_concurrency()) != (unsigned)sched_getcpu()) {
-    }
+    common::Placement::wait(core_id);
 
     db.active_thr_++;
 
     common::DetailCollector dc;
     dc.startWorker();
 
-    for (int i = 0; i < max_transactions; ++i) {
+    for (int i = 0; common::RunControl::proceed(i, max_transactions); ++i) {
       bool restart = false;
       uint16_t transaction_select = dis(gen) % 100;
       StringStruct<20> name1;
@@ -703,10 +728,12 @@ struct Database {
         double balance = 0;
         StringStruct<20> name1;
         db.getRandomName(name1, population, 25, 100, gen);
+        dc.setType(common::DetailCollector::first_type + 1, "Balance");
         res = db.getBalance(transaction, name1, balance);
 
       } else {
         double total = 0;
+        dc.setType(common::DetailCollector::first_type + 6, "TotalChecking");
         res = db.getTotalChecking(transaction, total);
       }
 
@@ -754,14 +781,63 @@ struct Database {
   }
   void abort(uint64_t transaction) { tc.abort(transaction); }
 
-  void populateDatabase(uint32_t population) {
+  uint64_t populateDatabase(uint32_t population, uint64_t seed = common::ParallelLoader::default_seed) {
     const uint64_t min_balance = 10000;
     const uint64_t max_balance = 50000;
 
-    std::random_device rd;
-    std::mt19937 random_gen(rd());
-    std::uniform_int_distribution<unsigned int> dis(min_balance, max_balance);
+    common::ParallelLoader loader{seed};
+
+    reserveSlots(population);
+
+    loader.run(0, common::ParallelLoader::partitions(population), [&](uint64_t partition, std::mt19937& random_gen) {
+      std::uniform_int_distribution<unsigned int> dis(min_balance, max_balance);
+      auto end = common::ParallelLoader::partitionEnd(partition, population);
+      for (uint64_t id = common::ParallelLoader::partitionBegin(partition); id < end; ++id) {
+        uint64_t cust_id = id + 1;
+        // initilize subscriber
+
+        StringStruct<20> stringstruct;
+        char buffer[21];
+        sprintf(buffer, "%.20lu", cust_id);
+        std::memcpy(stringstruct.string, buffer, 20);
+
+        name_map->insert(stringstruct, id);
+
+        a.name.store(id, stringstruct);
+        a.customer_id.store(id, cust_id);
+        a.version_chain.store(id, nullptr);
+        a.lsn.store(id, 0);
+        a.locked.store(id, static_cast<Locking>(0));
+        a.rw_table.store(id, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+
+        saving_map->insert(cust_id, id);
+        s.customer_id.store(id, cust_id);
+        s.balance.store(id, dis(random_gen));
+        s.version_chain.store(id, nullptr);
+        s.lsn.store(id, 0);
+        s.locked.store(id, static_cast<Locking>(0));
+        s.rw_table.store(id, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+
+        checking_map->insert(cust_id, id);
+        c.customer_id.store(id, cust_id);
+        c.balance.store(id, dis(random_gen));
+        c.version_chain.store(id, nullptr);
+        c.lsn.store(id, 0);
+        c.locked.store(id, static_cast<Locking>(0));
+        c.rw_table.store(id, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+      }
+      return 3 * (end - common::ParallelLoader::partitionBegin(partition));
+    });
+    return loader.rows();
+  }
+
+  uint64_t restoreDatabase(uint64_t population, common::Snapshot& snapshot) {
+    reserveSlots(population);
+    snapshotDatabase(snapshot);
+    return snapshot.rows();
+  }
 
+  void reserveSlots(uint64_t population) {
     a.name.reserve(population);
     a.customer_id.reserve(population);
     a.version_chain.reserve(population);
@@ -794,40 +870,41 @@ struct Database {
     checking_map = std::make_unique<atom::AtomicUnorderedMap<
         uint64_t, uint64_t, atom::AtomicUnorderedMapBucket<uint64_t, uint64_t>, common::ChunkAllocator>>(population,
                                                                                                          &ca, &emp);
+  }
 
-    for (uint64_t cust_id = 1; cust_id <= population; ++cust_id) {
-      // initilize subscriber
-
-      StringStruct<20> stringstruct;
-      char buffer[21];
-      sprintf(buffer, "%.20lu", cust_id);
-      strncpy(stringstruct.string, buffer, 20);
-
-      name_map->insert(stringstruct, a.customer_id.size());
-
-      a.name.push_back(stringstruct);
-      a.customer_id.push_back(cust_id);
-      a.version_chain.push_back(nullptr);
-      a.lsn.push_back(0);
-      a.locked.push_back(static_cast<Locking>(0));
-      a.rw_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
-
-      saving_map->insert(cust_id, s.customer_id.size());
-      s.customer_id.push_back(cust_id);
-      s.balance.push_back(dis(random_gen));
-      s.version_chain.push_back(nullptr);
-      s.lsn.push_back(0);
-      s.locked.push_back(static_cast<Locking>(0));
-      s.rw_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
-
-      checking_map->insert(cust_id, c.customer_id.size());
-      c.customer_id.push_back(cust_id);
-      c.balance.push_back(dis(random_gen));
-      c.version_chain.push_back(nullptr);
-      c.lsn.push_back(0);
-      c.locked.push_back(static_cast<Locking>(0));
-      c.rw_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
-    }
+  // visits all columns and indexes, s.t. the database can be written to or restored from a snapshot and its columns
+  // can be named for the abort statistics
+  template <typename Visitor>
+  void snapshotDatabase(Visitor& snapshot) {
+    auto zero = []() { return 0; };
+    auto unlocked = []() { return static_cast<Locking>(0); };
+    auto list = [&]() { return new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp}; };
+    auto no_version = []() { return nullptr; };
+
+    snapshot.column("a.name", a.name);
+    snapshot.column("a.customer_id", a.customer_id);
+    snapshot.rebuild(a.lsn, a.name.size(), zero);
+    snapshot.rebuild(a.version_chain, a.name.size(), no_version);
+    snapshot.rebuild(a.locked, a.name.size(), unlocked);
+    snapshot.rebuild(a.rw_table, a.name.size(), list);
+
+    snapshot.column("s.customer_id", s.customer_id);
+    snapshot.column("s.balance", s.balance);
+    snapshot.rebuild(s.lsn, s.customer_id.size(), zero);
+    snapshot.rebuild(s.version_chain, s.customer_id.size(), no_version);
+    snapshot.rebuild(s.locked, s.customer_id.size(), unlocked);
+    snapshot.rebuild(s.rw_table, s.customer_id.size(), list);
+
+    snapshot.column("c.customer_id", c.customer_id);
+    snapshot.column("c.balance", c.balance);
+    snapshot.rebuild(c.lsn, c.customer_id.size(), zero);
+    snapshot.rebuild(c.version_chain, c.customer_id.size(), no_version);
+    snapshot.rebuild(c.locked, c.customer_id.size(), unlocked);
+    snapshot.rebuild(c.rw_table, c.customer_id.size(), list);
+
+    snapshot.index("name_map", *name_map);
+    snapshot.index("saving_map", *saving_map);
+    snapshot.index("checking_map", *checking_map);
   }
 
   void printTable() {
@@ -892,7 +969,7 @@ struct Database {
 
     char buffer[21];
     sprintf(buffer, "%.20lu", cust_id);
-    strncpy(name.string, buffer, 20);
+    std::memcpy(name.string, buffer, 20);
   }
 
   void waitAndTidy() { tc.waitAndTidy(); }
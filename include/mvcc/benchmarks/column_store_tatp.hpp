@@ -21,13 +21,18 @@
 //
 
 #pragma once
+#include "common/backoff.hpp"
 #include "common/details_collector.hpp"
 #include "common/optimistic_predicate_locking.hpp"
+#include "common/parallel_loader.hpp"
+#include "common/placement.hpp"
+#include "common/snapshot.hpp"
 #include "ds/atomic_extent_vector.hpp"
 #include "ds/atomic_singly_linked_list.hpp"
 #include "ds/atomic_unordered_map.hpp"
 #include "mvcc/benchmarks/read_guard.hpp"
 #include "mvcc/benchmarks/write_guard.hpp"
+#include <cstring>
 #include <iomanip>
 #include <memory>
 #include <random>
@@ -416,41 +421,46 @@ struct Database {
  public:
   Database(bool online = false) : tc(&ca, &emp, online), active_thr_(0), wm_(std::thread::hardware_concurrency()) {}
 
-  static void client(Database<TC, WM, Locking>& db, uint32_t population, int max_transactions, uint8_t core_id) {
+  static void client(Database<TC, WM, Locking>& db, uint32_t population, int max_transactions, uint16_t core_id) {
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
     // uint64_t transactions[10];
 
-    while ((core_id % std::thread::hardware_concurrency()) != (unsigned)sched_getcpu()) {
-    }
+    common::Placement::wait(core_id);
 
     db.active_thr_++;
 
     common::DetailCollector dc;
     dc.startWorker();
 
-    for (int i = 0; i < max_transactions; ++i) {
+    for (int i = 0; common::RunControl::proceed(i, max_transactions); ++i) {
       bool restart = false;
       uint16_t transaction_select = dis(gen) % 100;
       auto sid = db.getRandomSId(population, 1, population, gen);
       uint64_t transaction = 0, old_transaction = 0;
       std::unordered_set<uint64_t> aborted_transaction;
+      dc.startLatency();
     restart:
       transaction = db.tc.start();
       db.bot(transaction);
+      dc.startTX();
 
       int res = 0;
       if (transaction_select < 35) {
         VersionSubscriber s;
+        dc.setType(common::DetailCollector::first_type + 0, "GetSubscriberData");
         res = db.getSubscriberData(transaction, sid, s);
       } else if (transaction_select < 45) {
         std::vector<StringStruct<15>> result;
+        dc.setType(common::DetailCollector::first_type + 1, "GetNewDestination");
         res = db.getNewDestination(transaction, sid, dis(gen) % 4 + 1, 8 * (dis(gen) % 3), dis(gen) % 24 + 1, result);
       } else if (transaction_select < 80) {
         VersionAccess_Info result;
+        dc.setType(common::DetailCollector::first_type + 2, "GetAccessData");
         res = db.getAccessData(transaction, sid, dis(gen) % 4 + 1, result);
       } else if (transaction_select < 82) {
+        dc.setType(common::DetailCollector::first_type + 3, "UpdateSubscriberData");
         res = db.updateSubscriberData(transaction, sid, dis(gen) % 2, dis(gen) % 256, dis(gen) % 4 + 1);
       } else if (transaction_select < 96) {
         // std::stringstream ss;
@@ -458,12 +468,14 @@ struct Database {
         StringStruct<15> stringstruct;
         // strncpy(stringstruct.string, ss.str().c_str(), 15);
         db.getRandomSubNbr(sid, stringstruct.string, 15);
+        dc.setType(common::DetailCollector::first_type + 4, "UpdateLocation");
         res = db.updateLocation(transaction, dis(gen), stringstruct);
       } else if (transaction_select < 98) {
         StringStruct<15> stringstruct;
         db.getRandomSubNbr(sid, stringstruct.string, 15);
         StringStruct<15> numberx;
         db.generateRandomString(numberx.string, 15, gen);
+        dc.setType(common::DetailCollector::first_type + 5, "InsertCallForwarding");
         res = db.insertCallForwarding(transaction, stringstruct, 8 * (dis(gen) % 3), dis(gen) % 24 + 1, numberx,
                                       dis(gen));
       }
@@ -489,6 +501,7 @@ struct Database {
           goto restart;
         }
       }
+      dc.stopLatency(dc.stopTX());
     }
     db.active_thr_--;
     dc.stopWorker();
@@ -513,9 +526,203 @@ struct Database {
     return commit;
   }
 
-  void populateDatabase(uint32_t population) {
-    srand(time(0));
+  uint64_t populateDatabase(uint32_t population, uint64_t seed = common::ParallelLoader::default_seed) {
+    common::ParallelLoader loader{seed};
+    auto partitions = common::ParallelLoader::partitions(population);
+
+    reserveSlots(population);
+
+    // the child counts are drawn first, s.t. every partition starts at a fixed offset of the child tables
+    std::vector<uint8_t> ai_cnts(population), sf_cnts(population), cf_cnts(population);
+    loader.run(1, partitions, [&](uint64_t partition, std::mt19937& gen) {
+      std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
+      auto end = common::ParallelLoader::partitionEnd(partition, population);
+      for (uint64_t id = common::ParallelLoader::partitionBegin(partition); id < end; ++id) {
+        ai_cnts[id] = 1 + dis(gen) % 4;
+        sf_cnts[id] = 1 + dis(gen) % 4;
+        cf_cnts[id] = dis(gen) % 4;
+      }
+      return 0;
+    });
+    std::vector<uint64_t> ai_begins(partitions + 1, 0), sf_begins(partitions + 1, 0), cf_begins(partitions + 1, 0);
+    for (uint64_t p = 0; p < partitions; p++) {
+      ai_begins[p + 1] = ai_begins[p];
+      sf_begins[p + 1] = sf_begins[p];
+      cf_begins[p + 1] = cf_begins[p];
+      auto end = common::ParallelLoader::partitionEnd(p, population);
+      for (uint64_t id = common::ParallelLoader::partitionBegin(p); id < end; ++id) {
+        ai_begins[p + 1] += ai_cnts[id];
+        sf_begins[p + 1] += sf_cnts[id];
+        cf_begins[p + 1] += sf_cnts[id] * cf_cnts[id];
+      }
+    }
+
+    loader.run(0, partitions, [&](uint64_t partition, std::mt19937& gen) {
+      uint64_t ai_id = ai_begins[partition];
+      uint64_t sf_id = sf_begins[partition];
+      uint64_t cf_id = cf_begins[partition];
+      auto end = common::ParallelLoader::partitionEnd(partition, population);
+      for (uint64_t id = common::ParallelLoader::partitionBegin(partition); id < end; ++id) {
+        uint32_t s_id = id + 1;
+        // initilize subscriber
+        s_map->insert(s_id, id);
+
+        std::stringstream ss;
+        ss << std::setfill('0') << std::setw(15) << s_id;
+        StringStruct<15> stringstruct;
+        std::memcpy(stringstruct.string, ss.str().data(), 15);
+        s.sub_nbr.store(id, stringstruct);
+        subnbr_map->insert(stringstruct, id);
+
+        s.s_id.store(id, s_id);
+
+        std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
+        s.bit_1.store(id, dis(gen) % 2);
+        s.bit_2.store(id, dis(gen) % 2);
+        s.bit_3.store(id, dis(gen) % 2);
+        s.bit_4.store(id, dis(gen) % 2);
+        s.bit_5.store(id, dis(gen) % 2);
+        s.bit_6.store(id, dis(gen) % 2);
+        s.bit_7.store(id, dis(gen) % 2);
+        s.bit_8.store(id, dis(gen) % 2);
+        s.bit_9.store(id, dis(gen) % 2);
+        s.bit_10.store(id, dis(gen) % 2);
+
+        s.hex_1.store(id, dis(gen) % 16);
+        s.hex_2.store(id, dis(gen) % 16);
+        s.hex_3.store(id, dis(gen) % 16);
+        s.hex_4.store(id, dis(gen) % 16);
+        s.hex_5.store(id, dis(gen) % 16);
+        s.hex_6.store(id, dis(gen) % 16);
+        s.hex_7.store(id, dis(gen) % 16);
+        s.hex_8.store(id, dis(gen) % 16);
+        s.hex_9.store(id, dis(gen) % 16);
+        s.hex_10.store(id, dis(gen) % 16);
+
+        s.byte2_1.store(id, dis(gen) % 256);
+        s.byte2_2.store(id, dis(gen) % 256);
+        s.byte2_3.store(id, dis(gen) % 256);
+        s.byte2_4.store(id, dis(gen) % 256);
+        s.byte2_5.store(id, dis(gen) % 256);
+        s.byte2_6.store(id, dis(gen) % 256);
+        s.byte2_7.store(id, dis(gen) % 256);
+        s.byte2_8.store(id, dis(gen) % 256);
+        s.byte2_9.store(id, dis(gen) % 256);
+        s.byte2_10.store(id, dis(gen) % 256);
+
+        s.msc_location.store(id, dis(gen));
+        s.vlr_location.store(id, dis(gen));
+
+        s.version_chain.store(id, nullptr);
+        s.lsn.store(id, 0);
+        s.locked.store(id, static_cast<Locking>(0));
+        s.rw_table.store(id, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+
+        uint8_t ai_cnt = ai_cnts[id];
+        uint8_t sf_cnt = sf_cnts[id];
+        uint8_t cf_cnt = cf_cnts[id];
+
+        std::vector<uint8_t> used;
+        for (uint8_t j = 0; j < ai_cnt; ++j) {
+          ai.s_id.store(ai_id + j, s_id);
+          uint8_t ai_type;
+          do {
+            ai_type = 1 + dis(gen) % 4;
+          } while (std::end(used) != std::find(std::begin(used), std::end(used), ai_type));
+          used.push_back(ai_type);
+          ai.ai_type.store(ai_id + j, ai_type);
+          ai.data1.store(ai_id + j, dis(gen) % 256);
+          ai.data2.store(ai_id + j, dis(gen) % 256);
+
+          StringStruct<3> stringstruct_3;
+          generateRandomString(stringstruct_3.string, 3, gen);
+          ai.data3.store(ai_id + j, stringstruct_3);
+
+          StringStruct<5> stringstruct_5;
+          generateRandomString(stringstruct_5.string, 5, gen);
+          ai.data4.store(ai_id + j, stringstruct_5);
+
+          ai.lsn.store(ai_id + j, 0);
+          ai.locked.store(ai_id + j, static_cast<Locking>(0));
+          ai.rw_table.store(ai_id + j, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+          ai.version_chain.store(ai_id + j, nullptr);
+
+          ai_map->insert(ai_map->combine_key(s_id, ai_type - 1, 62), ai_id + j);
+        }
+
+        used.clear();
+        std::vector<uint8_t> used_cf;
+        for (uint8_t j = 0; j < sf_cnt; ++j) {
+          sf.s_id.store(sf_id + j, s_id);
+          uint8_t sf_type;
+          do {
+            sf_type = 1 + dis(gen) % 4;
+          } while (std::end(used) != std::find(std::begin(used), std::end(used), sf_type));
+          used.push_back(sf_type);
+          sf.sf_type.store(sf_id + j, sf_type);
+          sf.is_active.store(sf_id + j, dis(gen) % 7);  // TODO(durner) roughly 85% one but hacky
+          sf.error_cntrl.store(sf_id + j, dis(gen) % 256);
+          sf.data_a.store(sf_id + j, dis(gen) % 256);
+
+          StringStruct<5> stringstruct_5;
+          generateRandomString(stringstruct_5.string, 5, gen);
+          sf.data_b.store(sf_id + j, stringstruct_5);
+
+          sf.lsn.store(sf_id + j, 0);
+          sf.locked.store(sf_id + j, static_cast<Locking>(0));
+          sf.rw_table.store(sf_id + j, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+          sf.version_chain.store(sf_id + j, nullptr);
+
+          sf_map->insert(sf_map->combine_key(s_id, sf_type - 1, 62), sf_id + j);
+
+          std::vector<uint8_t> tabu_set;
+          for (uint8_t k = 0; k < cf_cnt; ++k) {
+            cf.sf_type.store(cf_id + j * cf_cnt + k, sf_type);
+            cf.s_id.store(cf_id + j * cf_cnt + k, s_id);
+
+            uint8_t start_time;
+            do {
+              start_time = 8 * (dis(gen) % 3);
+            } while (std::find(tabu_set.begin(), tabu_set.end(), start_time) != tabu_set.end());
+            tabu_set.push_back(start_time);
+
+            cf.start_time.store(cf_id + j * cf_cnt + k, start_time);
+            cf.end_time.store(cf_id + j * cf_cnt + k, start_time + (dis(gen) % 8) + 1);
+
+            StringStruct<15> stringstruct_15;
+            generateRandomString(stringstruct_15.string, 15, gen);
+            cf.numberx.store(cf_id + j * cf_cnt + k, stringstruct_15);
+
+            cf.lsn.store(cf_id + j * cf_cnt + k, 0);
+            cf.locked.store(cf_id + j * cf_cnt + k, static_cast<Locking>(0));
+            cf.rw_table.store(cf_id + j * cf_cnt + k, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+            cf.version_chain.store(cf_id + j * cf_cnt + k, nullptr);
+
+            cf_map->insert(cf_map->combine_key(s_id, cf_map->combine_key(start_time >> 3, sf_type - 1, 62), 60),
+                           cf_id + j * cf_cnt + k);
+          }
+        }
+        ai_id += ai_cnt;
+        sf_id += sf_cnt;
+        cf_id += sf_cnt * cf_cnt;
+      }
+      return end - common::ParallelLoader::partitionBegin(partition);
+    });
+
+    std::cout << "s_map: " << s_map->size() << std::endl;
+    std::cout << "sf_map: " << sf_map->size() << std::endl;
+    std::cout << "ai_map: " << ai_map->size() << std::endl;
+    std::cout << "cf_map: " << cf_map->size() << std::endl;
+    return loader.rows() + ai_begins[partitions] + sf_begins[partitions] + cf_begins[partitions];
+  }
+
+  uint64_t restoreDatabase(uint64_t population, common::Snapshot& snapshot) {
+    reserveSlots(population);
+    snapshotDatabase(snapshot);
+    return snapshot.rows();
+  }
 
+  void reserveSlots(uint64_t population) {
     s.s_id.reserve(population);
     s.sub_nbr.reserve(population);
     s.bit_1.reserve(population);
@@ -610,154 +817,93 @@ struct Database {
     cf_map = std::make_unique<atom::AtomicUnorderedMap<
         uint64_t, uint64_t, atom::AtomicUnorderedMapBucket<uint64_t, uint64_t>, common::ChunkAllocator>>(4 * population,
                                                                                                          &ca, &emp);
+  }
 
-    for (uint32_t s_id = 1; s_id <= population; ++s_id) {
-      // initilize subscriber
-      s_map->insert(s_id, s.s_id.size());
-
-      std::stringstream ss;
-      ss << std::setfill('0') << std::setw(15) << s_id;
-      StringStruct<15> stringstruct;
-      strncpy(stringstruct.string, ss.str().c_str(), 15);
-      s.sub_nbr.push_back(stringstruct);
-      subnbr_map->insert(stringstruct, s.s_id.size());
-
-      s.s_id.push_back(s_id);
-
-      std::random_device rd;
-      std::mt19937 gen(rd());
-      std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
-      s.bit_1.push_back(dis(gen) % 2);
-      s.bit_2.push_back(dis(gen) % 2);
-      s.bit_3.push_back(dis(gen) % 2);
-      s.bit_4.push_back(dis(gen) % 2);
-      s.bit_5.push_back(dis(gen) % 2);
-      s.bit_6.push_back(dis(gen) % 2);
-      s.bit_7.push_back(dis(gen) % 2);
-      s.bit_8.push_back(dis(gen) % 2);
-      s.bit_9.push_back(dis(gen) % 2);
-      s.bit_10.push_back(dis(gen) % 2);
-
-      s.hex_1.push_back(dis(gen) % 16);
-      s.hex_2.push_back(dis(gen) % 16);
-      s.hex_3.push_back(dis(gen) % 16);
-      s.hex_4.push_back(dis(gen) % 16);
-      s.hex_5.push_back(dis(gen) % 16);
-      s.hex_6.push_back(dis(gen) % 16);
-      s.hex_7.push_back(dis(gen) % 16);
-      s.hex_8.push_back(dis(gen) % 16);
-      s.hex_9.push_back(dis(gen) % 16);
-      s.hex_10.push_back(dis(gen) % 16);
-
-      s.byte2_1.push_back(dis(gen) % 256);
-      s.byte2_2.push_back(dis(gen) % 256);
-      s.byte2_3.push_back(dis(gen) % 256);
-      s.byte2_4.push_back(dis(gen) % 256);
-      s.byte2_5.push_back(dis(gen) % 256);
-      s.byte2_6.push_back(dis(gen) % 256);
-      s.byte2_7.push_back(dis(gen) % 256);
-      s.byte2_8.push_back(dis(gen) % 256);
-      s.byte2_9.push_back(dis(gen) % 256);
-      s.byte2_10.push_back(dis(gen) % 256);
-
-      s.msc_location.push_back(dis(gen));
-      s.vlr_location.push_back(dis(gen));
-
-      s.version_chain.push_back(nullptr);
-      s.lsn.push_back(0);
-      s.locked.push_back(static_cast<Locking>(0));
-      s.rw_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
-
-      uint8_t ai_cnt = 1 + dis(gen) % 4;
-      uint8_t sf_cnt = 1 + dis(gen) % 4;
-      uint8_t cf_cnt = dis(gen) % 4;
-
-      std::vector<uint8_t> used;
-      for (uint8_t j = 0; j < ai_cnt; ++j) {
-        ai.s_id.push_back(s_id);
-        uint8_t ai_type;
-        do {
-          ai_type = 1 + dis(gen) % 4;
-        } while (std::end(used) != std::find(std::begin(used), std::end(used), ai_type));
-        used.push_back(ai_type);
-        ai.ai_type.push_back(ai_type);
-        ai.data1.push_back(dis(gen) % 256);
-        ai.data2.push_back(dis(gen) % 256);
-
-        StringStruct<3> stringstruct_3;
-        generateRandomString(stringstruct_3.string, 3, gen);
-        ai.data3.push_back(stringstruct_3);
-
-        StringStruct<5> stringstruct_5;
-        generateRandomString(stringstruct_5.string, 5, gen);
-        ai.data4.push_back(stringstruct_5);
-
-        ai.lsn.push_back(0);
-        ai.locked.push_back(static_cast<Locking>(0));
-        ai.rw_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
-        ai.version_chain.push_back(nullptr);
-
-        ai_map->insert(ai_map->combine_key(s_id, ai_type - 1, 62), ai.s_id.size() - 1);
-      }
-
-      used.clear();
-      std::vector<uint8_t> used_cf;
-      for (uint8_t j = 0; j < sf_cnt; ++j) {
-        sf.s_id.push_back(s_id);
-        uint8_t sf_type;
-        do {
-          sf_type = 1 + dis(gen) % 4;
-        } while (std::end(used) != std::find(std::begin(used), std::end(used), sf_type));
-        used.push_back(sf_type);
-        sf.sf_type.push_back(sf_type);
-        sf.is_active.push_back(dis(gen) % 7);  // TODO(durner) roughly 85% one but hacky
-        sf.error_cntrl.push_back(dis(gen) % 256);
-        sf.data_a.push_back(dis(gen) % 256);
-
-        StringStruct<5> stringstruct_5;
-        generateRandomString(stringstruct_5.string, 5, gen);
-        sf.data_b.push_back(stringstruct_5);
-
-        sf.lsn.push_back(0);
-        sf.locked.push_back(static_cast<Locking>(0));
-        sf.rw_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
-        sf.version_chain.push_back(nullptr);
-
-        sf_map->insert(sf_map->combine_key(s_id, sf_type - 1, 62), sf.s_id.size() - 1);
-
-        std::vector<uint8_t> tabu_set;
-        for (uint8_t k = 0; k < cf_cnt; ++k) {
-          cf.sf_type.push_back(sf_type);
-          cf.s_id.push_back(s_id);
-
-          uint8_t start_time;
-          do {
-            start_time = 8 * (dis(gen) % 3);
-          } while (std::find(tabu_set.begin(), tabu_set.end(), start_time) != tabu_set.end());
-          tabu_set.push_back(start_time);
-
-          cf.start_time.push_back(start_time);
-          cf.end_time.push_back(start_time + (dis(gen) % 8) + 1);
-
-          StringStruct<15> stringstruct_15;
-          generateRandomString(stringstruct_15.string, 15, gen);
-          cf.numberx.push_back(stringstruct_15);
-
-          cf.lsn.push_back(0);
-          cf.locked.push_back(static_cast<Locking>(0));
-          cf.rw_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
-          cf.version_chain.push_back(nullptr);
-
-          cf_map->insert(cf_map->combine_key(s_id, cf_map->combine_key(start_time >> 3, sf_type - 1, 62), 60),
-                         cf.s_id.size() - 1);
-        }
-      }
-    }
-
-    std::cout << "s_map: " << s_map->size() << std::endl;
-    std::cout << "sf_map: " << sf_map->size() << std::endl;
-    std::cout << "ai_map: " << ai_map->size() << std::endl;
-    std::cout << "cf_map: " << cf_map->size() << std::endl;
+  // visits all columns and indexes, s.t. the database can be written to or restored from a snapshot and its columns
+  // can be named for the abort statistics
+  template <typename Visitor>
+  void snapshotDatabase(Visitor& snapshot) {
+    auto zero = []() { return 0; };
+    auto unlocked = []() { return static_cast<Locking>(0); };
+    auto list = [&]() { return new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp}; };
+    auto no_version = []() { return nullptr; };
+
+    snapshot.column("s.s_id", s.s_id);
+    snapshot.column("s.sub_nbr", s.sub_nbr);
+    snapshot.column("s.bit_1", s.bit_1);
+    snapshot.column("s.bit_2", s.bit_2);
+    snapshot.column("s.bit_3", s.bit_3);
+    snapshot.column("s.bit_4", s.bit_4);
+    snapshot.column("s.bit_5", s.bit_5);
+    snapshot.column("s.bit_6", s.bit_6);
+    snapshot.column("s.bit_7", s.bit_7);
+    snapshot.column("s.bit_8", s.bit_8);
+    snapshot.column("s.bit_9", s.bit_9);
+    snapshot.column("s.bit_10", s.bit_10);
+    snapshot.column("s.hex_1", s.hex_1);
+    snapshot.column("s.hex_2", s.hex_2);
+    snapshot.column("s.hex_3", s.hex_3);
+    snapshot.column("s.hex_4", s.hex_4);
+    snapshot.column("s.hex_5", s.hex_5);
+    snapshot.column("s.hex_6", s.hex_6);
+    snapshot.column("s.hex_7", s.hex_7);
+    snapshot.column("s.hex_8", s.hex_8);
+    snapshot.column("s.hex_9", s.hex_9);
+    snapshot.column("s.hex_10", s.hex_10);
+    snapshot.column("s.byte2_1", s.byte2_1);
+    snapshot.column("s.byte2_2", s.byte2_2);
+    snapshot.column("s.byte2_3", s.byte2_3);
+    snapshot.column("s.byte2_4", s.byte2_4);
+    snapshot.column("s.byte2_5", s.byte2_5);
+    snapshot.column("s.byte2_6", s.byte2_6);
+    snapshot.column("s.byte2_7", s.byte2_7);
+    snapshot.column("s.byte2_8", s.byte2_8);
+    snapshot.column("s.byte2_9", s.byte2_9);
+    snapshot.column("s.byte2_10", s.byte2_10);
+    snapshot.column("s.msc_location", s.msc_location);
+    snapshot.column("s.vlr_location", s.vlr_location);
+    snapshot.rebuild(s.lsn, s.s_id.size(), zero);
+    snapshot.rebuild(s.version_chain, s.s_id.size(), no_version);
+    snapshot.rebuild(s.locked, s.s_id.size(), unlocked);
+    snapshot.rebuild(s.rw_table, s.s_id.size(), list);
+
+    snapshot.column("ai.s_id", ai.s_id);
+    snapshot.column("ai.ai_type", ai.ai_type);
+    snapshot.column("ai.data1", ai.data1);
+    snapshot.column("ai.data2", ai.data2);
+    snapshot.column("ai.data3", ai.data3);
+    snapshot.column("ai.data4", ai.data4);
+    snapshot.rebuild(ai.lsn, ai.s_id.size(), zero);
+    snapshot.rebuild(ai.version_chain, ai.s_id.size(), no_version);
+    snapshot.rebuild(ai.locked, ai.s_id.size(), unlocked);
+    snapshot.rebuild(ai.rw_table, ai.s_id.size(), list);
+
+    snapshot.column("sf.s_id", sf.s_id);
+    snapshot.column("sf.sf_type", sf.sf_type);
+    snapshot.column("sf.is_active", sf.is_active);
+    snapshot.column("sf.error_cntrl", sf.error_cntrl);
+    snapshot.column("sf.data_a", sf.data_a);
+    snapshot.column("sf.data_b", sf.data_b);
+    snapshot.rebuild(sf.lsn, sf.s_id.size(), zero);
+    snapshot.rebuild(sf.version_chain, sf.s_id.size(), no_version);
+    snapshot.rebuild(sf.locked, sf.s_id.size(), unlocked);
+    snapshot.rebuild(sf.rw_table, sf.s_id.size(), list);
+
+    snapshot.column("cf.s_id", cf.s_id);
+    snapshot.column("cf.sf_type", cf.sf_type);
+    snapshot.column("cf.start_time", cf.start_time);
+    snapshot.column("cf.end_time", cf.end_time);
+    snapshot.column("cf.numberx", cf.numberx);
+    snapshot.rebuild(cf.lsn, cf.s_id.size(), zero);
+    snapshot.rebuild(cf.version_chain, cf.s_id.size(), no_version);
+    snapshot.rebuild(cf.locked, cf.s_id.size(), unlocked);
+    snapshot.rebuild(cf.rw_table, cf.s_id.size(), list);
+
+    snapshot.index("s_map", *s_map);
+    snapshot.index("subnbr_map", *subnbr_map);
+    snapshot.index("ai_map", *ai_map);
+    snapshot.index("sf_map", *sf_map);
+    snapshot.index("cf_map", *cf_map);
   }
 
   void waitAndTidy() { tc.waitAndTidy(); }
@@ -1064,49 +1210,56 @@ struct Database {
     uint64_t main_id = cf.s_id.push_back(s_id);
     uint64_t sub_id = cf.sf_type.push_back(sftype);
     if (main_id != sub_id) {
-      while (!cf.sf_type.isAlive(main_id)) {
+      for (common::Backoff backoff; !cf.sf_type.isAlive(main_id);) {
+        backoff.pause();
       }
       cf.sf_type.replace(main_id, sftype);
     }
 
     sub_id = cf.start_time.push_back(start_time);
     if (main_id != sub_id) {
-      while (!cf.start_time.isAlive(main_id)) {
+      for (common::Backoff backoff; !cf.start_time.isAlive(main_id);) {
+        backoff.pause();
       }
       cf.start_time.replace(main_id, start_time);
     }
 
     sub_id = cf.end_time.push_back(end_time);
     if (main_id != sub_id) {
-      while (!cf.end_time.isAlive(main_id)) {
+      for (common::Backoff backoff; !cf.end_time.isAlive(main_id);) {
+        backoff.pause();
       }
       cf.end_time.replace(main_id, end_time);
     }
 
     sub_id = cf.numberx.push_back(numberx);
     if (main_id != sub_id) {
-      while (!cf.numberx.isAlive(main_id)) {
+      for (common::Backoff backoff; !cf.numberx.isAlive(main_id);) {
+        backoff.pause();
       }
       cf.numberx.replace(main_id, numberx);
     }
 
     sub_id = cf.lsn.push_back(0);
     if (main_id != sub_id) {
-      while (!cf.lsn.isAlive(main_id)) {
+      for (common::Backoff backoff; !cf.lsn.isAlive(main_id);) {
+        backoff.pause();
       }
       cf.lsn.atomic_replace(main_id, 0);
     }
 
     sub_id = cf.version_chain.push_back(nullptr);
     if (main_id != sub_id) {
-      while (!cf.version_chain.isAlive(main_id)) {
+      for (common::Backoff backoff; !cf.version_chain.isAlive(main_id);) {
+        backoff.pause();
       }
       cf.version_chain.atomic_replace(main_id, nullptr);
     }
 
     sub_id = cf.locked.push_back(static_cast<Locking>(0));
     if (main_id != sub_id) {
-      while (!cf.locked.isAlive(main_id)) {
+      for (common::Backoff backoff; !cf.locked.isAlive(main_id);) {
+        backoff.pause();
       }
       cf.locked.atomic_replace(main_id, static_cast<Locking>(0));
     }
@@ -1114,7 +1267,8 @@ struct Database {
     auto ptr = new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp};
     sub_id = cf.rw_table.push_back(ptr);
     if (main_id != sub_id) {
-      while (!cf.rw_table.isAlive(main_id)) {
+      for (common::Backoff backoff; !cf.rw_table.isAlive(main_id);) {
+        backoff.pause();
       }
       cf.rw_table.atomic_replace(main_id, ptr);
     }
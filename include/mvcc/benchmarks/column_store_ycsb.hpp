@@ -21,14 +21,25 @@
 //
 
 #pragma once
+#include "common/acknowledged_counter.hpp"
+#include "common/backoff.hpp"
 #include "common/details_collector.hpp"
+#include "common/executor.hpp"
 #include "common/optimistic_predicate_locking.hpp"
+#include "common/parallel_loader.hpp"
+#include "common/placement.hpp"
+#include "common/random.hpp"
+#include "common/snapshot.hpp"
+#include "common/trace.hpp"
+#include "common/zipf.hpp"
 #include "ds/atomic_extent_vector.hpp"
 #include "ds/atomic_singly_linked_list.hpp"
 #include "ds/atomic_unordered_map.hpp"
 #include "ds/extent_vector.hpp"
 #include "mvcc/benchmarks/read_guard.hpp"
 #include "mvcc/benchmarks/write_guard.hpp"
+#include <algorithm>
+#include <cctype>
 #include <iomanip>
 #include <memory>
 #include <random>
@@ -39,7 +50,46 @@
 
 namespace mv {
 namespace ycsb {
-enum Action { READ, WRITE, SCAN };
+// SCAN reads scanLength * population rows as OLAP transaction, RANGE is the short scan of YCSB E
+enum Action { READ, WRITE, SCAN, INSERT, READ_MODIFY_WRITE, RANGE };
+
+/*
+ * A YCSB core workload: the shares of the operations and whether the keys follow the latest distribution, i.e., the
+ * recently inserted keys are the most popular ones.
+ */
+struct Workload {
+  char name;
+  double read;
+  double update;
+  double insert;
+  double range;
+  double read_modify_write;
+  bool latest;
+};
+
+// one operation of a pre-generated transaction: key is the draw resolved by keyOf, value the letters of fillFields
+struct TraceOp {
+  uint64_t key;
+  uint64_t value;
+  uint32_t action;
+  uint32_t length;
+};
+
+// a transaction of the executor, it carries its latency and restart between the workers
+struct Task {
+  std::vector<uint64_t> key;
+  std::vector<Action> query;
+  std::vector<uint64_t> length;
+  std::vector<uint64_t> value;
+  uint64_t arrival = 0;
+  uint64_t aborted = 0;  // the last aborted attempt, 0 before the first one
+  bool olap = false;
+  std::unordered_set<uint64_t> conflicts;
+};
+
+constexpr Workload workloads[] = {{'a', 0.5, 0.5, 0, 0, 0, false},  {'b', 0.95, 0.05, 0, 0, 0, false},
+                                  {'c', 1, 0, 0, 0, 0, false},      {'d', 0.95, 0, 0.05, 0, 0, true},
+                                  {'e', 0, 0, 0.05, 0.95, 0, false}, {'f', 0.5, 0, 0, 0, 0.5, false}};
 
 template <unsigned int t>
 struct alignas(8) StringStruct {
@@ -144,9 +194,18 @@ struct Database {
   double writePercentage = 0.5;
   double scanPercentage = 0;
   double scanLength = 0.01;
+  double insertPercentage = 0;
+  double rangePercentage = 0;
+  double readModifyWritePercentage = 0;
+  uint64_t maxRangeLength = 100;
+  // the number of fields an update writes, from f01 on
+  uint64_t updateFields = 1;
+  bool latestDistribution = false;
   double theta = 0.9;
-  double zeta_2_theta;
-  double denom;
+  bool scrambled = false;
+  common::Zipf zipf_;
+  common::Trace<TraceOp> trace_;
+  common::Executor<Task> executor_;
   uint64_t population;
 
   std::unique_ptr<atom::AtomicUnorderedMap<uint64_t,
@@ -155,6 +214,19 @@ struct Database {
                                            common::ChunkAllocator>>
       key_map;
 
+  static constexpr uint64_t fields = 10;
+  static constexpr StringStruct<100> VersionUsertable::*row_fields[fields] = {
+      &VersionUsertable::f01, &VersionUsertable::f02, &VersionUsertable::f03, &VersionUsertable::f04,
+      &VersionUsertable::f05, &VersionUsertable::f06, &VersionUsertable::f07, &VersionUsertable::f08,
+      &VersionUsertable::f09, &VersionUsertable::f10};
+  static constexpr atom::ExtentVector<StringStruct<100>> Usertable<Locking>::*columns[fields] = {
+      &Usertable<Locking>::f01, &Usertable<Locking>::f02, &Usertable<Locking>::f03, &Usertable<Locking>::f04,
+      &Usertable<Locking>::f05, &Usertable<Locking>::f06, &Usertable<Locking>::f07, &Usertable<Locking>::f08,
+      &Usertable<Locking>::f09, &Usertable<Locking>::f10};
+
+  // the keys of inserts and the prefix of committed ones
+  common::AcknowledgedCounter keys_;
+
  public:
   Database(uint64_t qyPerTx, double readPct, double scanPct, double theta, bool online = false)
       : tc(&ca, &emp, online),
@@ -164,59 +236,276 @@ struct Database {
         readPercentage(readPct),
         writePercentage(1.0 - readPct),
         scanPercentage(scanPct),
-        theta(theta) {
-    zeta_2_theta = 0;
-    for (uint64_t i = 1; i <= 2; i++)
-      zeta_2_theta += pow(1.0 / i, theta);
-  }
-
-  double zeta() {
-    double sum = 0;
-    for (uint64_t i = 1; i <= population; i++)
-      sum += pow(1.0 / i, theta);
-    return sum;
-  }
-
-  uint64_t zipf(std::mt19937& gen) {
-    uint64_t population = this->population - 1;
-    double alpha = 1 / (1 - theta);
-    double zetan = denom;
-    double eta = (1 - pow(2.0 / population, 1 - theta)) / (1 - zeta_2_theta / zetan);
-    std::uniform_real_distribution<double> dis(0, 1);
-    double u = dis(gen);
-    double uz = u * zetan;
-    if (uz < 1)
-      return 1;
-    if (uz < 1 + pow(0.5, theta))
-      return 2;
-    return 1 + (uint64_t)(population * pow(eta * u - eta + 1, alpha));
+        theta(theta) {}
+
+  // changes the skew of the key distribution, e.g., between runs on the populated database
+  void setTheta(double theta) {
+    this->theta = theta;
+    zipf_.configure(population, theta, scrambled);
   }
 
-  void generateRandomString(char* v, uint8_t length, std::mt19937& gen) {
-    std::uniform_int_distribution<unsigned int> dis(0, 26);
-    uint64_t pseudo = dis(gen);
+  // spreads the hot keys over the table instead of keeping them at the smallest keys, set before the population
+  void setScrambled(bool scrambled) { this->scrambled = scrambled; }
+
+  template <typename Random>
+  uint64_t zipf(Random& gen) {
+    return zipf_(gen);
+  }
+
+  // switches to the YCSB core workload a to f, the operations per transaction and the skew are kept
+  bool setWorkload(char name) {
+    for (auto& workload : workloads) {
+      if (workload.name == std::tolower(name)) {
+        readPercentage = workload.read;
+        writePercentage = workload.update;
+        insertPercentage = workload.insert;
+        rangePercentage = workload.range;
+        readModifyWritePercentage = workload.read_modify_write;
+        scanPercentage = 0;
+        latestDistribution = workload.latest;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // updates write the first count fields, all fields (10) is a full row update
+  bool setUpdateFields(uint64_t count) {
+    if (count == 0 || count > fields)
+      return false;
+    updateFields = count;
+    return true;
+  }
+
+  // the latest distribution draws the zipfian rank, which keyOf counts back from the latest key; it is never scrambled
+  template <typename Random>
+  uint64_t nextKey(Random& gen) {
+    return latestDistribution ? zipf_.rank(gen) : zipf(gen);
+  }
+
+  // the key of a drawn operation when its transaction starts: inserts take the next free key and the latest
+  // distribution counts back from the last key of the committed prefix, i.e., it never draws a key still in flight
+  uint64_t keyOf(Action action, uint64_t draw) {
+    if (action == Action::INSERT)
+      return keys_.next();
+    if (latestDistribution && action != Action::SCAN)
+      return keys_.last() + 1 - draw;
+    return draw;
+  }
+
+  void fillString(char* v, uint8_t length, uint64_t pseudo) {
     for (uint8_t i = 0; i < length; ++i) {
       v[i] = 65 + ((pseudo + i) % 26);
     }
   }
 
-  void generateTransaction(std::vector<uint64_t>& key, std::vector<Action>& query, std::mt19937& gen) {
-    std::uniform_real_distribution<double> dis(0, 1);
-    double isScan = dis(gen);
+  template <typename Random>
+  void generateRandomString(char* v, uint8_t length, Random& gen) {
+    std::uniform_int_distribution<unsigned int> dis(0, 26);
+    fillString(v, length, dis(gen));
+  }
+
+  // the values written to count fields in one word, 5 bits per field
+  template <typename Random>
+  uint64_t generateLetters(uint64_t count, Random& gen) {
+    std::uniform_int_distribution<unsigned int> dis(0, 26);
+    uint64_t letters = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+      letters |= uint64_t{dis(gen)} << (5 * i);
+    }
+    return letters;
+  }
+
+  // writes the first count fields, all fields for an insert and updateFields for an update
+  void fillFields(VersionUsertable& row, uint64_t letters, uint64_t count) {
+    for (uint64_t i = 0; i < count; ++i) {
+      fillString((row.*row_fields[i]).string, 100, (letters >> (5 * i)) & 31);
+    }
+  }
+
+  // draws the operations of a transaction, length holds the number of keys of a RANGE and value the letters of a
+  // write, both are 0 for the other actions; the keys are draws, see keyOf
+  template <typename Random>
+  void generateOperations(std::vector<uint64_t>& key,
+                          std::vector<Action>& query,
+                          std::vector<uint64_t>& length,
+                          std::vector<uint64_t>& value,
+                          Random& gen) {
+    double isScan = common::canonical(gen);
     if (isScan < scanPercentage) {
       key.push_back(zipf(gen));
       query.push_back(Action::SCAN);
+      length.push_back(0);
+      value.push_back(0);
       return;
     }
     for (auto i = 0u; i < queriesPerTransaction; i++) {
-      double isRead = dis(gen);
-      if (isRead < readPercentage) {
-        key.push_back(zipf(gen));
-        query.push_back(Action::READ);
-      } else if (isRead < writePercentage + readPercentage) {
-        key.push_back(zipf(gen));
-        query.push_back(Action::WRITE);
+      double isRead = common::canonical(gen);
+      double share = readPercentage;
+      Action action;
+      if (isRead < share) {
+        action = Action::READ;
+      } else if (isRead < (share += writePercentage)) {
+        action = Action::WRITE;
+      } else if (isRead < (share += insertPercentage)) {
+        action = Action::INSERT;
+      } else if (isRead < (share += rangePercentage)) {
+        action = Action::RANGE;
+      } else if (isRead < (share += readModifyWritePercentage)) {
+        action = Action::READ_MODIFY_WRITE;
+      } else {
+        continue;
       }
+      query.push_back(action);
+      key.push_back(action == Action::INSERT ? 0 : nextKey(gen));
+      length.push_back(action == Action::RANGE ? std::uniform_int_distribution<uint64_t>(1, maxRangeLength)(gen) : 0);
+      if (action == Action::INSERT) {
+        value.push_back(generateLetters(fields, gen));
+      } else if (action == Action::WRITE || action == Action::READ_MODIFY_WRITE) {
+        value.push_back(generateLetters(updateFields, gen));
+      } else {
+        value.push_back(0);
+      }
+    }
+  }
+
+  template <typename Random>
+  void generateTransaction(std::vector<uint64_t>& key,
+                           std::vector<Action>& query,
+                           std::vector<uint64_t>& length,
+                           std::vector<uint64_t>& value,
+                           Random& gen) {
+    generateOperations(key, query, length, value, gen);
+    for (auto j = 0u; j < key.size(); ++j) {
+      key[j] = keyOf(query[j], key[j]);
+    }
+  }
+
+  common::Trace<TraceOp>& trace() { return trace_; }
+
+  common::Executor<Task>& executor() { return executor_; }
+
+  // pre-generates transactions per worker with the current workload, skew and update width
+  void generateTrace(uint64_t workers, uint64_t transactions, uint64_t seed) {
+    trace_.generate(workers, transactions, seed, [this](std::mt19937& gen, std::vector<TraceOp>& ops) {
+      std::vector<uint64_t> key, length, value;
+      std::vector<Action> query;
+      generateOperations(key, query, length, value, gen);
+      for (auto j = 0u; j < key.size(); ++j) {
+        ops.push_back(TraceOp{key[j], value[j], static_cast<uint32_t>(query[j]), static_cast<uint32_t>(length[j])});
+      }
+    });
+  }
+
+  // the next transaction of a worker's trace, instead of generateTransaction
+  void replayTransaction(common::Trace<TraceOp>::Cursor& cursor,
+                         std::vector<uint64_t>& key,
+                         std::vector<Action>& query,
+                         std::vector<uint64_t>& length,
+                         std::vector<uint64_t>& value) {
+    auto ops = cursor.next();
+    for (auto op = ops.first; op != ops.second; ++op) {
+      query.push_back(static_cast<Action>(op->action));
+      key.push_back(keyOf(query.back(), op->key));
+      length.push_back(op->length);
+      value.push_back(op->value);
+    }
+  }
+
+  // runs the operations of a transaction, 1 if all of them succeeded, 0 if a key was not found, else it has to abort
+  template <bool OLAPScan>
+  int execute(uint64_t transaction,
+              const std::vector<uint64_t>& key,
+              const std::vector<Action>& query,
+              const std::vector<uint64_t>& length,
+              const std::vector<uint64_t>& value,
+              VersionUsertable& us,
+              std::vector<VersionUsertable>& usv,
+              bool& olap) {
+    int res = 0;
+    for (auto j = 0u; j < key.size(); ++j) {
+      if (query[j] == Action::READ) {
+        res = readData(transaction, key[j], us);
+      } else if (query[j] == Action::WRITE) {
+        fillFields(us, value[j], updateFields);
+        res = writeData(transaction, key[j], us);
+      } else if (query[j] == Action::SCAN) {
+        if (OLAPScan)
+          olap = true;
+        res = scanData<OLAPScan>(transaction, key[j], population * scanLength, usv);
+      } else if (query[j] == Action::INSERT) {
+        fillFields(us, value[j], fields);
+        us.key = key[j];
+        res = insertData(transaction, key[j], us);
+      } else if (query[j] == Action::READ_MODIFY_WRITE) {
+        res = readData(transaction, key[j], us);
+        if (res == 1) {
+          fillFields(us, value[j], updateFields);
+          res = writeData(transaction, key[j], us);
+        }
+      } else if (query[j] == Action::RANGE) {
+        res = rangeData(transaction, key[j], length[j], us);
+      }
+
+      if (res != 1)
+        break;
+    }
+    return res;
+  }
+
+  // one attempt of an executor task, false if it aborted and has to be restarted
+  template <bool OLAPScan>
+  bool attempt(Task& task, common::DetailCollector& dc, VersionUsertable& us, std::vector<VersionUsertable>& usv) {
+    dc.resumeLatency(task.arrival);
+    if (task.aborted != 0) {
+      dc.startWaitManager();
+      wm_.wait(task.aborted, task.conflicts);
+      dc.stopWaitManager(task.olap);
+    }
+    auto transaction = tc.start();
+    bot(transaction);
+    dc.startTX();
+    bool olap = false;
+    int res = execute<OLAPScan>(transaction, task.key, task.query, task.length, task.value, us, usv, olap);
+
+    if (task.aborted != 0) {
+      wm_.release(task.aborted, task.conflicts);
+    }
+
+    if (res == 0) {
+      dc.notFound(olap);
+      abort(transaction);
+      dc.startCommit();
+      commit(transaction, task.conflicts);
+      dc.stopCommit(olap);
+      finishInserts(task.key, task.query, false);
+    } else {
+      dc.startCommit();
+      bool comres = commit(transaction, task.conflicts);
+      dc.stopCommit(olap);
+      if (!comres || res != 1) {
+        dc.abort(olap);
+        task.aborted = transaction;
+        task.olap = olap;
+        return false;
+      }
+      dc.commit(olap);
+      finishInserts(task.key, task.query);
+    }
+    dc.stopLatency(dc.stopTX(olap), olap);
+    return true;
+  }
+
+  // publishes the keys inserted by a committed transaction to the latest distribution and to ranges, the keys of a
+  // rolled back transaction are handed out again
+  void finishInserts(const std::vector<uint64_t>& key, const std::vector<Action>& query, bool committed = true) {
+    for (auto j = 0u; j < key.size(); ++j) {
+      if (query[j] != Action::INSERT)
+        continue;
+      if (committed)
+        keys_.acknowledge(key[j]);
+      else
+        keys_.release(key[j]);
     }
   }
 
@@ -233,18 +522,16 @@ struct Database {
     }
   }
 
-  static void client(Database<TC, WM, Locking>& db, uint32_t population, int max_transactions, uint8_t core_id) {
+  static void client(Database<TC, WM, Locking>& db, uint32_t population, int max_transactions, uint16_t core_id) {
     clientMulti<true>(db, population, max_transactions, core_id);
   }
 
   template <bool OLAPScan>
-  static void clientMulti(Database<TC, WM, Locking>& db, uint32_t population, int max_transactions, uint8_t core_id) {
+  static void clientMulti(Database<TC, WM, Locking>& db, uint32_t population, int max_transactions, uint16_t core_id) {
     std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
+    common::Random gen{(uint64_t{rd()} << 32) | rd()};
     // uint64_t transactions[10];
-    while ((core_id % std::thread::hardware_concurrency()) != (unsigned)sched_getcpu()) {
-    }
+    common::Placement::wait(core_id);
 
     db.active_thr_++;
 
@@ -253,41 +540,34 @@ struct Database {
 
     std::vector<uint64_t> randomKey;
     std::vector<Action> randomAction;
+    std::vector<uint64_t> randomLength;
+    std::vector<uint64_t> randomValue;
+    auto trace = db.trace_.cursor(core_id);
+    bool replay = !db.trace_.empty();
 
     VersionUsertable us{};
     std::vector<VersionUsertable> usv;
     usv.reserve(db.scanLength * db.population);
 
-    for (int i = 0; i < max_transactions; ++i) {
+    for (int i = 0; common::RunControl::proceed(i, max_transactions); ++i) {
       randomKey.clear();
       randomAction.clear();
+      randomLength.clear();
+      randomValue.clear();
       bool restart = false;
       uint64_t transaction = 0, old_transaction = 0;
       std::unordered_set<uint64_t> aborted_transaction;
       dc.startLatency();
-      db.generateTransaction(randomKey, randomAction, gen);
+      if (replay)
+        db.replayTransaction(trace, randomKey, randomAction, randomLength, randomValue);
+      else
+        db.generateTransaction(randomKey, randomAction, randomLength, randomValue, gen);
     restart:
       transaction = db.tc.start();
       db.bot(transaction);
-      int res = 0;
       dc.startTX();
       bool olap = false;
-
-      for (auto j = 0u; j < randomKey.size(); ++j) {
-        if (randomAction[j] == Action::READ) {
-          res = db.readData(transaction, randomKey[j], us);
-        } else if (randomAction[j] == Action::WRITE) {
-          db.generateRandomString(us.f01.string, 100, gen);
-          res = db.writeData(transaction, randomKey[j], us);
-        } else if (randomAction[j] == Action::SCAN) {
-          if (OLAPScan)
-            olap = true;
-          res = db.scanData<OLAPScan>(transaction, randomKey[j], db.population * db.scanLength, usv);
-        }
-
-        if (res != 1)
-          break;
-      }
+      int res = db.execute<OLAPScan>(transaction, randomKey, randomAction, randomLength, randomValue, us, usv, olap);
 
       if (restart != 0) {
         restart = false;
@@ -300,12 +580,14 @@ struct Database {
         dc.startCommit();
         db.commit(transaction, aborted_transaction);
         dc.stopCommit(olap);
+        db.finishInserts(randomKey, randomAction, false);
       } else {
         dc.startCommit();
         bool comres = db.commit(transaction, aborted_transaction);
         dc.stopCommit(olap);
         if (comres && res == 1) {
           dc.commit(olap);
+          db.finishInserts(randomKey, randomAction);
         } else {
           dc.abort(olap);
           restart = true;
@@ -328,6 +610,73 @@ struct Database {
     db.emp.remove();
   }
 
+  // submits the transactions of the worker as tasks to the executor and runs, steals and restarts tasks, see
+  // common::Executor; open-loop workers submit one arrival at a time
+  template <bool OLAPScan>
+  static void clientTasks(Database<TC, WM, Locking>& db, uint32_t population, int max_transactions, uint16_t core_id) {
+    std::random_device rd;
+    common::Random gen{(uint64_t{rd()} << 32) | rd()};
+    common::Placement::wait(core_id);
+
+    db.active_thr_++;
+
+    common::DetailCollector dc;
+    dc.startWorker();
+
+    auto trace = db.trace_.cursor(core_id);
+    bool replay = !db.trace_.empty();
+
+    VersionUsertable us{};
+    std::vector<VersionUsertable> usv;
+    usv.reserve(db.scanLength * db.population);
+
+    auto& executor = db.executor_;
+    uint64_t window = common::Arrivals::rate() > 0 ? 1 : common::Executor<Task>::window;
+    bool submitting = true;
+    Task task, next;
+    for (int i = 0;;) {
+      while (submitting && executor.queued(core_id) < window) {
+        submitting = common::RunControl::proceed(i, max_transactions);
+        if (!submitting)
+          break;
+        ++i;
+        // reuses the vectors of the last finished task
+        next.key.clear();
+        next.query.clear();
+        next.length.clear();
+        next.value.clear();
+        next.conflicts.clear();
+        next.aborted = 0;
+        dc.startLatency();
+        next.arrival = dc.latencyStart();
+        if (replay)
+          db.replayTransaction(trace, next.key, next.query, next.length, next.value);
+        else
+          db.generateTransaction(next.key, next.query, next.length, next.value, gen);
+        executor.submit(core_id, std::move(next));
+      }
+
+      if (!executor.take(core_id, task)) {
+        if (!submitting)
+          break;
+        continue;
+      }
+      if (db.attempt<OLAPScan>(task, dc, us, usv)) {
+        next = std::move(task);
+      } else {
+        executor.defer(core_id, std::move(task));
+      }
+    }
+    db.active_thr_--;
+    dc.stopWorker();
+
+    db.mut.lock();
+    db.global_details_collector.merge(dc);
+    db.mut.unlock();
+
+    db.emp.remove();
+  }
+
   void bot(uint64_t transaction) { tc.bot(transaction); }
   void abort(uint64_t transaction) { tc.abort(transaction); }
 
@@ -337,12 +686,59 @@ struct Database {
     return commit;
   }
 
-  void populateDatabase(uint64_t population) {
-    std::random_device rd;
-    std::mt19937 random_gen(rd());
+  uint64_t populateDatabase(uint64_t population, uint64_t seed = common::ParallelLoader::default_seed) {
+    common::ParallelLoader loader{seed};
+
+    reserveSlots(population);
+
+    loader.run(0, common::ParallelLoader::partitions(population), [&](uint64_t partition, std::mt19937& random_gen) {
+      auto end = common::ParallelLoader::partitionEnd(partition, population);
+      for (uint64_t id = common::ParallelLoader::partitionBegin(partition); id < end; ++id) {
+        uint64_t i = id + 1;
+        key_map->insert(i, id);
+
+        usertable.key.store(id, i);
+        StringStruct<100> stringstruct_100;
+        generateRandomString(stringstruct_100.string, 100, random_gen);
+        usertable.f01.store(id, stringstruct_100);
+        generateRandomString(stringstruct_100.string, 100, random_gen);
+        usertable.f02.store(id, stringstruct_100);
+        generateRandomString(stringstruct_100.string, 100, random_gen);
+        usertable.f03.store(id, stringstruct_100);
+        generateRandomString(stringstruct_100.string, 100, random_gen);
+        usertable.f04.store(id, stringstruct_100);
+        generateRandomString(stringstruct_100.string, 100, random_gen);
+        usertable.f05.store(id, stringstruct_100);
+        generateRandomString(stringstruct_100.string, 100, random_gen);
+        usertable.f06.store(id, stringstruct_100);
+        generateRandomString(stringstruct_100.string, 100, random_gen);
+        usertable.f07.store(id, stringstruct_100);
+        generateRandomString(stringstruct_100.string, 100, random_gen);
+        usertable.f08.store(id, stringstruct_100);
+        generateRandomString(stringstruct_100.string, 100, random_gen);
+        usertable.f09.store(id, stringstruct_100);
+        generateRandomString(stringstruct_100.string, 100, random_gen);
+        usertable.f10.store(id, stringstruct_100);
+        usertable.lsn.store(id, 0);
+        usertable.locked.store(id, static_cast<Locking>(0));
+        usertable.version_chain.store(id, nullptr);
+        usertable.rw_table.store(id, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+      }
+      return end - common::ParallelLoader::partitionBegin(partition);
+    });
+    return loader.rows();
+  }
 
+  uint64_t restoreDatabase(uint64_t population, common::Snapshot& snapshot) {
+    reserveSlots(population);
+    snapshotDatabase(snapshot);
+    return snapshot.rows();
+  }
+
+  void reserveSlots(uint64_t population) {
     this->population = population;
-    denom = zeta();
+    zipf_.configure(population, theta, scrambled);
+    keys_.reset(population);
 
     usertable.key.reserve(population);
     usertable.f01.reserve(population);
@@ -363,40 +759,37 @@ struct Database {
     key_map = std::make_unique<atom::AtomicUnorderedMap<
         uint64_t, uint64_t, atom::AtomicUnorderedMapBucket<uint64_t, uint64_t>, common::ChunkAllocator>>(
         population << 4, &ca, &emp);
-
-    for (uint64_t i = 1; i <= population; ++i) {
-      key_map->insert(i, usertable.key.size());
-
-      usertable.key.push_back(i);
-      StringStruct<100> stringstruct_100;
-      generateRandomString(stringstruct_100.string, 100, random_gen);
-      usertable.f01.push_back(stringstruct_100);
-      generateRandomString(stringstruct_100.string, 100, random_gen);
-      usertable.f02.push_back(stringstruct_100);
-      generateRandomString(stringstruct_100.string, 100, random_gen);
-      usertable.f03.push_back(stringstruct_100);
-      generateRandomString(stringstruct_100.string, 100, random_gen);
-      usertable.f04.push_back(stringstruct_100);
-      generateRandomString(stringstruct_100.string, 100, random_gen);
-      usertable.f05.push_back(stringstruct_100);
-      generateRandomString(stringstruct_100.string, 100, random_gen);
-      usertable.f06.push_back(stringstruct_100);
-      generateRandomString(stringstruct_100.string, 100, random_gen);
-      usertable.f07.push_back(stringstruct_100);
-      generateRandomString(stringstruct_100.string, 100, random_gen);
-      usertable.f08.push_back(stringstruct_100);
-      generateRandomString(stringstruct_100.string, 100, random_gen);
-      usertable.f09.push_back(stringstruct_100);
-      generateRandomString(stringstruct_100.string, 100, random_gen);
-      usertable.f10.push_back(stringstruct_100);
-      usertable.lsn.push_back(0);
-      usertable.locked.push_back(static_cast<Locking>(0));
-      usertable.version_chain.push_back(nullptr);
-      usertable.rw_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
-    }
     usertable.opl = new common::OptimisticPredicateLocking<common::ChunkAllocator>{&ca, &emp};
   }
 
+  // visits all columns and indexes, s.t. the database can be written to or restored from a snapshot and its columns
+  // can be named for the abort statistics
+  template <typename Visitor>
+  void snapshotDatabase(Visitor& snapshot) {
+    auto zero = []() { return 0; };
+    auto unlocked = []() { return static_cast<Locking>(0); };
+    auto list = [&]() { return new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp}; };
+    auto no_version = []() { return nullptr; };
+
+    snapshot.column("usertable.key", usertable.key);
+    snapshot.column("usertable.f01", usertable.f01);
+    snapshot.column("usertable.f02", usertable.f02);
+    snapshot.column("usertable.f03", usertable.f03);
+    snapshot.column("usertable.f04", usertable.f04);
+    snapshot.column("usertable.f05", usertable.f05);
+    snapshot.column("usertable.f06", usertable.f06);
+    snapshot.column("usertable.f07", usertable.f07);
+    snapshot.column("usertable.f08", usertable.f08);
+    snapshot.column("usertable.f09", usertable.f09);
+    snapshot.column("usertable.f10", usertable.f10);
+    snapshot.rebuild(usertable.lsn, usertable.key.size(), zero);
+    snapshot.rebuild(usertable.version_chain, usertable.key.size(), no_version);
+    snapshot.rebuild(usertable.locked, usertable.key.size(), unlocked);
+    snapshot.rebuild(usertable.rw_table, usertable.key.size(), list);
+
+    snapshot.index("key_map", *key_map);
+  }
+
   template <bool OLAPScan>
   int scanData(uint64_t transaction, uint64_t startKey, uint64_t length, std::vector<VersionUsertable>& result) {
     if (startKey + length >= population)
@@ -430,6 +823,16 @@ struct Database {
     return 1;
   }
 
+  // reads the rows from startKey on, a range ends at the last key of the committed prefix
+  int rangeData(uint64_t transaction, uint64_t startKey, uint64_t length, VersionUsertable& result) {
+    uint64_t end = std::min(startKey + length, keys_.last() + 1);
+    for (uint64_t key = startKey; key < end; ++key) {
+      if (readData(transaction, key, result) == -1)
+        return -1;
+    }
+    return 1;
+  }
+
   int readData(uint64_t transaction, uint64_t key, VersionUsertable& result) {
     uint64_t offset = 0;
     bool found =
@@ -479,17 +882,88 @@ struct Database {
       if (!wg.wasSuccessful()) {
         return -1;
       }
-      wg.write(val.f01, usertable.f01);
-      /*wg.write(val.f02, usertable.f02);
-      wg.write(val.f03, usertable.f03);
-      wg.write(val.f04, usertable.f04);
-      wg.write(val.f05, usertable.f05);
-      wg.write(val.f06, usertable.f06);
-      wg.write(val.f07, usertable.f07);
-      wg.write(val.f08, usertable.f08);
-      wg.write(val.f09, usertable.f09);
-      wg.write(val.f10, usertable.f10);*/
+      // the version is a copy of the full row, independent of the fields written
+      for (uint64_t i = 0; i < updateFields; ++i) {
+        wg.write(val.*row_fields[i], usertable.*columns[i]);
+      }
+    }
+    return 1;
+  }
+
+  // appends a row holding val, concurrent appends may claim the slots of the columns in a different order
+  uint64_t appendRow(VersionUsertable& val) {
+    uint64_t offset = usertable.key.push_back(val.key);
+    auto append = [offset](auto& column, auto value) {
+      if (column.push_back(value) != offset) {
+        for (common::Backoff backoff; !column.isAlive(offset);) {
+          backoff.pause();
+        }
+        column.replace(offset, value);
+      }
+    };
+    auto appendAtomic = [offset](auto& column, auto value) {
+      if (column.push_back(value) != offset) {
+        for (common::Backoff backoff; !column.isAlive(offset);) {
+          backoff.pause();
+        }
+        column.atomic_replace(offset, value);
+      }
+    };
+    append(usertable.f01, val.f01);
+    append(usertable.f02, val.f02);
+    append(usertable.f03, val.f03);
+    append(usertable.f04, val.f04);
+    append(usertable.f05, val.f05);
+    append(usertable.f06, val.f06);
+    append(usertable.f07, val.f07);
+    append(usertable.f08, val.f08);
+    append(usertable.f09, val.f09);
+    append(usertable.f10, val.f10);
+    appendAtomic(usertable.lsn, uint64_t{0});
+    appendAtomic(usertable.locked, static_cast<Locking>(0));
+    appendAtomic(usertable.version_chain, static_cast<VersionUsertable*>(nullptr));
+    appendAtomic(usertable.rw_table, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+    return offset;
+  }
+
+  // inserts the row of a new key, a restarted insert finds the row of its aborted attempt in the index and writes it
+  // again; the key is only read by others once the insert committed, see finishInserts
+  int insertData(uint64_t transaction, uint64_t key, VersionUsertable& val) {
+    uint64_t offset = 0;
+    bool found =
+        usertable.opl->lookup(key, offset, *key_map, [](auto& index, auto& o, auto& s) { return index.lookup(s, o); });
+
+    if (!found) {
+      offset = appendRow(val);
+      bool inserted = usertable.opl->insert(key, offset, *key_map,
+                                            [](auto& index, auto& o, auto& s) { return index.insert(s, o); });
+      if (!inserted)
+        return -1;
+    }
+
+    auto cow = [&](VersionUsertable* vu, uint64_t offset) { Usertable<Locking>::copyOnWrite(usertable, offset, vu); };
+    auto coa = [&](VersionUsertable* vu, uint64_t offset) {
+      Usertable<Locking>::copyBackOnAbort(usertable, offset, vu);
+    };
+
+    mv::WriteGuard<TC, VersionUsertable, Locking, decltype(cow), decltype(coa), atom::AtomicExtentVector,
+                   atom::AtomicSinglyLinkedList<uint64_t>>
+        wg{&tc, usertable.version_chain, usertable.rw_table, usertable.locked, usertable.lsn, cow, coa, offset,
+           transaction};
+    if (!wg.wasSuccessful()) {
+      return -1;
     }
+    wg.write(val.key, usertable.key);
+    wg.write(val.f01, usertable.f01);
+    wg.write(val.f02, usertable.f02);
+    wg.write(val.f03, usertable.f03);
+    wg.write(val.f04, usertable.f04);
+    wg.write(val.f05, usertable.f05);
+    wg.write(val.f06, usertable.f06);
+    wg.write(val.f07, usertable.f07);
+    wg.write(val.f08, usertable.f08);
+    wg.write(val.f09, usertable.f09);
+    wg.write(val.f10, usertable.f10);
     return 1;
   }
 
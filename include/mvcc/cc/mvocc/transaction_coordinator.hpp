@@ -21,6 +21,8 @@
 //
 
 #pragma once
+#include "common/abort_reason.hpp"
+#include "common/backoff.hpp"
 #include "common/chunk_allocator.hpp"
 #include "common/epoch_manager.hpp"
 #include "ds/atomic_singly_linked_list.hpp"
@@ -213,6 +215,7 @@ class TransactionCoordinator {
     if (lsn[offset] == std::numeric_limits<uint64_t>::max()) {
       if (!already_writing) {
         untagPtr(version_chain, offset);
+        common::AbortReasons::set(common::AbortReason::WriteConflict, &rw_table);
         abort(transaction);
         return std::numeric_limits<uint64_t>::max();
       }
@@ -463,6 +466,7 @@ class TransactionCoordinator {
   template <typename MValue>
   static inline void tagPtr(Vector<MValue*>& ptr_vec, uint64_t offset, const bool wait = false) {
     bool replace = false;
+    common::Backoff backoff;
     while (!replace) {
       auto ptr = reinterpret_cast<uintptr_t>(ptr_vec[offset]);
       if ((ptr >> 63) == 1) {
@@ -471,6 +475,7 @@ class TransactionCoordinator {
           for (volatile auto i = 0; i < waittime; i++) {
           }
         }
+        backoff.pause();
         continue;
       }
       replace = ptr_vec.compare_exchange(offset, reinterpret_cast<MValue*>(ptr),
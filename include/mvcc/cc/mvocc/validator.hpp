@@ -20,6 +20,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include "common/abort_reason.hpp"
 #include "common/global_logger.hpp"
 #include "ds/atomic_singly_linked_list.hpp"
 #include "mvcc/cc/mvocc/transaction_information.hpp"
@@ -57,6 +58,7 @@ class Validator {
         for (auto e : *(it->second)) {
           for (auto t : set_info) {
             if (!t->isWriteTransaction() && t->sameDataElem(e->column, e->offset)) {
+              common::AbortReasons::set(common::AbortReason::UndoBuffer, e->column);
               return true;
             }
           }
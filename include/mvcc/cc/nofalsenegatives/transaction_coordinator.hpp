@@ -21,6 +21,8 @@
 //
 
 #pragma once
+#include "common/abort_reason.hpp"
+#include "common/backoff.hpp"
 #include "common/chunk_allocator.hpp"
 #include "common/epoch_manager.hpp"
 #include "ds/atomic_singly_linked_list.hpp"
@@ -76,7 +78,7 @@ class TransactionCoordinator {
 
   static thread_local std::atomic<uint64_t> transaction_counter_;
   static thread_local std::unordered_set<uint64_t> not_alive_;
-  static thread_local uint8_t current_core_;
+  static thread_local uint16_t current_core_;
   static thread_local std::unordered_set<uint64_t> abort_transaction_;
   static thread_local std::list<TransactionInformationBase<ValueVector, Vector, Allocator>*>* atom_info_;
   static thread_local atom::EpochGuard<atom::EpochManagerBase<Allocator>, atom::EpochManager<Allocator>>* eg_;
@@ -127,6 +129,7 @@ class TransactionCoordinator {
       }
 
       if (sg_.needsAbort(transaction)) {
+        common::AbortReasons::set(common::AbortReason::Cascading, &rw_table);
         this->abort(transaction);
         aid = std::numeric_limits<uint64_t>::max();
         ptr = nullptr;
@@ -145,9 +148,8 @@ class TransactionCoordinator {
          * for loop is only evaluated positive iff the transaction id was set beforehand and the vector operation is
          * already finished.
          */
-        for (auto i = 0; lsn[offset] != prv; i++) {
-          if (i >= 10000)
-            std::this_thread::yield();
+        for (common::Backoff backoff; lsn[offset] != prv;) {
+          backoff.pause();
         }
       }
 
@@ -170,6 +172,7 @@ class TransactionCoordinator {
 #endif
 
       if (cyclic) {
+        common::AbortReasons::set(common::AbortReason::ReadCycle, &rw_table);
         rw->erase(prv);
         lsn.atomic_replace(offset, prv + 1);
         this->abort(transaction);
@@ -270,6 +273,7 @@ class TransactionCoordinator {
     }
 
     if (sg_.needsAbort(transaction)) {
+      common::AbortReasons::set(common::AbortReason::Cascading, &rw_table);
       this->abort(transaction);
       return std::numeric_limits<uint64_t>::max();
     }
@@ -286,9 +290,8 @@ class TransactionCoordinator {
        * for loop is only evaluated positive iff the transaction id was set beforehand and the vector operation is
        * already finished.
        */
-      for (auto i = 0; lsn[offset] != prv; i++) {
-        if (i >= 10000)
-          std::this_thread::yield();
+      for (common::Backoff backoff; lsn[offset] != prv;) {
+        backoff.pause();
       }
     }
 
@@ -320,6 +323,7 @@ class TransactionCoordinator {
 
     if (cyclic) {
     cyclic_write:
+      common::AbortReasons::set(common::AbortReason::WriteCycle, &rw_table);
       rw->erase(prv);
       lsn.atomic_replace(offset, prv + 1);
       this->abort(transaction);
@@ -490,6 +494,7 @@ class TransactionCoordinator {
      * Otherwise, wait and yield for the other transactions having committed or aborted.
      */
 
+    common::Backoff backoff;
     bool all_pending_transactions_commited = false;
     while (!all_pending_transactions_commited) {
       auto not_alive = not_alive_.find(transaction);
@@ -500,6 +505,7 @@ class TransactionCoordinator {
       }
 
       if (sg_.needsAbort(transaction)) {
+        common::AbortReasons::set(common::AbortReason::Cascading);
         this->abort(transaction);
         not_alive_.erase(transaction);
         abort_transaction = abort_transaction_;
@@ -517,6 +523,8 @@ class TransactionCoordinator {
           t->deleteEntry();
           t->deallocate(alloc_);
         }
+      } else {
+        backoff.pause();
       }
     }
 
@@ -539,12 +547,12 @@ class TransactionCoordinator {
 
   inline uint64_t start() {
     auto tc = transaction_counter_.fetch_add(1) + 1;
-    if (current_core_ == std::numeric_limits<uint8_t>::max()) {
+    if (current_core_ == std::numeric_limits<uint16_t>::max()) {
       current_core_ = sched_getcpu();
     }
     uint64_t core = current_core_;
-    tc &= 0x00FFFFFFFFFFFFFF;
-    tc |= (core << 56);
+    tc &= 0x000FFFFFFFFFFFFF;
+    tc |= (core << 52);
 
     if (atom_info_ == nullptr) {
       atom_info_ = new std::list<TransactionInformationBase<ValueVector, Vector, Allocator>*>();
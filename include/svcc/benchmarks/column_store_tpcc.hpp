@@ -21,9 +21,14 @@
 //
 
 #pragma once
+#include "common/backoff.hpp"
 #include "common/details_collector.hpp"
 #include "common/epoch_manager.hpp"
+#include "common/interleave.hpp"
 #include "common/optimistic_predicate_locking.hpp"
+#include "common/parallel_loader.hpp"
+#include "common/placement.hpp"
+#include "common/snapshot.hpp"
 #include "ds/atomic_extent_vector.hpp"
 #include "ds/atomic_singly_linked_list.hpp"
 #include "ds/atomic_unordered_map.hpp"
@@ -33,6 +38,7 @@
 #include <algorithm>
 #include <random>
 #include <unordered_set>
+#include <vector>
 
 namespace sv {
 namespace tpcc {
@@ -98,6 +104,7 @@ struct District {
   atom::ExtentVector<int8_t> d_tax;   // signed num(4,4)
   atom::ExtentVector<int16_t> d_ytd;  // signed num (12,2)
   atom::ExtentVector<int64_t> d_next_o_id;
+  atom::ExtentVector<int64_t> d_next_delivery_o_id;  // the oldest undelivered new order
 
   atom::AtomicExtentVector<Locking> locked;
   atom::AtomicExtentVector<uint64_t> lsn;
@@ -119,6 +126,7 @@ struct SinglyDistrict {
   int8_t d_tax;   // signed num(4,4)
   int16_t d_ytd;  // signed num (12,2)
   int64_t d_next_o_id;
+  int64_t d_next_delivery_o_id;
 };
 
 template <typename Locking = uint64_t>
@@ -429,6 +437,33 @@ struct Database {
                                            atom::AtomicUnorderedMapBucket<uint64_t, int64_t>,
                                            common::ChunkAllocator>>
       orderline_wd_map;
+  // the latest order of each customer
+  std::unique_ptr<atom::AtomicUnorderedMap<uint64_t,
+                                           int64_t,
+                                           atom::AtomicUnorderedMapBucket<uint64_t, int64_t>,
+                                           common::ChunkAllocator>>
+      customer_order_map;
+  std::unique_ptr<atom::AtomicUnorderedMap<uint64_t,
+                                           int64_t,
+                                           atom::AtomicUnorderedMapBucket<uint64_t, int64_t>,
+                                           common::ChunkAllocator>>
+      neworder_map;
+
+  // the standard mix of 45% NewOrder, 43% Payment and 4% each of OrderStatus, Delivery and StockLevel
+  enum class Transaction : uint8_t { Payment, NewOrder, OrderStatus, Delivery, StockLevel };
+  static constexpr const char* transaction_names[] = {"Payment", "NewOrder", "OrderStatus", "Delivery", "StockLevel"};
+
+  static Transaction chooseTransaction(unsigned int percent) {
+    if (percent < 45)
+      return Transaction::NewOrder;
+    if (percent < 88)
+      return Transaction::Payment;
+    if (percent < 92)
+      return Transaction::OrderStatus;
+    if (percent < 96)
+      return Transaction::Delivery;
+    return Transaction::StockLevel;
+  }
 
   Database(uint64_t number_warehouses = 4, bool online = false)
       : tc(&ca, &emp, online),
@@ -451,7 +486,7 @@ struct Database {
     }
   }
 
-  static void client(Database<TC, WM, Locking>& db, uint32_t population, int max_transactions, uint8_t core_id) {
+  static void client(Database<TC, WM, Locking>& db, uint32_t population, int max_transactions, uint16_t core_id) {
     clientMultiRead<true>(db, population, max_transactions, core_id);
   }
 
@@ -459,14 +494,13 @@ struct Database {
   static void clientMultiRead(Database<TC, WM, Locking>& db,
                               uint32_t population,
                               int max_transactions,
-                              uint8_t core_id) {
+                              uint16_t core_id) {
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
     // uint64_t transactions[10];
 
-    while ((core_id % std::thread::hardware_concurrency()) != (unsigned)sched_getcpu()) {
-    }
+    common::Placement::wait(core_id);
 
     db.active_thr_++;
 
@@ -478,20 +512,40 @@ struct Database {
     SinglyDistrict d;
     SinglyStock s;
     SinglyItem si;
+    SinglyNewOrder no;
+    SinglyOrder o;
+    SinglyOrderLine ol;
     PaymentVar payment{};
     NewOrderVar neworder{};
+    OrderStatusVar orderstatus{};
+    DeliveryVar delivery{};
+    StockLevelVar stocklevel{};
+    std::vector<int64_t> items;
 
-    for (int i = 0; i < max_transactions; ++i) {
+    for (int i = 0; common::RunControl::proceed(i, max_transactions); ++i) {
       bool restart = false;
       uint64_t transaction = 0, old_transaction = 0;
       std::unordered_set<uint64_t> aborted_transaction;
       dc.startLatency();
-      int tx = dis(gen) % 100;
-      if (tx < 50) {
-        db.genPayment(payment, core_id, gen);
-      } else {
-        db.genNewOrder(neworder, core_id, gen);
+      auto tx = chooseTransaction(dis(gen) % 100);
+      switch (tx) {
+        case Transaction::Payment:
+          db.genPayment(payment, core_id, gen);
+          break;
+        case Transaction::NewOrder:
+          db.genNewOrder(neworder, core_id, gen);
+          break;
+        case Transaction::OrderStatus:
+          db.genOrderStatus(orderstatus, core_id, gen);
+          break;
+        case Transaction::Delivery:
+          db.genDelivery(delivery, core_id, gen);
+          break;
+        case Transaction::StockLevel:
+          db.genStockLevel(stocklevel, core_id, gen);
+          break;
       }
+      db.prefetchTransaction(tx, neworder, payment);
     restart:
       transaction = db.tc.start();
       db.bot(transaction);
@@ -499,10 +553,24 @@ struct Database {
       dc.startTX();
       bool olap = false;
 
-      if (tx < 50) {
-        res = db.execPayment<MultiReadPossible>(payment, wh, d, c, transaction, gen);
-      } else {
-        res = db.execNewOrder<MultiReadPossible>(neworder, d, c, si, s, transaction, gen);
+      auto type = static_cast<uint8_t>(tx);
+      dc.setType(common::DetailCollector::first_type + type, transaction_names[type]);
+      switch (tx) {
+        case Transaction::Payment:
+          res = db.execPayment<MultiReadPossible>(payment, wh, d, c, transaction, gen);
+          break;
+        case Transaction::NewOrder:
+          res = db.execNewOrder<MultiReadPossible>(neworder, d, c, si, s, transaction, gen);
+          break;
+        case Transaction::OrderStatus:
+          res = db.execOrderStatus<MultiReadPossible>(orderstatus, c, o, ol, transaction);
+          break;
+        case Transaction::Delivery:
+          res = db.execDelivery<MultiReadPossible>(delivery, d, no, o, ol, c, transaction);
+          break;
+        case Transaction::StockLevel:
+          res = db.execStockLevel<MultiReadPossible>(stocklevel, d, items, transaction);
+          break;
       }
 
       if (restart != 0) {
@@ -544,28 +612,206 @@ struct Database {
     db.emp.remove();
   }
 
-  void populateDatabase(uint64_t database_size) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    reserveSlots(gen);
-    loadItems(gen);
-    for (auto w = 1u; w <= number_warehouses; w++) {
-      loadWarehouse(w, gen);
-      loadStock(w, gen);
-      loadDistricts(w, gen);
-      for (uint64_t d = 1; d <= dist_per_warehouse; d++) {
-        loadCustomers(w, d, gen);
-        loadOrders(w, d, gen);
-        for (uint64_t c = 1; c <= cust_per_dist; c++) {
-          loadHistory(w, d, c, gen);
-        }
+  uint64_t populateDatabase(uint64_t database_size, uint64_t seed = common::ParallelLoader::default_seed) {
+    common::ParallelLoader loader{seed};
+    reserveSlots();
+
+    auto item_partitions = common::ParallelLoader::partitions(max_items);
+    loader.run(0, item_partitions,
+               [&](uint64_t partition, std::mt19937& gen) { return loadItems(partition, gen); });
+    loader.run(1, number_warehouses, [&](uint64_t partition, std::mt19937& gen) {
+      return loadWarehouse(partition + 1, gen) + loadDistricts(partition + 1, gen);
+    });
+    loader.run(2, number_warehouses * item_partitions, [&](uint64_t partition, std::mt19937& gen) {
+      return loadStock(partition / item_partitions + 1, partition % item_partitions, gen);
+    });
+    // the order line counts are drawn first, s.t. every district starts at a fixed offset of the order lines
+    uint64_t districts = number_warehouses * dist_per_warehouse;
+    std::vector<uint8_t> ol_cnts(districts * cust_per_dist);
+    loader.run(4, districts, [&](uint64_t partition, std::mt19937& gen) {
+      std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
+      for (uint64_t i = 0; i < cust_per_dist; i++) {
+        ol_cnts[partition * cust_per_dist + i] = dis(gen) % 5 + 10;
+      }
+      return 0;
+    });
+    std::vector<uint64_t> ol_begins(districts + 1, 0);
+    for (uint64_t p = 0; p < districts; p++) {
+      ol_begins[p + 1] = ol_begins[p];
+      for (uint64_t i = 0; i < cust_per_dist; i++) {
+        ol_begins[p + 1] += ol_cnts[p * cust_per_dist + i];
       }
     }
+    loader.run(3, districts, [&](uint64_t partition, std::mt19937& gen) {
+      uint64_t w = partition / dist_per_warehouse + 1;
+      uint64_t d = partition % dist_per_warehouse + 1;
+      uint64_t rows = loadCustomers(w, d, gen) +
+                      loadOrders(w, d, &ol_cnts[partition * cust_per_dist], ol_begins[partition], gen);
+      for (uint64_t c = 1; c <= cust_per_dist; c++) {
+        rows += loadHistory(w, d, c, gen);
+      }
+      return rows;
+    });
+    return loader.rows();
   }
 
-  void reserveSlots(std::mt19937& gen) {
-    std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
+  uint64_t restoreDatabase(uint64_t database_size, common::Snapshot& snapshot) {
+    reserveSlots();
+    snapshotDatabase(snapshot);
+    return snapshot.rows();
+  }
+
+  // visits all columns and indexes, s.t. the database can be written to or restored from a snapshot and its columns
+  // can be registered with the redo log
+  template <typename Visitor>
+  void snapshotDatabase(Visitor& snapshot) {
+    auto zero = []() { return 0; };
+    auto unlocked = []() { return static_cast<Locking>(0); };
+    auto list = [&]() { return new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp}; };
+
+    snapshot.column("warehouse.w_id", warehouse.w_id);
+    snapshot.column("warehouse.w_name", warehouse.w_name);
+    snapshot.column("warehouse.w_street_1", warehouse.w_street_1);
+    snapshot.column("warehouse.w_street_2", warehouse.w_street_2);
+    snapshot.column("warehouse.w_city", warehouse.w_city);
+    snapshot.column("warehouse.w_state", warehouse.w_state);
+    snapshot.column("warehouse.w_zip", warehouse.w_zip);
+    snapshot.column("warehouse.w_tax", warehouse.w_tax);
+    snapshot.column("warehouse.w_ytd", warehouse.w_ytd);
+    snapshot.rebuild(warehouse.locked, warehouse.w_id.size(), unlocked);
+    snapshot.rebuild(warehouse.lsn, warehouse.w_id.size(), zero);
+    snapshot.rebuild(warehouse.read_write_table, warehouse.w_id.size(), list);
+
+    snapshot.column("item.i_id", item.i_id);
+    snapshot.column("item.i_im_id", item.i_im_id);
+    snapshot.column("item.i_name", item.i_name);
+    snapshot.column("item.i_price", item.i_price);
+    snapshot.column("item.i_data", item.i_data);
+    snapshot.rebuild(item.locked, item.i_id.size(), unlocked);
+    snapshot.rebuild(item.lsn, item.i_id.size(), zero);
+    snapshot.rebuild(item.read_write_table, item.i_id.size(), list);
+
+    snapshot.column("district.d_id", district.d_id);
+    snapshot.column("district.d_w_id", district.d_w_id);
+    snapshot.column("district.d_name", district.d_name);
+    snapshot.column("district.d_street_1", district.d_street_1);
+    snapshot.column("district.d_street_2", district.d_street_2);
+    snapshot.column("district.d_city", district.d_city);
+    snapshot.column("district.d_state", district.d_state);
+    snapshot.column("district.d_zip", district.d_zip);
+    snapshot.column("district.d_tax", district.d_tax);
+    snapshot.column("district.d_ytd", district.d_ytd);
+    snapshot.column("district.d_next_o_id", district.d_next_o_id);
+    snapshot.column("district.d_next_delivery_o_id", district.d_next_delivery_o_id);
+    snapshot.rebuild(district.locked, district.d_id.size(), unlocked);
+    snapshot.rebuild(district.lsn, district.d_id.size(), zero);
+    snapshot.rebuild(district.read_write_table, district.d_id.size(), list);
+
+    snapshot.column("customer.c_id", customer.c_id);
+    snapshot.column("customer.c_d_id", customer.c_d_id);
+    snapshot.column("customer.c_w_id", customer.c_w_id);
+    snapshot.column("customer.c_first", customer.c_first);
+    snapshot.column("customer.c_middle", customer.c_middle);
+    snapshot.column("customer.c_last", customer.c_last);
+    snapshot.column("customer.c_street_1", customer.c_street_1);
+    snapshot.column("customer.c_street_2", customer.c_street_2);
+    snapshot.column("customer.c_city", customer.c_city);
+    snapshot.column("customer.c_state", customer.c_state);
+    snapshot.column("customer.c_zip", customer.c_zip);
+    snapshot.column("customer.c_phone", customer.c_phone);
+    snapshot.column("customer.c_since", customer.c_since);
+    snapshot.column("customer.c_credit", customer.c_credit);
+    snapshot.column("customer.c_credit_lim", customer.c_credit_lim);
+    snapshot.column("customer.c_discount", customer.c_discount);
+    snapshot.column("customer.c_balance", customer.c_balance);
+    snapshot.column("customer.c_ytd_payment", customer.c_ytd_payment);
+    snapshot.column("customer.c_payment_cnt", customer.c_payment_cnt);
+    snapshot.column("customer.c_delivery_cnt", customer.c_delivery_cnt);
+    snapshot.column("customer.c_data", customer.c_data);
+    snapshot.rebuild(customer.locked, customer.c_id.size(), unlocked);
+    snapshot.rebuild(customer.lsn, customer.c_id.size(), zero);
+    snapshot.rebuild(customer.read_write_table, customer.c_id.size(), list);
+
+    snapshot.column("history.h_c_id", history.h_c_id);
+    snapshot.column("history.h_c_d_id", history.h_c_d_id);
+    snapshot.column("history.h_c_w_id", history.h_c_w_id);
+    snapshot.column("history.h_d_id", history.h_d_id);
+    snapshot.column("history.h_w_id", history.h_w_id);
+    snapshot.column("history.h_date", history.h_date);
+    snapshot.column("history.h_amount", history.h_amount);
+    snapshot.column("history.h_data", history.h_data);
+    snapshot.rebuild(history.locked, history.h_c_id.size(), unlocked);
+    snapshot.rebuild(history.lsn, history.h_c_id.size(), zero);
+    snapshot.rebuild(history.read_write_table, history.h_c_id.size(), list);
+
+    snapshot.column("neworder.no_o_id", neworder.no_o_id);
+    snapshot.column("neworder.no_d_id", neworder.no_d_id);
+    snapshot.column("neworder.no_w_id", neworder.no_w_id);
+    snapshot.rebuild(neworder.locked, neworder.no_o_id.size(), unlocked);
+    snapshot.rebuild(neworder.lsn, neworder.no_o_id.size(), zero);
+    snapshot.rebuild(neworder.read_write_table, neworder.no_o_id.size(), list);
+
+    snapshot.column("order.o_id", order.o_id);
+    snapshot.column("order.o_c_id", order.o_c_id);
+    snapshot.column("order.o_d_id", order.o_d_id);
+    snapshot.column("order.o_w_id", order.o_w_id);
+    snapshot.column("order.o_entry_d", order.o_entry_d);
+    snapshot.column("order.o_carrier_id", order.o_carrier_id);
+    snapshot.column("order.o_ol_cnt", order.o_ol_cnt);
+    snapshot.column("order.o_all_local", order.o_all_local);
+    snapshot.rebuild(order.locked, order.o_id.size(), unlocked);
+    snapshot.rebuild(order.lsn, order.o_id.size(), zero);
+    snapshot.rebuild(order.read_write_table, order.o_id.size(), list);
+
+    snapshot.column("orderline.ol_o_id", orderline.ol_o_id);
+    snapshot.column("orderline.ol_d_id", orderline.ol_d_id);
+    snapshot.column("orderline.ol_w_id", orderline.ol_w_id);
+    snapshot.column("orderline.ol_number", orderline.ol_number);
+    snapshot.column("orderline.ol_i_id", orderline.ol_i_id);
+    snapshot.column("orderline.ol_supply_w_id", orderline.ol_supply_w_id);
+    snapshot.column("orderline.ol_delivery_d", orderline.ol_delivery_d);
+    snapshot.column("orderline.ol_quantity", orderline.ol_quantity);
+    snapshot.column("orderline.ol_amount", orderline.ol_amount);
+    snapshot.column("orderline.ol_dist_info", orderline.ol_dist_info);
+    snapshot.rebuild(orderline.locked, orderline.ol_o_id.size(), unlocked);
+    snapshot.rebuild(orderline.lsn, orderline.ol_o_id.size(), zero);
+    snapshot.rebuild(orderline.read_write_table, orderline.ol_o_id.size(), list);
+
+    snapshot.column("stock.s_i_id", stock.s_i_id);
+    snapshot.column("stock.s_w_id", stock.s_w_id);
+    snapshot.column("stock.s_quantity", stock.s_quantity);
+    snapshot.column("stock.s_dist_01", stock.s_dist_01);
+    snapshot.column("stock.s_dist_02", stock.s_dist_02);
+    snapshot.column("stock.s_dist_03", stock.s_dist_03);
+    snapshot.column("stock.s_dist_04", stock.s_dist_04);
+    snapshot.column("stock.s_dist_05", stock.s_dist_05);
+    snapshot.column("stock.s_dist_06", stock.s_dist_06);
+    snapshot.column("stock.s_dist_07", stock.s_dist_07);
+    snapshot.column("stock.s_dist_08", stock.s_dist_08);
+    snapshot.column("stock.s_dist_09", stock.s_dist_09);
+    snapshot.column("stock.s_dist_10", stock.s_dist_10);
+    snapshot.column("stock.s_ytd", stock.s_ytd);
+    snapshot.column("stock.s_order_cnt", stock.s_order_cnt);
+    snapshot.column("stock.s_remote_cnt", stock.s_remote_cnt);
+    snapshot.column("stock.s_data", stock.s_data);
+    snapshot.rebuild(stock.locked, stock.s_i_id.size(), unlocked);
+    snapshot.rebuild(stock.lsn, stock.s_i_id.size(), zero);
+    snapshot.rebuild(stock.read_write_table, stock.s_i_id.size(), list);
+
+    snapshot.index("item_map", *item_map);
+    snapshot.index("warehouse_map", *warehouse_map);
+    snapshot.index("stock_map", *stock_map);
+    snapshot.index("district_map", *district_map);
+    snapshot.index("customer_id_map", *customer_id_map);
+    snapshot.index("customer_last_map", *customer_last_map);
+    snapshot.index("order_map", *order_map);
+    snapshot.index("orderline_map", *orderline_map);
+    snapshot.index("orderline_wd_map", *orderline_wd_map);
+    snapshot.index("customer_order_map", *customer_order_map);
+    snapshot.index("neworder_map", *neworder_map);
+  }
 
+  void reserveSlots() {
     item.i_data.reserve(max_items);
     item.i_id.reserve(max_items);
     item.i_name.reserve(max_items);
@@ -633,6 +879,7 @@ struct Database {
     district.d_tax.reserve(dist_per_warehouse * number_warehouses);
     district.d_ytd.reserve(dist_per_warehouse * number_warehouses);
     district.d_next_o_id.reserve(dist_per_warehouse * number_warehouses);
+    district.d_next_delivery_o_id.reserve(dist_per_warehouse * number_warehouses);
     district.lsn.reserve(dist_per_warehouse * number_warehouses);
     district.locked.reserve(dist_per_warehouse * number_warehouses);
     district.read_write_table.reserve(dist_per_warehouse * number_warehouses);
@@ -733,6 +980,11 @@ struct Database {
                                                   common::ChunkAllocator>>(
             10 * cust_per_dist * dist_per_warehouse * number_warehouses, &ca, &emp);
 
+    customer_order_map =
+        std::make_unique<atom::AtomicUnorderedMap<uint64_t, int64_t, atom::AtomicUnorderedMapBucket<uint64_t, int64_t>,
+                                                  common::ChunkAllocator>>(
+            cust_per_dist * dist_per_warehouse * number_warehouses, &ca, &emp);
+
     neworder.no_o_id.reserve(cust_per_dist * dist_per_warehouse * number_warehouses);
     neworder.no_d_id.reserve(cust_per_dist * dist_per_warehouse * number_warehouses);
     neworder.no_w_id.reserve(cust_per_dist * dist_per_warehouse * number_warehouses);
@@ -740,6 +992,12 @@ struct Database {
     neworder.locked.reserve(cust_per_dist * dist_per_warehouse * number_warehouses);
     neworder.read_write_table.reserve(cust_per_dist * dist_per_warehouse * number_warehouses);
     neworder.opl = new common::OptimisticPredicateLocking<common::ChunkAllocator>{&ca, &emp};
+
+    neworder_map =
+        std::make_unique<atom::AtomicUnorderedMap<uint64_t, int64_t, atom::AtomicUnorderedMapBucket<uint64_t, int64_t>,
+                                                  common::ChunkAllocator>>(
+            cust_per_dist * dist_per_warehouse * number_warehouses, &ca, &emp);
+
   }
 
   uint64_t getLastname(uint64_t random, char* name) {
@@ -762,6 +1020,9 @@ struct Database {
   int64_t distKey(int64_t d, int64_t w) { return w * dist_per_warehouse + d; }
   int64_t custKey(int64_t c, int64_t d, int64_t w) { return (distKey(d, w) * cust_per_dist + c); }
   int64_t orderPrimaryKey(uint64_t w, int64_t d, int64_t o) { return (distKey(d, w) << 32) + o; }
+  int64_t orderLineKey(uint64_t w, int64_t d, int64_t o, int64_t number) {
+    return (orderPrimaryKey(w, d, o) << 4) + number;
+  }
   int64_t custNPKey(char* c, int64_t d, int64_t w) {
     int64_t key = 0;
     char offset = 'A';
@@ -772,126 +1033,141 @@ struct Database {
     return key;
   }
 
-  void loadItems(std::mt19937& gen) {
+  uint64_t loadItems(uint64_t partition, std::mt19937& gen) {
     std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
-    for (uint64_t i = 1; i <= max_items; ++i) {
-      auto id = item.i_id.push_back(i);
+    auto begin = common::ParallelLoader::partitionBegin(partition);
+    auto end = common::ParallelLoader::partitionEnd(partition, max_items);
+    for (uint64_t i = begin + 1; i <= end; ++i) {
+      uint64_t id = i - 1;
+      item.i_id.store(id, i);
       StringStruct<24> stringstruct_24;
       generateRandomString(stringstruct_24.string, 24, gen);
-      item.i_name.push_back(stringstruct_24);
-      item.i_price.push_back((100.0 + (dis(gen) % 900)) / 100.0);
-      item.i_im_id.push_back(1 + (dis(gen) % 10000));
+      item.i_name.store(id, stringstruct_24);
+      item.i_price.store(id, (100.0 + (dis(gen) % 900)) / 100.0);
+      item.i_im_id.store(id, 1 + (dis(gen) % 10000));
       StringStruct<50> stringstruct_50;
       generateRandomString(stringstruct_50.string, dis(gen) % 24 + 26, gen);
       if (dis(gen) % 10 == 0)
         strcpy(stringstruct_50.string + dis(gen) % 12, "original");
-      item.i_data.push_back(stringstruct_50);
+      item.i_data.store(id, stringstruct_50);
 
-      item.lsn.push_back(0);
-      item.locked.push_back(static_cast<Locking>(0));
-      item.read_write_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+      item.lsn.store(id, 0);
+      item.locked.store(id, static_cast<Locking>(0));
+      item.read_write_table.store(id, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
       item_map->insert(i, id);
     }
+    return end - begin;
   }
 
-  void loadStock(uint64_t w, std::mt19937& gen) {
+  uint64_t loadStock(uint64_t w, uint64_t partition, std::mt19937& gen) {
     std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
-    for (uint64_t i = 1; i <= max_items; ++i) {
-      auto id = stock.s_i_id.push_back(i);
-      stock.s_w_id.push_back(w);
-      stock.s_ytd.push_back(0);
-      stock.s_order_cnt.push_back(0);
-      stock.s_remote_cnt.push_back(0);
-      stock.s_quantity.push_back(10 + (dis(gen) % 90));
+    auto begin = common::ParallelLoader::partitionBegin(partition);
+    auto end = common::ParallelLoader::partitionEnd(partition, max_items);
+    for (uint64_t i = begin + 1; i <= end; ++i) {
+      uint64_t id = (w - 1) * max_items + i - 1;
+      stock.s_i_id.store(id, i);
+      stock.s_w_id.store(id, w);
+      stock.s_ytd.store(id, 0);
+      stock.s_order_cnt.store(id, 0);
+      stock.s_remote_cnt.store(id, 0);
+      stock.s_quantity.store(id, 10 + (dis(gen) % 90));
       StringStruct<50> stringstruct_50;
       generateRandomString(stringstruct_50.string, dis(gen) % 24 + 26, gen);
       if (dis(gen) % 10 == 0)
         strcpy(stringstruct_50.string + dis(gen) % 12, "original");
-      stock.s_data.push_back(stringstruct_50);
-      stock.lsn.push_back(0);
-      stock.locked.push_back(static_cast<Locking>(0));
-      stock.read_write_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+      stock.s_data.store(id, stringstruct_50);
+      stock.lsn.store(id, 0);
+      stock.locked.store(id, static_cast<Locking>(0));
+      stock.read_write_table.store(id, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
       stock_map->insert(stockKey(i, w), id);
     }
+    return end - begin;
   }
 
-  void loadWarehouse(uint64_t w, std::mt19937& gen) {
+  uint64_t loadWarehouse(uint64_t w, std::mt19937& gen) {
     std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
-    auto id = warehouse.w_id.push_back(w);
+    uint64_t id = w - 1;
+    warehouse.w_id.store(id, w);
     StringStruct<10> stringstruct_10;
     generateRandomString(stringstruct_10.string, dis(gen) % 6 + 4, gen);
-    warehouse.w_name.push_back(stringstruct_10);
+    warehouse.w_name.store(id, stringstruct_10);
     StringStruct<20> stringstruct_20;
     generateRandomString(stringstruct_20.string, dis(gen) % 10 + 10, gen);
-    warehouse.w_street_1.push_back(stringstruct_20);
+    warehouse.w_street_1.store(id, stringstruct_20);
     generateRandomString(stringstruct_20.string, dis(gen) % 10 + 10, gen);
-    warehouse.w_street_2.push_back(stringstruct_20);
+    warehouse.w_street_2.store(id, stringstruct_20);
     generateRandomString(stringstruct_20.string, dis(gen) % 10 + 10, gen);
-    warehouse.w_city.push_back(stringstruct_20);
+    warehouse.w_city.store(id, stringstruct_20);
     StringStruct<2> stringstruct_2;
     generateRandomString(stringstruct_2.string, 2, gen);
-    warehouse.w_state.push_back(stringstruct_2);
+    warehouse.w_state.store(id, stringstruct_2);
     StringStruct<9> stringstruct_9;
     getNumberString(dis(gen), stringstruct_9.string, 9);
-    warehouse.w_zip.push_back(stringstruct_9);
-    warehouse.w_ytd.push_back(30000.00);
-    warehouse.w_tax.push_back(((double)(dis(gen) % 200)) / 1000.0);
-    warehouse.lsn.push_back(0);
-    warehouse.locked.push_back(static_cast<Locking>(0));
-    warehouse.read_write_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+    warehouse.w_zip.store(id, stringstruct_9);
+    warehouse.w_ytd.store(id, 30000.00);
+    warehouse.w_tax.store(id, ((double)(dis(gen) % 200)) / 1000.0);
+    warehouse.lsn.store(id, 0);
+    warehouse.locked.store(id, static_cast<Locking>(0));
+    warehouse.read_write_table.store(id, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
 
     warehouse_map->insert(w, id);
+    return 1;
   }
 
-  void loadDistricts(uint64_t w, std::mt19937& gen) {
+  uint64_t loadDistricts(uint64_t w, std::mt19937& gen) {
     std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
     for (uint64_t i = 1; i <= dist_per_warehouse; ++i) {
-      auto id = district.d_id.push_back(i);
-      district.d_w_id.push_back(w);
+      uint64_t id = (w - 1) * dist_per_warehouse + i - 1;
+      district.d_id.store(id, i);
+      district.d_w_id.store(id, w);
       StringStruct<10> stringstruct_10;
       generateRandomString(stringstruct_10.string, dis(gen) % 6 + 4, gen);
-      district.d_name.push_back(stringstruct_10);
+      district.d_name.store(id, stringstruct_10);
       StringStruct<20> stringstruct_20;
       generateRandomString(stringstruct_20.string, dis(gen) % 10 + 10, gen);
-      district.d_street_1.push_back(stringstruct_20);
+      district.d_street_1.store(id, stringstruct_20);
       generateRandomString(stringstruct_20.string, dis(gen) % 10 + 10, gen);
-      district.d_street_2.push_back(stringstruct_20);
+      district.d_street_2.store(id, stringstruct_20);
       generateRandomString(stringstruct_20.string, dis(gen) % 10 + 10, gen);
-      district.d_city.push_back(stringstruct_20);
+      district.d_city.store(id, stringstruct_20);
       StringStruct<2> stringstruct_2;
       generateRandomString(stringstruct_2.string, 2, gen);
-      district.d_state.push_back(stringstruct_2);
+      district.d_state.store(id, stringstruct_2);
       StringStruct<9> stringstruct_9;
       getNumberString(dis(gen), stringstruct_9.string, 9);
-      district.d_zip.push_back(stringstruct_9);
-      district.d_ytd.push_back(30000.00);
-      district.d_tax.push_back(((double)(dis(gen) % 200)) / 1000.0);
-      district.d_next_o_id.push_back(cust_per_dist + 1);
+      district.d_zip.store(id, stringstruct_9);
+      district.d_ytd.store(id, 30000.00);
+      district.d_tax.store(id, ((double)(dis(gen) % 200)) / 1000.0);
+      district.d_next_o_id.store(id, cust_per_dist + 1);
+      // the orders from 2101 on are undelivered after the population
+      district.d_next_delivery_o_id.store(id, 2101);
 
-      district.lsn.push_back(0);
-      district.locked.push_back(static_cast<Locking>(0));
-      district.read_write_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+      district.lsn.store(id, 0);
+      district.locked.store(id, static_cast<Locking>(0));
+      district.read_write_table.store(id, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
 
       district_map->insert(distKey(i, w), id);
     }
+    return dist_per_warehouse;
   }
 
-  void loadCustomers(uint64_t w, uint64_t d, std::mt19937& gen) {
+  uint64_t loadCustomers(uint64_t w, uint64_t d, std::mt19937& gen) {
     std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
     for (uint64_t i = 1; i <= cust_per_dist; ++i) {
-      auto id = customer.c_id.push_back(i);
-      customer.c_w_id.push_back(w);
-      customer.c_d_id.push_back(d);
+      uint64_t id = ((w - 1) * dist_per_warehouse + d - 1) * cust_per_dist + i - 1;
+      customer.c_id.store(id, i);
+      customer.c_w_id.store(id, w);
+      customer.c_d_id.store(id, d);
       StringStruct<16> stringstruct_16;
       generateRandomString(stringstruct_16.string, dis(gen) % 8 + 8, gen);
-      customer.c_first.push_back(stringstruct_16);
+      customer.c_first.store(id, stringstruct_16);
       if (i <= 1000) {
         getLastname(i - 1, stringstruct_16.string);
       } else {
         getLastname(nonUniformRandom(255, 157, 0, 999, gen), stringstruct_16.string);
       }
-      customer.c_last.push_back(stringstruct_16);
-      customer.c_discount.push_back((float)((dis(gen) % 5000) / 10000.0));
+      customer.c_last.store(id, stringstruct_16);
+      customer.c_discount.store(id, (float)((dis(gen) % 5000) / 10000.0));
       StringStruct<2> stringstruct_2;
       if (dis(gen) % 100 <= 10) {
         stringstruct_2.string[0] = 'B';
@@ -899,125 +1175,139 @@ struct Database {
         stringstruct_2.string[0] = 'G';
       }
       stringstruct_2.string[1] = 'C';
-      customer.c_credit.push_back(stringstruct_2);
+      customer.c_credit.store(id, stringstruct_2);
 
-      customer.c_credit_lim.push_back(50000);
+      customer.c_credit_lim.store(id, 50000);
 
-      customer.c_balance.push_back(-10);
-      customer.c_ytd_payment.push_back(10);
-      customer.c_payment_cnt.push_back(1);
-      customer.c_delivery_cnt.push_back(0);
+      customer.c_balance.store(id, -10);
+      customer.c_ytd_payment.store(id, 10);
+      customer.c_payment_cnt.store(id, 1);
+      customer.c_delivery_cnt.store(id, 0);
 
       StringStruct<20> stringstruct_20;
       generateRandomString(stringstruct_20.string, dis(gen) % 10 + 10, gen);
-      customer.c_street_1.push_back(stringstruct_20);
+      customer.c_street_1.store(id, stringstruct_20);
       generateRandomString(stringstruct_20.string, dis(gen) % 10 + 10, gen);
-      customer.c_street_2.push_back(stringstruct_20);
+      customer.c_street_2.store(id, stringstruct_20);
       generateRandomString(stringstruct_20.string, dis(gen) % 10 + 10, gen);
-      customer.c_city.push_back(stringstruct_20);
+      customer.c_city.store(id, stringstruct_20);
       generateRandomString(stringstruct_2.string, 2, gen);
-      customer.c_state.push_back(stringstruct_2);
+      customer.c_state.store(id, stringstruct_2);
       StringStruct<9> stringstruct_9;
       getNumberString(dis(gen), stringstruct_9.string, 9);
-      customer.c_zip.push_back(stringstruct_9);
+      customer.c_zip.store(id, stringstruct_9);
 
       stringstruct_2.string[0] = 'O';
       stringstruct_2.string[1] = 'E';
-      customer.c_middle.push_back(stringstruct_2);
+      customer.c_middle.store(id, stringstruct_2);
       StringStruct<128> stringstruct_128;
       generateRandomString(stringstruct_128.string, dis(gen) % 64 + 64, gen);
-      customer.c_data.push_back(stringstruct_128);
-      customer.c_since.push_back((unsigned)time(NULL));
+      customer.c_data.store(id, stringstruct_128);
+      customer.c_since.store(id, (unsigned)time(NULL));
 
-      customer.lsn.push_back(0);
-      customer.locked.push_back(static_cast<Locking>(0));
-      customer.read_write_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+      customer.lsn.store(id, 0);
+      customer.locked.store(id, static_cast<Locking>(0));
+      customer.read_write_table.store(id, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
 
       customer_id_map->insert(custKey(i, d, w), id);
       customer_last_map->insert(custNPKey(stringstruct_16.string, d, w), id);
     }
+    return cust_per_dist;
   }
 
-  void loadOrders(uint64_t w, uint64_t d, std::mt19937& gen) {
+  uint64_t loadOrders(uint64_t w, uint64_t d, const uint8_t* ol_cnts, uint64_t ol_begin, std::mt19937& gen) {
     std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
     uint64_t perm[cust_per_dist];
     for (uint64_t i = 1; i <= cust_per_dist; i++)
       perm[i - 1] = i;
-    std::random_shuffle(perm, perm + cust_per_dist);
+    std::shuffle(perm, perm + cust_per_dist, gen);
+
+    uint64_t rows = 0;
 
     for (uint64_t i = 1; i <= cust_per_dist; ++i) {
-      auto id = order.o_id.push_back(i);
-      order.o_c_id.push_back(perm[i - 1]);
-      order.o_d_id.push_back(d);
-      order.o_w_id.push_back(w);
+      uint64_t id = ((w - 1) * dist_per_warehouse + d - 1) * cust_per_dist + i - 1;
+      order.o_id.store(id, i);
+      order.o_c_id.store(id, perm[i - 1]);
+      order.o_d_id.store(id, d);
+      order.o_w_id.store(id, w);
       unsigned o_entry = (unsigned)time(NULL);
-      order.o_entry_d.push_back(o_entry);
+      order.o_entry_d.store(id, o_entry);
       if (i < 2101)
-        order.o_carrier_id.push_back(dis(gen) % 9 + 1);
+        order.o_carrier_id.store(id, dis(gen) % 9 + 1);
       else
-        order.o_carrier_id.push_back(0);
-      uint64_t ol_cnt = dis(gen) % 5 + 10;
-      order.o_ol_cnt.push_back(ol_cnt);
-      order.o_all_local.push_back(1);
+        order.o_carrier_id.store(id, 0);
+      uint64_t ol_cnt = ol_cnts[i - 1];
+      order.o_ol_cnt.store(id, ol_cnt);
+      order.o_all_local.store(id, 1);
 
-      order.lsn.push_back(0);
-      order.locked.push_back(static_cast<Locking>(0));
-      order.read_write_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+      order.lsn.store(id, 0);
+      order.locked.store(id, static_cast<Locking>(0));
+      order.read_write_table.store(id, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
 
       order_map->insert(orderPrimaryKey(w, d, i), id);
+      customer_order_map->insert(custKey(perm[i - 1], d, w), id);
+      rows += 1 + ol_cnt;
 
       for (uint32_t ol = 1; ol <= ol_cnt; ol++) {
-        orderline.ol_o_id.push_back(i);
-        orderline.ol_d_id.push_back(d);
-        orderline.ol_w_id.push_back(w);
-        orderline.ol_number.push_back(ol);
-        orderline.ol_i_id.push_back(dis(gen) % 100000 + 1);
-        orderline.ol_supply_w_id.push_back(w);
+        uint64_t ol_id = ol_begin + ol - 1;
+        orderline.ol_o_id.store(ol_id, i);
+        orderline.ol_d_id.store(ol_id, d);
+        orderline.ol_w_id.store(ol_id, w);
+        orderline.ol_number.store(ol_id, ol);
+        orderline.ol_i_id.store(ol_id, dis(gen) % 100000 + 1);
+        orderline.ol_supply_w_id.store(ol_id, w);
         if (i < 2101) {
-          orderline.ol_delivery_d.push_back(o_entry);
-          orderline.ol_amount.push_back(0);
+          orderline.ol_delivery_d.store(ol_id, o_entry);
+          orderline.ol_amount.store(ol_id, 0);
         } else {
-          orderline.ol_delivery_d.push_back(0);
-          orderline.ol_amount.push_back((double)(dis(gen) % 999999 + 1) / 100.0);
+          orderline.ol_delivery_d.store(ol_id, 0);
+          orderline.ol_amount.store(ol_id, (double)(dis(gen) % 999999 + 1) / 100.0);
         }
-        orderline.ol_quantity.push_back(5);
+        orderline.ol_quantity.store(ol_id, 5);
         StringStruct<24> stringstruct_24;
         generateRandomString(stringstruct_24.string, 24, gen);
-        orderline.ol_dist_info.push_back(stringstruct_24);
+        orderline.ol_dist_info.store(ol_id, stringstruct_24);
 
-        orderline.lsn.push_back(0);
-        orderline.locked.push_back(static_cast<Locking>(0));
-        orderline.read_write_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+        orderline.lsn.store(ol_id, 0);
+        orderline.locked.store(ol_id, static_cast<Locking>(0));
+        orderline.read_write_table.store(ol_id, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+        orderline_map->insert(orderLineKey(w, d, i, ol), ol_id);
       }
+      ol_begin += ol_cnt;
 
       if (i > 2100) {
-        neworder.no_d_id.push_back(d);
-        neworder.no_w_id.push_back(w);
-        neworder.no_o_id.push_back(i);
+        uint64_t no_id = ((w - 1) * dist_per_warehouse + d - 1) * (cust_per_dist - 2100) + i - 2101;
+        neworder.no_d_id.store(no_id, d);
+        neworder.no_w_id.store(no_id, w);
+        neworder.no_o_id.store(no_id, i);
 
-        neworder.lsn.push_back(0);
-        neworder.locked.push_back(static_cast<Locking>(0));
-        neworder.read_write_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+        neworder.lsn.store(no_id, 0);
+        neworder.locked.store(no_id, static_cast<Locking>(0));
+        neworder.read_write_table.store(no_id, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+        neworder_map->insert(orderPrimaryKey(w, d, i), no_id);
       }
     }
+    return rows + cust_per_dist - 2100;
   }
 
-  void loadHistory(uint64_t w, uint64_t d, uint64_t c, std::mt19937& gen) {
+  uint64_t loadHistory(uint64_t w, uint64_t d, uint64_t c, std::mt19937& gen) {
     std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
-    history.h_c_id.push_back(c);
-    history.h_c_d_id.push_back(d);
-    history.h_c_w_id.push_back(w);
-    history.h_d_id.push_back(d);
-    history.h_w_id.push_back(w);
-    history.h_date.push_back((unsigned)time(NULL));
-    history.h_amount.push_back(10);
+    uint64_t id = ((w - 1) * dist_per_warehouse + d - 1) * cust_per_dist + c - 1;
+    history.h_c_id.store(id, c);
+    history.h_c_d_id.store(id, d);
+    history.h_c_w_id.store(id, w);
+    history.h_d_id.store(id, d);
+    history.h_w_id.store(id, w);
+    history.h_date.store(id, (unsigned)time(NULL));
+    history.h_amount.store(id, 10);
     StringStruct<24> stringstruct_24;
     generateRandomString(stringstruct_24.string, dis(gen) % 10 + 14, gen);
-    history.h_data.push_back(stringstruct_24);
+    history.h_data.store(id, stringstruct_24);
 
-    history.lsn.push_back(0);
-    history.locked.push_back(static_cast<Locking>(0));
-    history.read_write_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+    history.lsn.store(id, 0);
+    history.locked.store(id, static_cast<Locking>(0));
+    history.read_write_table.store(id, new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp});
+    return 1;
   }
 
   void deleteDatabase() {
@@ -1217,56 +1507,64 @@ struct Database {
       uint64_t main_id = history.h_c_d_id.push_back(payment.c_d);
       uint64_t sub_id = history.h_c_w_id.push_back(payment.c_w);
       if (main_id != sub_id) {
-        while (!history.h_c_w_id.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.h_c_w_id.isAlive(main_id);) {
+          backoff.pause();
         }
         history.h_c_w_id.replace(main_id, payment.c_w);
       }
 
       sub_id = history.h_c_id.push_back(payment.c);
       if (main_id != sub_id) {
-        while (!history.h_c_id.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.h_c_id.isAlive(main_id);) {
+          backoff.pause();
         }
         history.h_c_id.replace(main_id, payment.c);
       }
 
       sub_id = history.h_d_id.push_back(payment.d);
       if (main_id != sub_id) {
-        while (!history.h_d_id.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.h_d_id.isAlive(main_id);) {
+          backoff.pause();
         }
         history.h_d_id.replace(main_id, payment.d);
       }
 
       sub_id = history.h_w_id.push_back(payment.w);
       if (main_id != sub_id) {
-        while (!history.h_w_id.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.h_w_id.isAlive(main_id);) {
+          backoff.pause();
         }
         history.h_w_id.replace(main_id, payment.w);
       }
 
       sub_id = history.h_date.push_back(time(NULL));
       if (main_id != sub_id) {
-        while (!history.h_date.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.h_date.isAlive(main_id);) {
+          backoff.pause();
         }
         history.h_date.replace(main_id, time(NULL));
       }
 
       sub_id = history.h_amount.push_back(payment.amount);
       if (main_id != sub_id) {
-        while (!history.h_amount.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.h_amount.isAlive(main_id);) {
+          backoff.pause();
         }
         history.h_amount.replace(main_id, payment.amount);
       }
 
       sub_id = history.lsn.push_back(0);
       if (main_id != sub_id) {
-        while (!history.lsn.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.lsn.isAlive(main_id);) {
+          backoff.pause();
         }
         history.lsn.atomic_replace(main_id, 0);
       }
 
       sub_id = history.locked.push_back(static_cast<Locking>(0));
       if (main_id != sub_id) {
-        while (!history.locked.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.locked.isAlive(main_id);) {
+          backoff.pause();
         }
         history.locked.atomic_replace(main_id, static_cast<Locking>(0));
       }
@@ -1274,7 +1572,8 @@ struct Database {
       auto ptr = new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp};
       sub_id = history.read_write_table.push_back(ptr);
       if (main_id != sub_id) {
-        while (!history.read_write_table.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.read_write_table.isAlive(main_id);) {
+          backoff.pause();
         }
         history.read_write_table.atomic_replace(main_id, ptr);
       }
@@ -1449,56 +1748,64 @@ struct Database {
       uint64_t main_id = history.h_c_d_id.push_back(payment.c_d);
       uint64_t sub_id = history.h_c_w_id.push_back(payment.c_w);
       if (main_id != sub_id) {
-        while (!history.h_c_w_id.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.h_c_w_id.isAlive(main_id);) {
+          backoff.pause();
         }
         history.h_c_w_id.replace(main_id, payment.c_w);
       }
 
       sub_id = history.h_c_id.push_back(payment.c);
       if (main_id != sub_id) {
-        while (!history.h_c_id.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.h_c_id.isAlive(main_id);) {
+          backoff.pause();
         }
         history.h_c_id.replace(main_id, payment.c);
       }
 
       sub_id = history.h_d_id.push_back(payment.d);
       if (main_id != sub_id) {
-        while (!history.h_d_id.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.h_d_id.isAlive(main_id);) {
+          backoff.pause();
         }
         history.h_d_id.replace(main_id, payment.d);
       }
 
       sub_id = history.h_w_id.push_back(payment.w);
       if (main_id != sub_id) {
-        while (!history.h_w_id.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.h_w_id.isAlive(main_id);) {
+          backoff.pause();
         }
         history.h_w_id.replace(main_id, payment.w);
       }
 
       sub_id = history.h_date.push_back(time(NULL));
       if (main_id != sub_id) {
-        while (!history.h_date.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.h_date.isAlive(main_id);) {
+          backoff.pause();
         }
         history.h_date.replace(main_id, time(NULL));
       }
 
       sub_id = history.h_amount.push_back(payment.amount);
       if (main_id != sub_id) {
-        while (!history.h_amount.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.h_amount.isAlive(main_id);) {
+          backoff.pause();
         }
         history.h_amount.replace(main_id, payment.amount);
       }
 
       sub_id = history.lsn.push_back(0);
       if (main_id != sub_id) {
-        while (!history.lsn.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.lsn.isAlive(main_id);) {
+          backoff.pause();
         }
         history.lsn.atomic_replace(main_id, 0);
       }
 
       sub_id = history.locked.push_back(static_cast<Locking>(0));
       if (main_id != sub_id) {
-        while (!history.locked.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.locked.isAlive(main_id);) {
+          backoff.pause();
         }
         history.locked.atomic_replace(main_id, static_cast<Locking>(0));
       }
@@ -1506,7 +1813,8 @@ struct Database {
       auto ptr = new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp};
       sub_id = history.read_write_table.push_back(ptr);
       if (main_id != sub_id) {
-        while (!history.read_write_table.isAlive(main_id)) {
+        for (common::Backoff backoff; !history.read_write_table.isAlive(main_id);) {
+          backoff.pause();
         }
         history.read_write_table.atomic_replace(main_id, ptr);
       }
@@ -1544,6 +1852,69 @@ struct Database {
     }
   }
 
+  // looks up the rows of a NewOrder (items and stocks of the order lines, warehouse, customer, district) or a Payment
+  // interleaved and prefetches the columns it reads or updates, see common::Interleave; the other transactions and
+  // payments by last name run without prefetching
+  void prefetchTransaction(Transaction tx, const NewOrderVar& neworder, const PaymentVar& payment) {
+#ifdef NFN_COROUTINES
+    using common::Interleave;
+    if (Interleave::width() == 0)
+      return;
+    auto prefetchWarehouse = [this](uint64_t o) {
+      warehouse.w_tax.prefetch(o);
+      warehouse.w_ytd.prefetch(o);
+    };
+    auto prefetchDistrict = [this](uint64_t o) {
+      district.d_next_o_id.prefetch(o);
+      district.d_tax.prefetch(o);
+      district.d_ytd.prefetch(o);
+    };
+    auto prefetchCustomer = [this](uint64_t o) {
+      customer.c_last.prefetch(o);
+      customer.c_credit.prefetch(o);
+      customer.c_discount.prefetch(o);
+      customer.c_balance.prefetch(o);
+    };
+    if (tx == Transaction::NewOrder) {
+      uint64_t num = neworder.num;
+      Interleave::run(2 * num + 3, [&](uint64_t j) {
+        if (j < num) {
+          return Interleave::lookup(*item_map, neworder.items[j], item, [this](uint64_t o) {
+            item.i_price.prefetch(o);
+            item.i_name.prefetch(o);
+            item.i_data.prefetch(o);
+          });
+        } else if (j < 2 * num) {
+          int64_t sk = stockKey(neworder.items[j - num], neworder.suppliers[j - num]);
+          return Interleave::lookup(*stock_map, sk, stock, [this](uint64_t o) {
+            stock.s_quantity.prefetch(o);
+            stock.s_ytd.prefetch(o);
+            stock.s_order_cnt.prefetch(o);
+            stock.s_remote_cnt.prefetch(o);
+            stock.s_data.prefetch(o);
+          });
+        } else if (j == 2 * num) {
+          return Interleave::lookup(*warehouse_map, neworder.w, warehouse, prefetchWarehouse);
+        } else if (j == 2 * num + 1) {
+          int64_t ck = custKey(neworder.c, neworder.d, neworder.w);
+          return Interleave::lookup(*customer_id_map, ck, customer, prefetchCustomer);
+        }
+        return Interleave::lookup(*district_map, distKey(neworder.d, neworder.w), district, prefetchDistrict);
+      });
+    } else if (tx == Transaction::Payment) {
+      Interleave::run(payment.by_lastname ? 2 : 3, [&](uint64_t j) {
+        if (j == 0) {
+          return Interleave::lookup(*warehouse_map, payment.w, warehouse, prefetchWarehouse);
+        } else if (j == 1) {
+          return Interleave::lookup(*district_map, distKey(payment.d, payment.w), district, prefetchDistrict);
+        }
+        int64_t ck = custKey(payment.c, payment.d, payment.w);
+        return Interleave::lookup(*customer_id_map, ck, customer, prefetchCustomer);
+      });
+    }
+#endif
+  }
+
   template <bool T, typename std::enable_if_t<T>* = nullptr>
   int execNewOrder(NewOrderVar& neworder,
                    SinglyDistrict& d,
@@ -1619,56 +1990,64 @@ struct Database {
       order_insert = order.o_id.push_back(d.d_next_o_id);
       uint64_t sub_id = order.o_d_id.push_back(neworder.d);
       if (order_insert != sub_id) {
-        while (!order.o_d_id.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.o_d_id.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.o_d_id.replace(order_insert, neworder.d);
       }
 
       sub_id = order.o_w_id.push_back(neworder.w);
       if (order_insert != sub_id) {
-        while (!order.o_w_id.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.o_w_id.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.o_w_id.replace(order_insert, neworder.w);
       }
 
       sub_id = order.o_c_id.push_back(neworder.c);
       if (order_insert != sub_id) {
-        while (!order.o_c_id.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.o_c_id.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.o_c_id.replace(order_insert, neworder.c);
       }
 
       sub_id = order.o_entry_d.push_back(time(NULL));
       if (order_insert != sub_id) {
-        while (!order.o_entry_d.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.o_entry_d.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.o_entry_d.replace(order_insert, time(NULL));
       }
 
       sub_id = order.o_ol_cnt.push_back(neworder.num);
       if (order_insert != sub_id) {
-        while (!order.o_ol_cnt.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.o_ol_cnt.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.o_ol_cnt.replace(order_insert, neworder.num);
       }
 
       sub_id = order.o_all_local.push_back(neworder.alllocal);
       if (order_insert != sub_id) {
-        while (!order.o_all_local.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.o_all_local.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.o_all_local.replace(order_insert, neworder.alllocal);
       }
 
       sub_id = order.lsn.push_back(0);
       if (order_insert != sub_id) {
-        while (!order.lsn.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.lsn.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.lsn.atomic_replace(order_insert, 0);
       }
 
       sub_id = order.locked.push_back(static_cast<Locking>(0));
       if (order_insert != sub_id) {
-        while (!order.locked.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.locked.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.locked.atomic_replace(order_insert, static_cast<Locking>(0));
       }
@@ -1676,7 +2055,8 @@ struct Database {
       auto ptr = new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp};
       sub_id = order.read_write_table.push_back(ptr);
       if (order_insert != sub_id) {
-        while (!order.read_write_table.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.read_write_table.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.read_write_table.atomic_replace(order_insert, ptr);
       }
@@ -1769,49 +2149,56 @@ struct Database {
         removeIds[ocnt] = orderline.ol_o_id.push_back(d.d_next_o_id);
         uint64_t sub_id = orderline.ol_d_id.push_back(neworder.d);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.ol_d_id.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.ol_d_id.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.ol_d_id.replace(removeIds[ocnt], neworder.d);
         }
 
         sub_id = orderline.ol_w_id.push_back(neworder.w);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.ol_w_id.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.ol_w_id.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.ol_w_id.replace(removeIds[ocnt], neworder.w);
         }
 
         sub_id = orderline.ol_number.push_back(ocnt);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.ol_number.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.ol_number.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.ol_number.replace(removeIds[ocnt], ocnt);
         }
 
         sub_id = orderline.ol_i_id.push_back(neworder.items[ocnt]);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.ol_i_id.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.ol_i_id.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.ol_i_id.replace(removeIds[ocnt], neworder.items[ocnt]);
         }
 
         sub_id = orderline.ol_supply_w_id.push_back(neworder.suppliers[ocnt]);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.ol_supply_w_id.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.ol_supply_w_id.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.ol_supply_w_id.replace(removeIds[ocnt], neworder.suppliers[ocnt]);
         }
 
         sub_id = orderline.ol_quantity.push_back(neworder.quantities[ocnt]);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.ol_quantity.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.ol_quantity.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.ol_quantity.replace(removeIds[ocnt], neworder.quantities[ocnt]);
         }
 
         sub_id = orderline.ol_amount.push_back((double)(neworder.quantities[ocnt]) * i.i_price);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.ol_amount.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.ol_amount.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.ol_amount.replace(removeIds[ocnt], (double)(neworder.quantities[ocnt]) * i.i_price);
         }
@@ -1852,21 +2239,24 @@ struct Database {
 
         sub_id = orderline.ol_dist_info.push_back(ol_dist_info);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.ol_dist_info.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.ol_dist_info.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.ol_dist_info.replace(removeIds[ocnt], ol_dist_info);
         }
 
         sub_id = orderline.lsn.push_back(0);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.lsn.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.lsn.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.lsn.atomic_replace(removeIds[ocnt], 0);
         }
 
         sub_id = orderline.locked.push_back(static_cast<Locking>(0));
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.locked.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.locked.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.locked.atomic_replace(removeIds[ocnt], static_cast<Locking>(0));
         }
@@ -1874,7 +2264,8 @@ struct Database {
         auto ptr = new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp};
         sub_id = orderline.read_write_table.push_back(ptr);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.read_write_table.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.read_write_table.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.read_write_table.atomic_replace(removeIds[ocnt], ptr);
         }
@@ -2005,56 +2396,64 @@ struct Database {
       order_insert = order.o_id.push_back(d.d_next_o_id);
       uint64_t sub_id = order.o_d_id.push_back(neworder.d);
       if (order_insert != sub_id) {
-        while (!order.o_d_id.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.o_d_id.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.o_d_id.replace(order_insert, neworder.d);
       }
 
       sub_id = order.o_w_id.push_back(neworder.w);
       if (order_insert != sub_id) {
-        while (!order.o_w_id.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.o_w_id.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.o_w_id.replace(order_insert, neworder.w);
       }
 
       sub_id = order.o_c_id.push_back(neworder.c);
       if (order_insert != sub_id) {
-        while (!order.o_c_id.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.o_c_id.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.o_c_id.replace(order_insert, neworder.c);
       }
 
       sub_id = order.o_entry_d.push_back(time(NULL));
       if (order_insert != sub_id) {
-        while (!order.o_entry_d.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.o_entry_d.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.o_entry_d.replace(order_insert, time(NULL));
       }
 
       sub_id = order.o_ol_cnt.push_back(neworder.num);
       if (order_insert != sub_id) {
-        while (!order.o_ol_cnt.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.o_ol_cnt.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.o_ol_cnt.replace(order_insert, neworder.num);
       }
 
       sub_id = order.o_all_local.push_back(neworder.alllocal);
       if (order_insert != sub_id) {
-        while (!order.o_all_local.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.o_all_local.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.o_all_local.replace(order_insert, neworder.alllocal);
       }
 
       sub_id = order.lsn.push_back(0);
       if (order_insert != sub_id) {
-        while (!order.lsn.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.lsn.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.lsn.atomic_replace(order_insert, 0);
       }
 
       sub_id = order.locked.push_back(static_cast<Locking>(0));
       if (order_insert != sub_id) {
-        while (!order.locked.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.locked.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.locked.atomic_replace(order_insert, static_cast<Locking>(0));
       }
@@ -2062,7 +2461,8 @@ struct Database {
       auto ptr = new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp};
       sub_id = order.read_write_table.push_back(ptr);
       if (order_insert != sub_id) {
-        while (!order.read_write_table.isAlive(order_insert)) {
+        for (common::Backoff backoff; !order.read_write_table.isAlive(order_insert);) {
+          backoff.pause();
         }
         order.read_write_table.atomic_replace(order_insert, ptr);
       }
@@ -2166,49 +2566,56 @@ struct Database {
         removeIds[ocnt] = orderline.ol_o_id.push_back(d.d_next_o_id);
         uint64_t sub_id = orderline.ol_d_id.push_back(neworder.d);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.ol_d_id.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.ol_d_id.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.ol_d_id.replace(removeIds[ocnt], neworder.d);
         }
 
         sub_id = orderline.ol_w_id.push_back(neworder.w);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.ol_w_id.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.ol_w_id.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.ol_w_id.replace(removeIds[ocnt], neworder.w);
         }
 
         sub_id = orderline.ol_number.push_back(ocnt);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.ol_number.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.ol_number.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.ol_number.replace(removeIds[ocnt], ocnt);
         }
 
         sub_id = orderline.ol_i_id.push_back(neworder.items[ocnt]);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.ol_i_id.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.ol_i_id.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.ol_i_id.replace(removeIds[ocnt], neworder.items[ocnt]);
         }
 
         sub_id = orderline.ol_supply_w_id.push_back(neworder.suppliers[ocnt]);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.ol_supply_w_id.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.ol_supply_w_id.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.ol_supply_w_id.replace(removeIds[ocnt], neworder.suppliers[ocnt]);
         }
 
         sub_id = orderline.ol_quantity.push_back(neworder.quantities[ocnt]);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.ol_quantity.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.ol_quantity.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.ol_quantity.replace(removeIds[ocnt], neworder.quantities[ocnt]);
         }
 
         sub_id = orderline.ol_amount.push_back((double)(neworder.quantities[ocnt]) * i.i_price);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.ol_amount.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.ol_amount.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.ol_amount.replace(removeIds[ocnt], (double)(neworder.quantities[ocnt]) * i.i_price);
         }
@@ -2249,21 +2656,24 @@ struct Database {
 
         sub_id = orderline.ol_dist_info.push_back(ol_dist_info);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.ol_dist_info.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.ol_dist_info.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.ol_dist_info.replace(removeIds[ocnt], ol_dist_info);
         }
 
         sub_id = orderline.lsn.push_back(0);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.lsn.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.lsn.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.lsn.atomic_replace(removeIds[ocnt], 0);
         }
 
         sub_id = orderline.locked.push_back(static_cast<Locking>(0));
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.locked.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.locked.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.locked.atomic_replace(removeIds[ocnt], static_cast<Locking>(0));
         }
@@ -2271,7 +2681,8 @@ struct Database {
         auto ptr = new atom::AtomicSinglyLinkedList<uint64_t>{&ca, &emp};
         sub_id = orderline.read_write_table.push_back(ptr);
         if (removeIds[ocnt] != sub_id) {
-          while (!orderline.read_write_table.isAlive(removeIds[ocnt])) {
+          for (common::Backoff backoff; !orderline.read_write_table.isAlive(removeIds[ocnt]);) {
+            backoff.pause();
           }
           orderline.read_write_table.atomic_replace(removeIds[ocnt], ptr);
         }
@@ -2325,6 +2736,326 @@ struct Database {
     return returnValue;
   };
 
+  // reads the columns copied by read(value, column) from the row at offset at once, i.e., consistent with each other
+  template <bool MultiReadPossible, typename Table, typename Func>
+  bool readRow(Table& table, uint64_t offset, uint64_t transaction, Func&& read) {
+    if constexpr (MultiReadPossible) {
+      sv::ReadGuard<TC, Locking, atom::AtomicExtentVector, atom::AtomicSinglyLinkedList> rg{
+          &tc, table.lsn, table.read_write_table, table.locked, offset, transaction};
+      if (!rg.wasSuccessful())
+        return false;
+      read([&](auto& value, auto& column) { value = column[offset]; });
+    } else {
+      bool check = false;
+      while (!check) {
+        auto ret = tc.read(table.lsn, table.read_write_table, table.locked, offset, transaction);
+        if (ret == std::numeric_limits<uint64_t>::max())
+          return false;
+        read([&](auto& value, auto& column) {
+          tc.pureValue(value, column, table.lsn, table.read_write_table, table.locked, offset, transaction);
+        });
+        check = tc.readUndo(ret, table.lsn, table.read_write_table, table.locked, offset, transaction);
+      }
+    }
+    return true;
+  }
+
+  // looks up a customer by id or by last name, of all customers with the name the middle one is selected
+  bool lookupCustomer(bool by_lastname, StringStruct<16>& lastname, int64_t c, int64_t d, int64_t w, uint64_t& offset) {
+    if (by_lastname) {
+      std::vector<uint64_t> offsetv;
+      int64_t ck = custNPKey(lastname.string, d, w);
+      bool found = customer.opl->lookup(ck, offsetv, *customer_last_map,
+                                        [](auto& cmap, auto& o, auto& w) { return cmap.lookup(w, o); });
+      if (!found || offsetv.empty())
+        return false;
+
+      int index = offsetv.size() / 2;
+      if (offsetv.size() % 2 == 0) {
+        index -= 1;
+      }
+      offset = offsetv[index];
+      return true;
+    }
+    int64_t ck = custKey(c, d, w);
+    return customer.opl->lookup(ck, offset, *customer_id_map,
+                                [](auto& cmap, auto& o, auto& w) { return cmap.lookup(w, o); });
+  }
+
+  struct OrderStatusVar {
+    int64_t w, d, c;
+    StringStruct<16> lastname;
+    bool by_lastname;
+  };
+
+  void genOrderStatus(OrderStatusVar& orderstatus, uint32_t core_id, std::mt19937& gen) {
+    std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
+    orderstatus.w = core_id % number_warehouses + 1;
+    orderstatus.d = dis(gen) % dist_per_warehouse + 1;
+    if (dis(gen) % 100 < 60) {
+      orderstatus.by_lastname = true;
+      getLastname(nonUniformRandom(255, 223, 0, 999, gen), orderstatus.lastname.string);
+    } else {
+      orderstatus.by_lastname = false;
+      orderstatus.c = nonUniformRandom(1023, 259, 1, cust_per_dist, gen);
+    }
+  }
+
+  // reads the balance of a customer and the order lines of its latest order
+  template <bool MultiReadPossible>
+  int execOrderStatus(OrderStatusVar& orderstatus,
+                      SinglyCustomer& c,
+                      SinglyOrder& o,
+                      SinglyOrderLine& ol,
+                      uint64_t transaction) {
+    uint64_t offset;
+    if (!lookupCustomer(orderstatus.by_lastname, orderstatus.lastname, orderstatus.c, orderstatus.d, orderstatus.w,
+                        offset))
+      return 0;
+
+    bool check = readRow<MultiReadPossible>(customer, offset, transaction, [&](auto&& read) {
+      read(c.c_id, customer.c_id);
+      read(c.c_balance, customer.c_balance);
+      read(c.c_first, customer.c_first);
+      read(c.c_middle, customer.c_middle);
+      read(c.c_last, customer.c_last);
+    });
+    if (!check)
+      return -1;
+
+    int64_t ck = custKey(c.c_id, orderstatus.d, orderstatus.w);
+    bool found = order.opl->lookup(ck, offset, *customer_order_map,
+                                   [](auto& omap, auto& o, auto& k) { return omap.lookup(k, o); });
+    if (!found)
+      return 0;
+
+    check = readRow<MultiReadPossible>(order, offset, transaction, [&](auto&& read) {
+      read(o.o_id, order.o_id);
+      read(o.o_entry_d, order.o_entry_d);
+      read(o.o_carrier_id, order.o_carrier_id);
+      read(o.o_ol_cnt, order.o_ol_cnt);
+    });
+    if (!check)
+      return -1;
+
+    for (int64_t number = 1; number <= o.o_ol_cnt; ++number) {
+      int64_t olk = orderLineKey(orderstatus.w, orderstatus.d, o.o_id, number);
+      found = orderline.opl->lookup(olk, offset, *orderline_map,
+                                    [](auto& omap, auto& o, auto& k) { return omap.lookup(k, o); });
+      if (!found)
+        return 0;
+
+      check = readRow<MultiReadPossible>(orderline, offset, transaction, [&](auto&& read) {
+        read(ol.ol_i_id, orderline.ol_i_id);
+        read(ol.ol_supply_w_id, orderline.ol_supply_w_id);
+        read(ol.ol_quantity, orderline.ol_quantity);
+        read(ol.ol_amount, orderline.ol_amount);
+        read(ol.ol_delivery_d, orderline.ol_delivery_d);
+      });
+      if (!check)
+        return -1;
+    }
+    return 1;
+  }
+
+  struct DeliveryVar {
+    int64_t w, carrier;
+  };
+
+  void genDelivery(DeliveryVar& delivery, uint32_t core_id, std::mt19937& gen) {
+    std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
+    delivery.w = core_id % number_warehouses + 1;
+    delivery.carrier = dis(gen) % 10 + 1;
+  }
+
+  /*
+   * Delivers the oldest new order of every district of the warehouse: the new order is written (instead of deleted),
+   * the order gets the carrier, its order lines the delivery date and the customer the sum of their amounts. New orders
+   * are not inserted (NewOrder only inserts orders with insert_), hence the loaded new orders of a district form a
+   * ring and are delivered again after a full round. The next one is the district column d_next_delivery_o_id, read
+   * and advanced inside the transaction, hence concurrent deliveries of the same district conflict on it.
+   */
+  template <bool MultiReadPossible>
+  int execDelivery(DeliveryVar& delivery,
+                   SinglyDistrict& dist,
+                   SinglyNewOrder& no,
+                   SinglyOrder& o,
+                   SinglyOrderLine& ol,
+                   SinglyCustomer& c,
+                   uint64_t transaction) {
+    int64_t now = time(NULL);
+    for (uint64_t d = 1; d <= dist_per_warehouse; ++d) {
+      uint64_t offset;
+      int64_t dk = distKey(d, delivery.w);
+      bool found = district.opl->lookup(dk, offset, *district_map,
+                                        [](auto& dmap, auto& o, auto& k) { return dmap.lookup(k, o); });
+      if (!found)
+        return 0;
+
+      bool check = readRow<MultiReadPossible>(district, offset, transaction, [&](auto&& read) {
+        read(dist.d_next_delivery_o_id, district.d_next_delivery_o_id);
+      });
+      if (!check)
+        return -1;
+      int64_t o_id = dist.d_next_delivery_o_id;
+      dist.d_next_delivery_o_id = (static_cast<uint64_t>(o_id) < cust_per_dist) ? o_id + 1 : 2101;
+      if (!tc.writeValue(dist.d_next_delivery_o_id, district.d_next_delivery_o_id, district.lsn,
+                         district.read_write_table, district.locked, offset, transaction))
+        return -1;
+
+      int64_t nok = orderPrimaryKey(delivery.w, d, o_id);
+      found = neworder.opl->lookup(nok, offset, *neworder_map,
+                                   [](auto& nmap, auto& o, auto& k) { return nmap.lookup(k, o); });
+      if (!found)
+        continue;
+
+      check = readRow<MultiReadPossible>(neworder, offset, transaction,
+                                         [&](auto&& read) { read(no.no_o_id, neworder.no_o_id); });
+      if (!check)
+        return -1;
+      if (!tc.writeValue(no.no_o_id, neworder.no_o_id, neworder.lsn, neworder.read_write_table, neworder.locked,
+                         offset, transaction))
+        return -1;
+
+      found =
+          order.opl->lookup(nok, offset, *order_map, [](auto& omap, auto& o, auto& k) { return omap.lookup(k, o); });
+      if (!found)
+        return 0;
+
+      check = readRow<MultiReadPossible>(order, offset, transaction, [&](auto&& read) {
+        read(o.o_c_id, order.o_c_id);
+        read(o.o_ol_cnt, order.o_ol_cnt);
+      });
+      if (!check)
+        return -1;
+      o.o_carrier_id = delivery.carrier;
+      if (!tc.writeValue(o.o_carrier_id, order.o_carrier_id, order.lsn, order.read_write_table, order.locked, offset,
+                         transaction))
+        return -1;
+
+      double amount = 0;
+      for (int64_t number = 1; number <= o.o_ol_cnt; ++number) {
+        int64_t olk = orderLineKey(delivery.w, d, o_id, number);
+        found = orderline.opl->lookup(olk, offset, *orderline_map,
+                                      [](auto& omap, auto& o, auto& k) { return omap.lookup(k, o); });
+        if (!found)
+          return 0;
+
+        check = readRow<MultiReadPossible>(orderline, offset, transaction,
+                                           [&](auto&& read) { read(ol.ol_amount, orderline.ol_amount); });
+        if (!check)
+          return -1;
+        amount += ol.ol_amount;
+        ol.ol_delivery_d = now;
+        if (!tc.writeValue(ol.ol_delivery_d, orderline.ol_delivery_d, orderline.lsn, orderline.read_write_table,
+                           orderline.locked, offset, transaction))
+          return -1;
+      }
+
+      int64_t ck = custKey(o.o_c_id, d, delivery.w);
+      found = customer.opl->lookup(ck, offset, *customer_id_map,
+                                   [](auto& cmap, auto& o, auto& k) { return cmap.lookup(k, o); });
+      if (!found)
+        return 0;
+
+      check = readRow<MultiReadPossible>(customer, offset, transaction, [&](auto&& read) {
+        read(c.c_balance, customer.c_balance);
+        read(c.c_delivery_cnt, customer.c_delivery_cnt);
+      });
+      if (!check)
+        return -1;
+      c.c_balance += amount;
+      c.c_delivery_cnt++;
+      check = tc.writeValue(c.c_balance, customer.c_balance, customer.lsn, customer.read_write_table, customer.locked,
+                            offset, transaction);
+      check &= tc.writeValue(c.c_delivery_cnt, customer.c_delivery_cnt, customer.lsn, customer.read_write_table,
+                             customer.locked, offset, transaction);
+      if (!check)
+        return -1;
+    }
+    return 1;
+  }
+
+  struct StockLevelVar {
+    int64_t w, d, threshold;
+    uint64_t low_stock;
+  };
+
+  void genStockLevel(StockLevelVar& stocklevel, uint32_t core_id, std::mt19937& gen) {
+    std::uniform_int_distribution<unsigned int> dis(0, std::numeric_limits<unsigned int>::max());
+    stocklevel.w = core_id % number_warehouses + 1;
+    stocklevel.d = dis(gen) % dist_per_warehouse + 1;
+    stocklevel.threshold = dis(gen) % 11 + 10;
+  }
+
+  /*
+   * Counts the distinct items of the last 20 orders of a district whose stock is below the threshold. The order lines
+   * of the orders NewOrder adds are not indexed, the recent order ids therefore wrap around the loaded orders.
+   */
+  template <bool MultiReadPossible>
+  int execStockLevel(StockLevelVar& stocklevel, SinglyDistrict& d, std::vector<int64_t>& items, uint64_t transaction) {
+    uint64_t offset;
+    int64_t dk = distKey(stocklevel.d, stocklevel.w);
+    bool found =
+        district.opl->lookup(dk, offset, *district_map, [](auto& dmap, auto& o, auto& k) { return dmap.lookup(k, o); });
+    if (!found)
+      return 0;
+
+    bool check = readRow<MultiReadPossible>(district, offset, transaction,
+                                            [&](auto&& read) { read(d.d_next_o_id, district.d_next_o_id); });
+    if (!check)
+      return -1;
+
+    items.clear();
+    for (int64_t o_id = std::max<int64_t>(d.d_next_o_id - 20, 1); o_id < d.d_next_o_id; ++o_id) {
+      int64_t stored = (o_id - 1) % cust_per_dist + 1;
+      int64_t ok = orderPrimaryKey(stocklevel.w, stocklevel.d, stored);
+      found = order.opl->lookup(ok, offset, *order_map, [](auto& omap, auto& o, auto& k) { return omap.lookup(k, o); });
+      if (!found)
+        continue;
+
+      int8_t ol_cnt;
+      check = readRow<MultiReadPossible>(order, offset, transaction,
+                                         [&](auto&& read) { read(ol_cnt, order.o_ol_cnt); });
+      if (!check)
+        return -1;
+
+      for (int64_t number = 1; number <= ol_cnt; ++number) {
+        int64_t olk = orderLineKey(stocklevel.w, stocklevel.d, stored, number);
+        found = orderline.opl->lookup(olk, offset, *orderline_map,
+                                      [](auto& omap, auto& o, auto& k) { return omap.lookup(k, o); });
+        if (!found)
+          return 0;
+
+        int64_t i_id;
+        check = readRow<MultiReadPossible>(orderline, offset, transaction,
+                                           [&](auto&& read) { read(i_id, orderline.ol_i_id); });
+        if (!check)
+          return -1;
+        items.push_back(i_id);
+      }
+    }
+
+    std::sort(items.begin(), items.end());
+    items.erase(std::unique(items.begin(), items.end()), items.end());
+
+    stocklevel.low_stock = 0;
+    for (auto i_id : items) {
+      int64_t sk = stockKey(i_id, stocklevel.w);
+      found = stock.opl->lookup(sk, offset, *stock_map, [](auto& smap, auto& o, auto& k) { return smap.lookup(k, o); });
+      if (!found)
+        return 0;
+
+      int8_t quantity;
+      check = readRow<MultiReadPossible>(stock, offset, transaction,
+                                         [&](auto&& read) { read(quantity, stock.s_quantity); });
+      if (!check)
+        return -1;
+      stocklevel.low_stock += quantity < stocklevel.threshold;
+    }
+    return 1;
+  }
+
   void getNumberString(uint32_t sid, char* stringstruct, uint32_t length) {
     for (uint64_t i = 0; i < length; i++)
       stringstruct[i] = '0';
@@ -21,6 +21,7 @@
 //
 
 #pragma once
+#include "common/backoff.hpp"
 #include "common/global_logger.hpp"
 #include "ds/atomic_unordered_map.hpp"
 #include <algorithm>
@@ -102,6 +103,7 @@ class LockManager {
 
   bool lock(uint64_t transaction, bool exclusive, void* table, uint64_t row) {
     bool inserted = false;
+    common::Backoff backoff;
     atom::EpochGuard<EMB, EM> eg{emb_};
     while (!inserted) {
       LockTable* table_lock_ptr;
@@ -132,12 +134,14 @@ class LockManager {
           } else {
             if (mutex_ptr->first != 0 && mutex_ptr->first != transaction) {
               if (waitDie(transaction, exclusive, mutex_ptr)) {
+                backoff.pause();
                 continue;
               } else {
                 return false;
               }
             } else if (mutex_ptr->second.size() > 1 && exclusive) {
               if (waitDie(transaction, exclusive, mutex_ptr)) {
+                backoff.pause();
                 continue;
               } else {
                 return false;
@@ -147,6 +151,7 @@ class LockManager {
                                       [=](uint64_t t) { return t == transaction; });
               if (pos == mutex_ptr->second.end()) {
                 if (waitDie(transaction, exclusive, mutex_ptr)) {
+                  backoff.pause();
                   continue;
                 } else {
                   return false;
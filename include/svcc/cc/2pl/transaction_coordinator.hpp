@@ -21,6 +21,7 @@
 //
 
 #pragma once
+#include "common/abort_reason.hpp"
 #include "common/chunk_allocator.hpp"
 #include "common/epoch_manager.hpp"
 #include "ds/atomic_singly_linked_list.hpp"
@@ -56,6 +57,7 @@ class TransactionCoordinator {
  private:
   Allocator* alloc_;
   atom::EpochManagerBase<Allocator>* emb_;
+  common::RedoLog* redo_log_ = nullptr;
   common::StdAllocator* std_alloc_;
   atom::EpochManagerBase<common::StdAllocator>* std_emb_;
 
@@ -64,7 +66,7 @@ class TransactionCoordinator {
 
   static thread_local std::atomic<uint64_t> transaction_counter_;
   static thread_local std::unordered_set<uint64_t> not_alive_;
-  static thread_local uint8_t current_core_;
+  static thread_local uint16_t current_core_;
   static thread_local atom::AtomicSinglyLinkedList<TransactionInformationBase<Allocator>*>* atom_info_;
   static thread_local atom::EpochGuard<atom::EpochManagerBase<Allocator>, atom::EpochManager<Allocator>>* eg_;
 
@@ -77,6 +79,9 @@ class TransactionCoordinator {
         lock_manager_(std_alloc_, std_emb_, 10, 100000),
         mut(){};
 
+  /* Commits are only acknowledged once their write set is durable in the redo log */
+  inline void setRedoLog(common::RedoLog* redo_log) { redo_log_ = redo_log; }
+
   /* The highest bit is used to determine read or write accesses the lower 63 for the actual transaction id */
   /* Returns the encoded bitstring for a given transaction and there action */
   inline static constexpr uint64_t access(const uint64_t transaction, const bool rw) {
@@ -124,6 +129,7 @@ class TransactionCoordinator {
 #endif
 
     if (!no_abort_needed) {
+      common::AbortReasons::set(common::AbortReason::WaitDie, &rw_table);
       this->abort(transaction);
       return false;
     }
@@ -165,6 +171,7 @@ class TransactionCoordinator {
 #endif
 
     if (!no_abort_needed) {
+      common::AbortReasons::set(common::AbortReason::WaitDie, &rw_table);
       this->abort(transaction);
       return false;
     }
@@ -218,6 +225,7 @@ class TransactionCoordinator {
 #endif
 
       if (!no_abort_needed) {
+        common::AbortReasons::set(common::AbortReason::WaitDie, &rw_table);
         this->abort(transaction);
         return false;
       }
@@ -249,11 +257,16 @@ class TransactionCoordinator {
 
     // std::cout << transaction << " is done!" << std::endl;
 
+    // the compensation record has to precede every later writer of the restored rows
+    uint64_t lsn = redo_log_ != nullptr && redo_log_->logAborts() ? redo_log_->reserve() : 0;
     for (auto t : *atom_info_) {
       if (!t->isWriteTransaction() || t->isAbort())
         continue;
       t->writeValue(*this);
     }
+    if (lsn != 0) {
+      redo_log_->abort(*atom_info_, lsn);
+    }
 
 #ifdef LOGGER
     lock_manager_.log(common::LogInfo{transaction, 0, 0, 0, 'a'});
@@ -294,6 +307,10 @@ class TransactionCoordinator {
     lock_manager_.log(common::LogInfo{transaction, 0, 0, 0, 'c'});
 #endif
 
+    if (redo_log_ != nullptr) {
+      redo_log_->commit(*atom_info_, true);
+    }
+
     for (auto t : *atom_info_) {
       t->unlock(&lock_manager_);
       t->deleteFromRWTable();
@@ -309,13 +326,13 @@ class TransactionCoordinator {
 
   inline uint64_t start() {
     auto tc = transaction_counter_.fetch_add(1) + 1;
-    if (current_core_ == std::numeric_limits<uint8_t>::max()) {
+    if (current_core_ == std::numeric_limits<uint16_t>::max()) {
       current_core_ = sched_getcpu();
     }
     uint64_t core = current_core_;
-    verify(core <= 127);
-    tc &= 0x00FFFFFFFFFFFFFF;
-    tc |= (core << 56);
+    verify(core <= 2047);
+    tc &= 0x000FFFFFFFFFFFFF;
+    tc |= (core << 52);
 
     atom_info_ = new atom::AtomicSinglyLinkedList<TransactionInformationBase<Allocator>*>(alloc_, emb_);
     eg_ = new atom::EpochGuard<atom::EpochManagerBase<Allocator>, atom::EpochManager<Allocator>>(emb_);
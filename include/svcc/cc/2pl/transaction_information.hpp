@@ -21,6 +21,7 @@
 //
 
 #pragma once
+#include "common/redo_log.hpp"
 #include "ds/atomic_unordered_map.hpp"
 #include "svcc/cc/2pl/lock_manager.hpp"
 #include <atomic>
@@ -44,6 +45,8 @@ class TransactionInformationBase {
   virtual bool isAbort() = 0;
   virtual void unlock(LockManager<common::StdAllocator>* lm) = 0;
   virtual void deallocate(Allocator* alloc) = 0;
+  virtual void redo(common::RedoLog& log) {}
+  virtual void undo(common::RedoLog& log) {}
   bool isWriteTransaction() { return write_transaction_; };
 
   TransactionInformationBase(bool write_transaction) : write_transaction_(write_transaction) {}
@@ -87,6 +90,11 @@ class WriteTransactionInformation : public TransactionInformationBase<Allocator>
   void writeValue(TransactionCoordinator<Allocator>& tc);
   bool isAbort();
   void deallocate(Allocator* alloc);
+  void redo(common::RedoLog& log) { log.append(&column_, offset_, data_); }
+  void undo(common::RedoLog& log) {
+    if (!isAbort())
+      log.append(&column_, offset_, data_prv_);
+  }
   void unlock(LockManager<common::StdAllocator>* lm);
 
  private:
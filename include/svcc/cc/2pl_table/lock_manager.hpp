@@ -21,6 +21,7 @@
 //
 
 #pragma once
+#include "common/backoff.hpp"
 #include "common/global_logger.hpp"
 #include "ds/atomic_unordered_map.hpp"
 #include <algorithm>
@@ -83,6 +84,7 @@ class LockManager {
             uint64_t row,
             std::unordered_set<uint64_t>& abort_transaction) {
     bool inserted = false;
+    common::Backoff backoff;
     atom::EpochGuard<EMB, EM> eg{emb_};
     void* addr = alloc_->template allocate<std::pair<uint64_t, std::set<uint64_t>>>(1);
     while (!inserted) {
@@ -91,6 +93,7 @@ class LockManager {
       if (mutex_ptr != nullptr) {
         if (mutex_ptr->first != 0 && mutex_ptr->first != transaction) {
           if (waitDie(transaction, exclusive, mutex_ptr)) {
+            backoff.pause();
             continue;
           } else {
             abort_transaction.insert(mutex_ptr->first);
@@ -99,6 +102,7 @@ class LockManager {
           }
         } else if (mutex_ptr->second.size() > 1 && exclusive) {
           if (waitDie(transaction, exclusive, mutex_ptr)) {
+            backoff.pause();
             continue;
           } else {
             for (auto i : mutex_ptr->second)
@@ -111,6 +115,7 @@ class LockManager {
                                   [=](uint64_t t) { return t == transaction; });
           if (pos == mutex_ptr->second.end()) {
             if (waitDie(transaction, exclusive, mutex_ptr)) {
+              backoff.pause();
               continue;
             } else {
               abort_transaction.insert(*mutex_ptr->second.begin());
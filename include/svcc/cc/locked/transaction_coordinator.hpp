@@ -21,6 +21,8 @@
 //
 
 #pragma once
+#include "common/abort_reason.hpp"
+#include "common/backoff.hpp"
 #include "common/chunk_allocator.hpp"
 #include "common/epoch_manager.hpp"
 #include "ds/atomic_singly_linked_list.hpp"
@@ -28,8 +30,10 @@
 #include "ds/atomic_unordered_set.hpp"
 #include "svcc/cc/locked/serialization_graph.hpp"
 #include "svcc/cc/locked/transaction_information.hpp"
+#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <functional>
 #include <iostream>
 #include <list>
 #include <memory>
@@ -62,11 +66,12 @@ class TransactionCoordinator {
   serial::SerializationGraph sg_;
   Allocator* alloc_;
   atom::EpochManagerBase<Allocator>* emb_;
+  common::RedoLog* redo_log_ = nullptr;
   tbb::spin_mutex mut;
 
   static thread_local std::atomic<uint64_t> transaction_counter_;
   static thread_local std::unordered_set<uint64_t> not_alive_;
-  static thread_local uint8_t current_core_;
+  static thread_local uint16_t current_core_;
   static thread_local std::unordered_set<uint64_t> abort_transaction_;
   static thread_local std::list<TransactionInformationBase<Allocator>*>* atom_info_;
 
@@ -74,6 +79,9 @@ class TransactionCoordinator {
   TransactionCoordinator(Allocator* alloc, atom::EpochManagerBase<Allocator>* emb, bool online = false)
       : sg_(alloc, emb), alloc_(alloc), emb_(emb), mut(){};
 
+  /* Commits are only acknowledged once their write set is durable in the redo log */
+  inline void setRedoLog(common::RedoLog* redo_log) { redo_log_ = redo_log; }
+
   /* The highest bit is used to determine read or write accesses the lower 63 for the actual transaction id */
   /* Returns the encoded bitstring for a given transaction and there action */
   inline static constexpr uint64_t access(const uint64_t transaction, const bool rw) {
@@ -123,9 +131,8 @@ class TransactionCoordinator {
        * for loop is only evaluated positive iff the transaction id was set beforehand and the vector operation is
        * already finished.
        */
-      for (uint32_t i = 0; lsn_column[offset] != prv; i++) {
-        if (i >= 10000)
-          std::this_thread::yield();
+      for (common::Backoff backoff; lsn_column[offset] != prv;) {
+        backoff.pause();
       }
     }
 
@@ -153,6 +160,7 @@ class TransactionCoordinator {
 #endif
 
     if (cyclic) {
+      common::AbortReasons::set(common::AbortReason::ReadCycle, &rw_table);
       lsn_column.atomic_replace(offset, prv + 1);
       this->abort(transaction);
       rw_table[offset]->erase(prv);
@@ -200,9 +208,8 @@ class TransactionCoordinator {
        * for loop is only evaluated positive iff the transaction id was set beforehand and the vector operation is
        * already finished.
        */
-      for (uint32_t i = 0; lsn_column[offset] != prv; i++) {
-        if (i >= 10000)
-          std::this_thread::yield();
+      for (common::Backoff backoff; lsn_column[offset] != prv;) {
+        backoff.pause();
       }
     }
 
@@ -230,6 +237,7 @@ class TransactionCoordinator {
 #endif
 
     if (cyclic) {
+      common::AbortReasons::set(common::AbortReason::ReadCycle, &rw_table);
       lsn_column.atomic_replace(offset, prv + 1);
       this->abort(transaction);
       rw_table[offset]->erase(prv);
@@ -282,6 +290,7 @@ class TransactionCoordinator {
     }
 
     if (!abort && sg_.needsAbort(transaction)) {
+      common::AbortReasons::set(common::AbortReason::Cascading, &rw_table);
       this->abort(transaction);
       return false;
     }
@@ -298,9 +307,8 @@ class TransactionCoordinator {
        * for loop is only evaluated positive iff the transaction id was set beforehand and the vector operation is
        * already finished.
        */
-      for (auto i = 0; lsn_column[offset] != prv; i++) {
-        if (i >= 10000)
-          std::this_thread::yield();
+      for (common::Backoff backoff; lsn_column[offset] != prv;) {
+        backoff.pause();
       }
     }
 
@@ -314,6 +322,7 @@ class TransactionCoordinator {
       if (it_wait.getId() < prv && std::get<1>(find(*it_wait)) && std::get<0>(find(*it_wait)) != transaction) {
         if (!sg_.isCommited(std::get<0>(find(*it_wait)))) {
           if (!sg_.insert_and_check(transaction, std::get<0>(find(*it_wait))) || sg_.cycleCheckExternal(transaction)) {
+            common::AbortReasons::set(common::AbortReason::WriteCycle, &rw_table);
             lsn_column.atomic_replace(offset, prv + 1);
             this->abort(transaction);
             rw_table[offset]->erase(prv);
@@ -356,6 +365,7 @@ class TransactionCoordinator {
 #endif
 
       if (!abort && cyclic) {
+        common::AbortReasons::set(common::AbortReason::WriteCycle, &rw_table);
         lsn_column.atomic_replace(offset, prv + 1);
         this->abort(transaction);
         rw_table[offset]->erase(prv);
@@ -388,11 +398,16 @@ class TransactionCoordinator {
      */
     not_alive_.insert(transaction);
 
+    // the compensation record has to precede every later writer of the restored rows
+    uint64_t lsn = redo_log_ != nullptr && redo_log_->logAborts() ? redo_log_->reserve() : 0;
     for (auto t : *atom_info_) {
       if (!t->isWriteTransaction() || t->isAbort())
         continue;
       t->writeValue(*this);
     }
+    if (lsn != 0) {
+      redo_log_->abort(*atom_info_, lsn);
+    }
 
 #ifdef LOGGER
     mut.lock();
@@ -424,7 +439,15 @@ class TransactionCoordinator {
      * Otherwise, wait and yield for the other transactions having committed or aborted.
      */
 
-    auto i = 0;
+    // the lsn is reserved once all predecessors committed and before any successor can, i.e., in commit order;
+    // transactions without writes are not logged
+    uint64_t lsn = 0;
+    std::function<void()> committing;
+    if (redo_log_ != nullptr &&
+        std::any_of(atom_info_->begin(), atom_info_->end(), [](auto t) { return t->isWriteTransaction(); })) {
+      committing = [this, &lsn]() { lsn = redo_log_->reserve(); };
+    }
+    common::Backoff backoff;
     bool all_pending_transactions_commited = false;
     while (!all_pending_transactions_commited) {
       auto not_alive = not_alive_.find(transaction);
@@ -441,18 +464,20 @@ class TransactionCoordinator {
 #ifdef LOGGER
         mut.unlock();
 #endif
+        common::AbortReasons::set(sg_.needsAbort(transaction) ? common::AbortReason::Cascading
+                                                               : common::AbortReason::CommitCycle);
         this->abort(transaction);
         not_alive_.erase(transaction);
         oset = abort_transaction_;
         return false;
       }
 
-      all_pending_transactions_commited = sg_.checkCommited(transaction);
+      all_pending_transactions_commited = sg_.checkCommited(transaction, committing);
 #ifdef LOGGER
       mut.unlock();
 #endif
-      if (i >= 10000) {
-        std::this_thread::yield();
+      if (!all_pending_transactions_commited) {
+        backoff.pause();
       }
       // if (i > 0 && i % 5000 == 0) {
       // sg_.print();
@@ -460,7 +485,10 @@ class TransactionCoordinator {
       // not_alive_.erase(transaction);
       // return false;
       //}
-      ++i;
+    }
+
+    if (redo_log_ != nullptr) {
+      redo_log_->commit(*atom_info_, true, lsn);
     }
 
     /*
@@ -478,12 +506,12 @@ class TransactionCoordinator {
 
   inline uint64_t start() {
     auto tc = transaction_counter_.fetch_add(1) + 1;
-    if (current_core_ == std::numeric_limits<uint8_t>::max()) {
+    if (current_core_ == std::numeric_limits<uint16_t>::max()) {
       current_core_ = sched_getcpu();
     }
     uint64_t core = current_core_;
-    tc &= 0x00FFFFFFFFFFFFFF;
-    tc |= (core << 56);
+    tc &= 0x000FFFFFFFFFFFFF;
+    tc |= (core << 52);
 
     atom_info_ = new std::list<TransactionInformationBase<Allocator>*>();
     abort_transaction_.clear();
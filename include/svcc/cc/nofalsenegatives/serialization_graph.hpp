@@ -28,6 +28,7 @@
 #include "ds/atomic_unordered_map.hpp"
 #include "ds/atomic_unordered_set.hpp"
 #include <algorithm>
+#include <functional>
 #include <queue>
 #include <sstream>
 #include <thread>
@@ -141,8 +142,10 @@ class SerializationGraph {
   bool needsAbort(uintptr_t node);
   bool isCommited(uintptr_t node);
   void abort(std::unordered_set<uint64_t>& uset);
-  bool checkCommited();
-  bool erase_graph_constraints();
+  // committing runs once the transaction passed all checks and before it is visible as committed, i.e., before any
+  // successor can commit, e.g., to reserve the redo log lsn in commit order
+  bool checkCommited(const std::function<void()>& committing = nullptr);
+  bool erase_graph_constraints(const std::function<void()>& committing = nullptr);
   std::string generateString();
   void print();
   void log(const common::LogInfo log_info);
@@ -21,6 +21,8 @@
 //
 
 #pragma once
+#include "common/abort_reason.hpp"
+#include "common/backoff.hpp"
 #include "common/chunk_allocator.hpp"
 #include "common/epoch_manager.hpp"
 #include "ds/atomic_singly_linked_list.hpp"
@@ -28,9 +30,11 @@
 #include "ds/atomic_unordered_set.hpp"
 #include "svcc/cc/nofalsenegatives/serialization_graph.hpp"
 #include "svcc/cc/nofalsenegatives/transaction_information.hpp"
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <chrono>
+#include <functional>
 #include <iostream>
 #include <list>
 #include <map>
@@ -67,11 +71,12 @@ class TransactionCoordinator {
   serial::SerializationGraph sg_;
   Allocator* alloc_;
   atom::EpochManagerBase<Allocator>* emb_;
+  common::RedoLog* redo_log_ = nullptr;
   tbb::spin_mutex mut;
 
   static thread_local std::atomic<uint64_t> transaction_counter_;
   static thread_local std::unordered_set<uint64_t> not_alive_;
-  static thread_local uint8_t current_core_;
+  static thread_local uint16_t current_core_;
   static thread_local std::unordered_set<uint64_t> abort_transaction_;
   static thread_local std::list<TransactionInformationBase<Allocator>*>* atom_info_;
   static thread_local atom::EpochGuard<atom::EpochManagerBase<Allocator>, atom::EpochManager<Allocator>>* eg_;
@@ -80,6 +85,9 @@ class TransactionCoordinator {
   TransactionCoordinator(Allocator* alloc, atom::EpochManagerBase<Allocator>* emb, bool online = false)
       : sg_(alloc, emb, online), alloc_(alloc), emb_(emb), mut(){};
 
+  /* Commits are only acknowledged once their write set is durable in the redo log */
+  inline void setRedoLog(common::RedoLog* redo_log) { redo_log_ = redo_log; }
+
   /* The highest bit is used to determine read or write accesses the lower 63 for the actual transaction id */
   /* Returns the encoded bitstring for a given transaction and there action */
   inline static constexpr uint64_t access(const uint64_t transaction, const bool rw) {
@@ -118,6 +126,7 @@ class TransactionCoordinator {
     }
 
     if (sg_.needsAbort(transaction)) {
+      common::AbortReasons::set(common::AbortReason::Cascading, &rw_table);
       this->abort(transaction);
       return false;
     }
@@ -134,9 +143,8 @@ class TransactionCoordinator {
        * for loop is only evaluated positive iff the transaction id was set beforehand and the vector operation is
        * already finished.
        */
-      for (uint32_t i = 0; lsn_column[offset] != prv; i++) {
-        if (i >= 10000)
-          std::this_thread::yield();
+      for (common::Backoff backoff; lsn_column[offset] != prv;) {
+        backoff.pause();
       }
     }
 
@@ -156,6 +164,7 @@ class TransactionCoordinator {
 #endif
 
     if (cyclic) {
+      common::AbortReasons::set(common::AbortReason::ReadCycle, &rw_table);
       rw_table[offset]->erase(prv);
       lsn_column.atomic_replace(offset, prv + 1);
       this->abort(transaction);
@@ -192,6 +201,7 @@ class TransactionCoordinator {
     }
 
     if (sg_.needsAbort(transaction)) {
+      common::AbortReasons::set(common::AbortReason::Cascading, &rw_table);
       this->abort(transaction);
       return false;
     }
@@ -208,9 +218,8 @@ class TransactionCoordinator {
        * for loop is only evaluated positive iff the transaction id was set beforehand and the vector operation is
        * already finished.
        */
-      for (uint32_t i = 0; lsn_column[offset] != prv; i++) {
-        if (i >= 10000)
-          std::this_thread::yield();
+      for (common::Backoff backoff; lsn_column[offset] != prv;) {
+        backoff.pause();
       }
     }
 
@@ -230,6 +239,7 @@ class TransactionCoordinator {
 #endif
 
     if (cyclic) {
+      common::AbortReasons::set(common::AbortReason::ReadCycle, &rw_table);
       rw_table[offset]->erase(prv);
       lsn_column.atomic_replace(offset, prv + 1);
       this->abort(transaction);
@@ -282,6 +292,7 @@ class TransactionCoordinator {
     }
 
     if (!abort && sg_.needsAbort(transaction)) {
+      common::AbortReasons::set(common::AbortReason::Cascading, &rw_table);
       this->abort(transaction);
       return false;
     }
@@ -298,9 +309,8 @@ class TransactionCoordinator {
        * for loop is only evaluated positive iff the transaction id was set beforehand and the vector operation is
        * already finished.
        */
-      for (auto i = 0; lsn_column[offset] != prv; i++) {
-        if (i >= 10000)
-          std::this_thread::yield();
+      for (common::Backoff backoff; lsn_column[offset] != prv;) {
+        backoff.pause();
       }
     }
 
@@ -326,6 +336,7 @@ class TransactionCoordinator {
     if (!abort) {
       if (cyclic) {
       cyclic_write:
+        common::AbortReasons::set(common::AbortReason::WriteCycle, &rw_table);
         rw_table[offset]->erase(prv);
         lsn_column.atomic_replace(offset, prv + 1);
         this->abort(transaction);
@@ -392,11 +403,16 @@ class TransactionCoordinator {
      */
     not_alive_.insert(transaction);
 
+    // the compensation record has to precede every later writer of the restored rows
+    uint64_t lsn = redo_log_ != nullptr && redo_log_->logAborts() ? redo_log_->reserve() : 0;
     for (auto t : *atom_info_) {
       if (!t->isWriteTransaction() || t->isAbort())
         continue;
       t->writeValue(*this);
     }
+    if (lsn != 0) {
+      redo_log_->abort(*atom_info_, lsn);
+    }
 
     sg_.abort(abort_transaction_);
 
@@ -423,6 +439,15 @@ class TransactionCoordinator {
      * Otherwise, wait and yield for the other transactions having committed or aborted.
      */
 
+    // the lsn is reserved once all predecessors committed and before any successor can, i.e., in commit order;
+    // transactions without writes are not logged
+    uint64_t lsn = 0;
+    std::function<void()> committing;
+    if (redo_log_ != nullptr &&
+        std::any_of(atom_info_->begin(), atom_info_->end(), [](auto t) { return t->isWriteTransaction(); })) {
+      committing = [this, &lsn]() { lsn = redo_log_->reserve(); };
+    }
+    common::Backoff backoff;
     bool all_pending_transactions_commited = false;
     while (!all_pending_transactions_commited) {
       auto not_alive = not_alive_.find(transaction);
@@ -433,19 +458,25 @@ class TransactionCoordinator {
       }
 
       if (sg_.needsAbort(transaction)) {
+        common::AbortReasons::set(common::AbortReason::Cascading);
         this->abort(transaction);
         not_alive_.erase(transaction);
         oset = abort_transaction_;
         return false;
       }
 
-      all_pending_transactions_commited = sg_.checkCommited();
+      all_pending_transactions_commited = sg_.checkCommited(committing);
 
       if (all_pending_transactions_commited) {
+        if (redo_log_ != nullptr) {
+          redo_log_->commit(*atom_info_, true, lsn);
+        }
         for (auto t : *atom_info_) {
           t->deleteFromRWTable();
           t->deallocate(alloc_);
         }
+      } else {
+        backoff.pause();
       }
     }
 
@@ -457,12 +488,12 @@ class TransactionCoordinator {
 
   inline uint64_t start() {
     auto tc = transaction_counter_.fetch_add(1) + 1;
-    if (current_core_ == std::numeric_limits<uint8_t>::max()) {
+    if (current_core_ == std::numeric_limits<uint16_t>::max()) {
       current_core_ = sched_getcpu();
     }
     uint64_t core = current_core_;
-    tc &= 0x00FFFFFFFFFFFFFF;
-    tc |= (core << 56);
+    tc &= 0x000FFFFFFFFFFFFF;
+    tc |= (core << 52);
 
     if (atom_info_ == nullptr) {
       atom_info_ = new std::list<TransactionInformationBase<Allocator>*>();
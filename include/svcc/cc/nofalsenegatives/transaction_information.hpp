@@ -21,6 +21,7 @@
 //
 
 #pragma once
+#include "common/redo_log.hpp"
 #include "ds/atomic_unordered_map.hpp"
 #include <atomic>
 #include <iostream>
@@ -40,6 +41,8 @@ class TransactionInformationBase {
   virtual bool isAbort() = 0;
   // virtual void unlock(locking::LockManager<Allocator>* lm) = 0;
   virtual void deallocate(Allocator* alloc) = 0;
+  virtual void redo(common::RedoLog& log) {}
+  virtual void undo(common::RedoLog& log) {}
   bool isWriteTransaction() { return write_transaction_; };
 
   TransactionInformationBase(bool write_transaction) : write_transaction_(write_transaction) {}
@@ -85,6 +88,11 @@ class WriteTransactionInformation : public TransactionInformationBase<Allocator>
   void writeValue(TransactionCoordinator<Allocator>& tc);
   bool isAbort();
   void deallocate(Allocator* alloc);
+  void redo(common::RedoLog& log) { log.append(&column_, offset_, data_); }
+  void undo(common::RedoLog& log) {
+    if (!isAbort())
+      log.append(&column_, offset_, data_prv_);
+  }
 
  private:
   Value data_;
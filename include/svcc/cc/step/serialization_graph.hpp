@@ -28,6 +28,7 @@
 #include "ds/atomic_unordered_set.hpp"
 #include "svcc/cc/step/step_manager.hpp"
 #include <algorithm>
+#include <functional>
 #include <queue>
 #include <sstream>
 #include <thread>
@@ -124,8 +125,10 @@ class SerializationGraph {
   bool needsAbort(uint64_t transaction);
   bool isCommited(uint64_t transaction);
   void abort(uint64_t transaction, std::unordered_set<uint64_t>& uset);
-  bool checkCommited(uint64_t transaction);
-  bool erase_graph_constraints(uint64_t transaction, uint64_t ctr);
+  // committing runs once the transaction passed all checks and before it is visible as committed, i.e., before any
+  // successor can commit, e.g., to reserve the redo log lsn in commit order
+  bool checkCommited(uint64_t transaction, const std::function<void()>& committing = nullptr);
+  bool erase_graph_constraints(uint64_t transaction, uint64_t ctr, const std::function<void()>& committing = nullptr);
   std::string generateString();
   void print();
   void log(const common::LogInfo log_info);
@@ -21,6 +21,7 @@
 //
 
 #pragma once
+#include "common/backoff.hpp"
 #include "common/chunk_allocator.hpp"
 #include "common/epoch_manager.hpp"
 #include "ds/atomic_singly_linked_list.hpp"
@@ -93,8 +94,10 @@ class StepManager {
 
   inline void waitSaveRead(uint64_t ctr) {
     uint64_t waiter = 0;
+    common::Backoff backoff;
     while (!isSaveRead(ctr, waiter)) {
       waiter++;
+      backoff.pause();
     }
   }
   inline uint64_t currentCtr() { return ctr_; }
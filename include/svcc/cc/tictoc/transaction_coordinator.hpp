@@ -21,6 +21,8 @@
 //
 
 #pragma once
+#include "common/abort_reason.hpp"
+#include "common/backoff.hpp"
 #include "common/chunk_allocator.hpp"
 #include "common/epoch_manager.hpp"
 #include "ds/atomic_singly_linked_list.hpp"
@@ -63,11 +65,12 @@ class TransactionCoordinator {
   serial::Validator v_;
   Allocator* alloc_;
   atom::EpochManagerBase<Allocator>* emb_;
+  common::RedoLog* redo_log_ = nullptr;
 
   static thread_local bool has_writer_;
   static thread_local std::atomic<uint64_t> transaction_counter_;
   static thread_local std::unordered_set<uint64_t> not_alive_;
-  static thread_local uint8_t current_core_;
+  static thread_local uint16_t current_core_;
   static thread_local std::list<TransactionInformationBase<Allocator>*>* atom_info_;
   static thread_local atom::EpochGuard<atom::EpochManagerBase<Allocator>, atom::EpochManager<Allocator>>* eg_;
 
@@ -75,6 +78,9 @@ class TransactionCoordinator {
   TransactionCoordinator(Allocator* alloc, atom::EpochManagerBase<Allocator>* emb, bool online = false)
       : alloc_(alloc), emb_(emb){};
 
+  /* Commits are only acknowledged once their write set is durable in the redo log */
+  inline void setRedoLog(common::RedoLog* redo_log) { redo_log_ = redo_log; }
+
   /* The highest bit is used to determine read or write accesses the lower 63 for the actual transaction id */
   /* Returns the encoded bitstring for a given transaction and there action */
   inline static constexpr uint64_t access(const uint64_t transaction, const bool rw) {
@@ -119,11 +125,13 @@ class TransactionCoordinator {
     verify(info > 0);
 
     uint64_t locked_1, locked_2;
-    do {
+    for (common::Backoff backoff;; backoff.pause()) {
       locked_1 = locked[offset];
       readValue = column[offset];
       locked_2 = locked[offset];
-    } while (locked_1 != locked_2 || (locked_1 >> 63) == 1);
+      if (locked_1 == locked_2 && (locked_1 >> 63) == 0)
+        break;
+    }
 
     for (auto it = atom_info_->begin(); it != atom_info_->end() && has_writer_;) {
       if ((*it)->isWriteTransaction() && (*it)->sameDataElem(reinterpret_cast<void*>(&locked), offset)) {
@@ -229,10 +237,12 @@ class TransactionCoordinator {
     }
 
     uint64_t locked_1, locked_2;
-    do {
+    for (common::Backoff backoff;; backoff.pause()) {
       locked_1 = locked[offset];
       locked_2 = locked[offset];
-    } while (locked_1 != locked_2 || (locked_1 >> 63) == 1);
+      if (locked_1 == locked_2 && (locked_1 >> 63) == 0)
+        break;
+    }
 
     /*
      * Not needed because the sorting of the write operation is correct for applying the final result
@@ -340,6 +350,10 @@ class TransactionCoordinator {
     v_.log(common::LogInfo{transaction, 0, 0, 0, 'c'});
 #endif
 
+    if (redo_log_ != nullptr) {
+      redo_log_->commit(*atom_info_, false);
+    }
+
     v_.template unlock(*this, *atom_info_);
     for (auto t : *atom_info_) {
       t->deallocate(alloc_);
@@ -353,12 +367,12 @@ class TransactionCoordinator {
 
   inline uint64_t start() {
     auto tc = transaction_counter_.fetch_add(1) + 1;
-    if (current_core_ == std::numeric_limits<uint8_t>::max()) {
+    if (current_core_ == std::numeric_limits<uint16_t>::max()) {
       current_core_ = sched_getcpu();
     }
     uint64_t core = current_core_;
-    tc &= 0x00FFFFFFFFFFFFFF;
-    tc |= (core << 56);
+    tc &= 0x000FFFFFFFFFFFFF;
+    tc |= (core << 52);
 
     has_writer_ = false;
     atom_info_ = new std::list<TransactionInformationBase<Allocator>*>();
@@ -371,10 +385,13 @@ class TransactionCoordinator {
   template <template <typename> class Vector>
   inline void lockValue(Vector<uint64_t>& locked, uint64_t offset) {
     bool replace = false;
+    common::Backoff backoff;
     while (!replace) {
       uint64_t locked_ctr = locked[offset];
-      if (locked_ctr >> 63 == 1)
+      if (locked_ctr >> 63 == 1) {
+        backoff.pause();
         continue;
+      }
       replace = locked.compare_exchange(offset, locked_ctr, 0x8000000000000000 | locked_ctr);
     }
   }
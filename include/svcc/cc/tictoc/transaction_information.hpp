@@ -21,6 +21,7 @@
 //
 
 #pragma once
+#include "common/redo_log.hpp"
 #include "ds/atomic_unordered_map.hpp"
 #include <atomic>
 #include <iostream>
@@ -38,6 +39,8 @@ class TransactionInformationBase {
   virtual void writeValue(TransactionCoordinator<Allocator>& tc, uint64_t commit_ts) = 0;
   virtual void writeCommit(TransactionCoordinator<Allocator>& tc, uint64_t commit_ts) = 0;
   virtual void deallocate(Allocator* alloc) = 0;
+  virtual void redo(common::RedoLog& log) {}
+  virtual void undo(common::RedoLog& log) {}
   bool isWriteTransaction() { return write_transaction_; };
   virtual void lockValue(TransactionCoordinator<Allocator>& tc) = 0;
   virtual void unlockValue(TransactionCoordinator<Allocator>& tc) = 0;
@@ -95,6 +98,7 @@ class WriteTransactionInformation : public TransactionInformationBase<Allocator>
   void writeCommit(TransactionCoordinator<Allocator>& tc, uint64_t commit_ts);
   char* getValue() { return reinterpret_cast<char*>(&data_); }
   void deallocate(Allocator* alloc);
+  void redo(common::RedoLog& log) { log.append(&column_, offset_, data_); }
   void lockValue(TransactionCoordinator<Allocator>& tc);
   void unlockValue(TransactionCoordinator<Allocator>& tc);
   uint64_t getCurrentTimeStamp();
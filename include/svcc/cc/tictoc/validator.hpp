@@ -20,6 +20,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include "common/abort_reason.hpp"
 #include "common/global_logger.hpp"
 #include "ds/atomic_singly_linked_list.hpp"
 #include "svcc/cc/tictoc/transaction_information.hpp"
@@ -92,6 +93,7 @@ class Validator {
                  !(TC::getWriteTS(tts) == TC::getWriteTS(v1prime) && commit_ts < TC::getWriteTS(v1prime) &&
                    commit_ts >= TC::getWriteTS(tts))) ||
                 (TC::getReadTS(v1) <= commit_ts && TC::isLocked(v1) && !isInWriteSet(t, set_info))) {
+              common::AbortReasons::set(common::AbortReason::Validation, t->getColumn());
               return false;
             }
 
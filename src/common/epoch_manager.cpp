@@ -32,3 +32,9 @@ thread_local atom::EpochManager<common::StdAllocator>* atom::EpochManagerBase<co
     nullptr;
 template <>
 thread_local atom::EpochManager<common::NoAllocator>* atom::EpochManagerBase<common::NoAllocator>::thread_em_ = nullptr;
+template <>
+thread_local uint64_t atom::EpochManagerBase<common::ChunkAllocator>::thread_base_ = 0;
+template <>
+thread_local uint64_t atom::EpochManagerBase<common::StdAllocator>::thread_base_ = 0;
+template <>
+thread_local uint64_t atom::EpochManagerBase<common::NoAllocator>::thread_base_ = 0;
@@ -22,8 +22,10 @@
 
 #include "database.hpp"
 
+#include "common/environment.hpp"
 #include "common/mutex_wait_manager.hpp"
 #include "common/no_wait_manager.hpp"
+#include "common/options.hpp"
 
 #include "mvcc/benchmarks/column_store_smallbank.hpp"
 #include "mvcc/benchmarks/column_store_tatp.hpp"
@@ -44,37 +46,531 @@
 #include "mvcc/cc/mvocc/transaction_coordinator.hpp"
 #include "mvcc/cc/nofalsenegatives/transaction_coordinator.hpp"
 
+#include <functional>
+#include <map>
+#include <set>
 #include <string>
+#include <type_traits>
 bool writeHeader = true;
+bool recoveryMode = false;
 
-int main(int argc, char** argv) {
-  if (argc < 6) {
-    printf("Usage: %s benchmark algorithm database_size transaction_iterations cores test/scanners\n", argv[0]);
-    return 1;
+namespace {
+using Chunk = common::ChunkAllocator;
+
+/*
+ * A Protocol describes how the benchmark databases are instantiated for a concurrency control: its coordinator, the
+ * wait manager restarting aborted transactions, the type of the lock column and whether cycles are checked online.
+ */
+template <typename Coordinator, typename WaitManager, bool Online = false, typename Lock = uint64_t>
+struct Protocol {
+  using TC = Coordinator;
+  using WM = WaitManager;
+  using Locking = Lock;
+  static constexpr bool online = Online;
+};
+
+struct NoFalseNegatives
+    : Protocol<nofalsenegatives::transaction::TransactionCoordinator<Chunk>, common::MutexWaitManager> {
+  static constexpr const char* name = "NoFalseNegatives";
+};
+
+struct NoFalseNegativesOnline
+    : Protocol<nofalsenegatives::transaction::TransactionCoordinator<Chunk>, common::MutexWaitManager, true> {
+  static constexpr const char* name = "NoFalseNegatives_online";
+};
+
+struct StepBased : Protocol<step::transaction::TransactionCoordinator<Chunk>, common::MutexWaitManager> {
+  static constexpr const char* name = "SGT_step_based";
+};
+
+struct StepBasedOnline : Protocol<step::transaction::TransactionCoordinator<Chunk>, common::MutexWaitManager, true> {
+  static constexpr const char* name = "SGT_step_based_online";
+};
+
+struct Locked : Protocol<locked::transaction::TransactionCoordinator<Chunk>, common::MutexWaitManager> {
+  static constexpr const char* name = "SGT_locked";
+};
+
+struct TwoPL : Protocol<twopl::transaction::TransactionCoordinator<Chunk>, common::MutexWaitManager> {
+  static constexpr const char* name = "2PL";
+};
+
+struct TwoPLTable : Protocol<twopl_table::transaction::TransactionCoordinator<Chunk>,
+                             common::MutexWaitManager,
+                             false,
+                             std::pair<uint64_t, std::set<uint64_t>>*> {
+  static constexpr const char* name = "2PL_table";
+};
+
+// svcc_smallbank restarts aborted 2PL_table transactions without wait manager, unlike all other benchmarks
+struct TwoPLTableNoWait : Protocol<twopl_table::transaction::TransactionCoordinator<Chunk>,
+                                   common::NoWaitManager,
+                                   false,
+                                   std::pair<uint64_t, std::set<uint64_t>>*> {
+  static constexpr const char* name = "2PL_table";
+};
+
+struct TicToc : Protocol<tictoc::transaction::TransactionCoordinator<Chunk>, common::NoWaitManager> {
+  static constexpr const char* name = "TicToc";
+};
+
+struct MVNoFalseNegatives
+    : Protocol<mv::nofalsenegatives::transaction::
+                   TransactionCoordinator<atom::ExtentVector, atom::AtomicExtentVector, Chunk>,
+               common::MutexWaitManager> {
+  static constexpr const char* name = "NoFalseNegatives";
+};
+
+struct MVOCC
+    : Protocol<mv::mvocc::transaction::TransactionCoordinator<atom::ExtentVector, atom::AtomicExtentVector, Chunk>,
+               common::NoWaitManager> {
+  static constexpr const char* name = "MVOCC";
+};
+
+/*
+ * A Registry maps protocol names to protocols at compile time, find calls func with the protocol named name. Every
+ * benchmark is instantiated for all protocols of its registry.
+ */
+template <typename... Protocols>
+struct Registry {
+  template <typename Func>
+  static bool find(const std::string& name, Func&& func) {
+    bool found = false;
+    ((!found && name == Protocols::name ? (func(Protocols{}), found = true) : false), ...);
+    return found;
   }
 
-  char* benchmark = argv[1];
-  char* algorithm = argv[2];
-  uint64_t database_size = atoi(argv[3]);           // 1000000
-  uint64_t transaction_iterations = atoi(argv[4]);  // 1000000
-  uint64_t cores = atoi(argv[5]);                   // 100
-  uint64_t custom1 = 0;
-  double custom2 = 0, custom3 = 0, custom4 = 0;
+  static std::string names() {
+    std::string names;
+    ((names += (names.empty() ? "" : " ") + std::string{Protocols::name}), ...);
+    return names;
+  }
+};
+
+using SingleVersion =
+    Registry<NoFalseNegatives, NoFalseNegativesOnline, StepBased, StepBasedOnline, Locked, TwoPL, TwoPLTable, TicToc>;
+using SingleVersionSmallbank = Registry<NoFalseNegatives,
+                                        NoFalseNegativesOnline,
+                                        StepBased,
+                                        StepBasedOnline,
+                                        Locked,
+                                        TwoPL,
+                                        TwoPLTableNoWait,
+                                        TicToc>;
+using SingleVersionTest = Registry<NoFalseNegatives, StepBased, Locked, TicToc>;
+using MultiVersion = Registry<MVNoFalseNegatives, MVOCC>;
+
+template <typename P>
+constexpr bool isTicToc = std::is_same<P, TicToc>::value;
+
+// the benchmark Database instantiated for protocol P
+template <template <typename, typename, typename> class Database, typename P>
+using Instance = Database<typename P::TC, typename P::WM, typename P::Locking>;
+
+template <typename DB, typename P, typename... Args>
+DB* create(P, Args... args) {
+  return new DB{args..., P::online};
+}
+
+/*
+ * ycsb, tatp and tpcc construct the step based protocols with their online flags swapped, i.e., SGT_step_based checks
+ * cycles online there, as the benchmarks always did. Kept s.t. results stay comparable with earlier runs.
+ */
+template <typename P>
+constexpr bool isStepBased = std::is_same<P, StepBased>::value || std::is_same<P, StepBasedOnline>::value;
+
+template <typename DB, typename P, typename... Args>
+DB* createSwapped(P, Args... args) {
+  return new DB{args..., isStepBased<P> ? !P::online : P::online};
+}
+
+// svcc_tpcc always ran 2PL_table with the default of 4 warehouses regardless of the size
+template <typename P>
+constexpr bool isTwoPLTable = std::is_same<P, TwoPLTable>::value;
+
+/*
+ * An Invocation is the parsed configuration of bin/db for one protocol and size. Its runs over all core counts (and
+ * thetas for YCSB), each repeated repeat times, share one populated database.
+ */
+struct Invocation {
+  // workers are pinned by a cpu_set_t, i.e., the cpus of CPU_SETSIZE
+  static constexpr uint64_t max_cores = CPU_SETSIZE;
 
-  if (argc >= 7) {
-    custom1 = atoi(argv[6]);
+  std::string benchmark;
+  std::string protocol;
+  uint64_t size;
+  uint64_t transactions;
+  std::vector<uint64_t> cores;
+  uint64_t custom1;
+  double custom2;
+  double custom3;
+  std::vector<double> thetas;
+  std::vector<uint64_t> fields;
+  std::vector<double> rates;
+  std::vector<uint64_t> oversubscriptions;
+  uint64_t repeat;
+  std::string workload;
+  bool scramble;
+  bool executor;
+  uint64_t interleave;
 
-    if (argc >= 8) {
-      custom2 = atof(argv[7]);
+  Invocation(const common::Options& options)
+      : benchmark(options.get("benchmark")),
+        protocol(options.get("protocol")),
+        size(options.number("size")),
+        transactions(options.number("transactions")),
+        cores(options.list<uint64_t>("cores")),
+        custom1(options.number("custom1")),
+        custom2(options.real("custom2")),
+        custom3(options.real("custom3")),
+        thetas(options.list("custom4")),
+        fields(options.list<uint64_t>("fields")),
+        rates(options.list("rate")),
+        oversubscriptions(options.list<uint64_t>("oversubscribe")),
+        repeat(std::max<uint64_t>(options.number("repeat", 1), 1)),
+        workload(options.get("workload")),
+        scramble(options.has("scramble")),
+        executor(options.has("executor")),
+        interleave(common::Interleave::width()) {
+    if (thetas.empty())
+      thetas.push_back(0);
+    if (fields.empty())
+      fields.push_back(1);
+    if (rates.empty())
+      rates.push_back(0);
+    if (oversubscriptions.empty())
+      oversubscriptions.push_back(1);
+  }
 
-      if (argc >= 9) {
-        custom3 = atof(argv[8]);
+  bool valid(uint64_t scanners) const {
+    if (cores.empty()) {
+      std::cout << "Error: no core count given" << std::endl;
+      return false;
+    }
+    for (auto f : oversubscriptions) {
+      for (auto c : cores) {
+        if (f == 0 || c == 0 || c * f > max_cores || c * f - scanners < scanners) {
+          std::cout << "Error: " << c << " cores with " << f << " workers per core for " << scanners
+                    << " scanners, at most " << max_cores << " workers and at least as many workers as scanners"
+                    << std::endl;
+          return false;
+        }
+      }
+    }
+    return true;
+  }
 
-        if (argc >= 10) {
-          custom4 = atof(argv[9]);
+  // one run per arrival rate, oversubscription and core count, an oversubscribed run has f workers per core
+  std::vector<Run> runs(const std::string& name, uint64_t scanners = 0, std::function<void()> prepare = nullptr) const {
+    std::vector<Run> runs;
+    for (auto rate : rates) {
+      for (auto f : oversubscriptions) {
+        for (auto c : cores) {
+          runs.push_back(Run{name, c * f, scanners, rate, f, prepare});
         }
       }
     }
+    return runs;
+  }
+
+  // one run per theta, update width and core count, the skew is changed on the populated database; a core workload
+  // (--workload) replaces the read and scan shares and is appended to the benchmark name, e.g., svcc_ycsb_a, as is
+  // _scrambled for scrambled keys, _tasks for the executor clients and _interleaved for interleaved lookups
+  template <typename DB>
+  std::vector<Run> ycsbRuns(DB* db) const {
+    if (!workload.empty() && (workload.size() != 1 || !db->setWorkload(workload.front()))) {
+      std::cout << "Error: --workload has to be one of the YCSB core workloads a to f" << std::endl;
+      delete db;
+      std::exit(EXIT_FAILURE);
+    }
+    for (auto width : fields) {
+      if (!db->setUpdateFields(width)) {
+        std::cout << "Error: --fields has to be between 1 and " << DB::fields << std::endl;
+        delete db;
+        std::exit(EXIT_FAILURE);
+      }
+    }
+    std::string prefix = benchmark;
+    if (!workload.empty())
+      prefix += "_" + std::string(1, std::tolower(workload.front()));
+    db->setScrambled(scramble);
+    if (scramble)
+      prefix += "_scrambled";
+    if (executor)
+      prefix += "_tasks";
+    if (interleave > 0)
+      prefix += "_interleaved";
+
+    std::vector<Run> runs;
+    for (double theta : thetas) {
+      for (auto width : fields) {
+        std::string name = prefix + ";" + std::to_string(custom1) + ";" + std::to_string(custom2) + ";" +
+                           std::to_string(custom3) + ";" + std::to_string(theta) + ";" + std::to_string(width);
+        bool skew = thetas.size() > 1;
+        auto prepare = [db, theta, width, skew]() {
+          if (skew)
+            db->setTheta(theta);
+          db->setUpdateFields(width);
+        };
+        auto ycsb_runs = this->runs(name, 0, prepare);
+        runs.insert(runs.end(), ycsb_runs.begin(), ycsb_runs.end());
+      }
+    }
+    return runs;
+  }
+
+  // all runs are repeated in turn, s.t. drifts of the machine spread over all configurations
+  template <typename DB, typename Func>
+  void run(DB* db, Func client, const std::vector<Run>& runs, Func scan = nullptr) const {
+    if (!valid(runs.front().scanners)) {
+      delete db;
+      std::exit(EXIT_FAILURE);
+    }
+    std::vector<Run> repeated;
+    for (uint64_t r = 0; r < repeat; ++r) {
+      repeated.insert(repeated.end(), runs.begin(), runs.end());
+    }
+    runBenchmark(db, client, repeated, protocol.c_str(), size, transactions, scan);
+  }
+
+  template <typename DB, uint64_t N>
+  void runVariant(DB* db, void (*const (&clients)[N])(DB&, uint32_t, int, uint16_t)) const {
+    if (custom1 >= N) {
+      std::cout << "Error: " << benchmark << " has the variants 0 to " << (N - 1) << std::endl;
+      delete db;
+      std::exit(EXIT_FAILURE);
+    }
+    run(db, clients[custom1], runs(benchmark));
+  }
+};
+
+// the benchmarks by name, a launcher returns false if the benchmark is not instantiated for the protocol
+using Launcher = std::function<bool(const Invocation&)>;
+
+const std::map<std::string, Launcher> benchmarks = {
+    {"svcc_smallbank",
+     [](const Invocation& in) {
+       return SingleVersionSmallbank::find(in.protocol, [&](auto p) {
+         using DB = Instance<sv::smallbank::Database, decltype(p)>;
+         in.run(create<DB>(p), &DB::client, in.runs(in.benchmark));
+       });
+     }},
+    {"svcc_smallbank_hc",
+     [](const Invocation& in) {
+       return SingleVersion::find(in.protocol, [&](auto p) {
+         using DB = Instance<sv::smallbank::Database, decltype(p)>;
+         in.run(create<DB>(p), &DB::clientHighContention, in.runs(in.benchmark));
+       });
+     }},
+    {"svcc_smallbank_scan",
+     [](const Invocation& in) {
+       return SingleVersion::find(in.protocol, [&](auto p) {
+         using DB = Instance<sv::smallbank::Database, decltype(p)>;
+         in.run(create<DB>(p), &DB::clientScan, in.runs(in.benchmark));
+       });
+     }},
+    {"svcc_smallbank_scanner",
+     [](const Invocation& in) {
+       return SingleVersion::find(in.protocol, [&](auto p) {
+         using DB = Instance<sv::smallbank::Database, decltype(p)>;
+         in.run(create<DB>(p), &DB::client, in.runs(in.benchmark, in.custom1), &DB::clientOLAPOnly);
+       });
+     }},
+    {"svcc_ycsb",
+     [](const Invocation& in) {
+       return SingleVersion::find(in.protocol, [&](auto p) {
+         using DB = Instance<sv::ycsb::Database, decltype(p)>;
+         auto db = createSwapped<DB>(p, in.custom1, in.custom2, in.custom3, in.thetas.front());
+         if constexpr (isTicToc<decltype(p)>) {
+           in.run(db, in.executor ? &DB::template clientTasks<false> : &DB::template clientMulti<false>,
+                  in.ycsbRuns(db));
+         } else {
+           in.run(db, in.executor ? &DB::template clientTasks<true> : &DB::client, in.ycsbRuns(db));
+         }
+       });
+     }},
+    {"svcc_tatp",
+     [](const Invocation& in) {
+       return SingleVersion::find(in.protocol, [&](auto p) {
+         using DB = Instance<sv::tatp::Database, decltype(p)>;
+         if constexpr (isTicToc<decltype(p)>) {
+           in.run(createSwapped<DB>(p), &DB::template clientMultiRead<false>, in.runs(in.benchmark));
+         } else {
+           in.run(createSwapped<DB>(p), &DB::client, in.runs(in.benchmark));
+         }
+       });
+     }},
+    {"svcc_tpcc",
+     [](const Invocation& in) {
+       return SingleVersion::find(in.protocol, [&](auto p) {
+         using DB = Instance<sv::tpcc::Database, decltype(p)>;
+         auto name = in.interleave > 0 ? in.benchmark + "_interleaved" : in.benchmark;
+         uint64_t warehouses = isTwoPLTable<decltype(p)> ? 4 : in.size;
+         if constexpr (isTicToc<decltype(p)>) {
+           in.run(createSwapped<DB>(p, warehouses), &DB::template clientMultiRead<false>, in.runs(name));
+         } else {
+           in.run(createSwapped<DB>(p, warehouses), &DB::client, in.runs(name));
+         }
+       });
+     }},
+    {"svcc_test",
+     [](const Invocation& in) {
+       return SingleVersionTest::find(in.protocol, [&](auto p) {
+         using DB = Instance<sv::smallbank::Database, decltype(p)>;
+         void (*const clients[])(DB&, uint32_t, int, uint16_t) = {DB::template clientTest<0>,
+                                                                  DB::template clientTest<1>};
+         in.runVariant(create<DB>(p), clients);
+       });
+     }},
+    {"mvcc_smallbank",
+     [](const Invocation& in) {
+       return MultiVersion::find(in.protocol, [&](auto p) {
+         using DB = Instance<mv::smallbank::Database, decltype(p)>;
+         in.run(create<DB>(p), &DB::client, in.runs(in.benchmark));
+       });
+     }},
+    {"mvcc_smallbank_hc",
+     [](const Invocation& in) {
+       return MultiVersion::find(in.protocol, [&](auto p) {
+         using DB = Instance<mv::smallbank::Database, decltype(p)>;
+         in.run(create<DB>(p), &DB::clientHighContention, in.runs(in.benchmark));
+       });
+     }},
+    {"mvcc_smallbank_scan",
+     [](const Invocation& in) {
+       return MultiVersion::find(in.protocol, [&](auto p) {
+         using DB = Instance<mv::smallbank::Database, decltype(p)>;
+         in.run(create<DB>(p), &DB::clientScan, in.runs(in.benchmark));
+       });
+     }},
+    {"mvcc_smallbank_scanner",
+     [](const Invocation& in) {
+       return MultiVersion::find(in.protocol, [&](auto p) {
+         using DB = Instance<mv::smallbank::Database, decltype(p)>;
+         in.run(create<DB>(p), &DB::client, in.runs(in.benchmark, in.custom1), &DB::clienOLAPOnly);
+       });
+     }},
+    {"mvcc_smallbank_read",
+     [](const Invocation& in) {
+       return MultiVersion::find(in.protocol, [&](auto p) {
+         using DB = Instance<mv::smallbank::Database, decltype(p)>;
+         in.run(create<DB>(p), &DB::clientReadOnly, in.runs(in.benchmark));
+       });
+     }},
+    {"mvcc_ycsb",
+     [](const Invocation& in) {
+       return MultiVersion::find(in.protocol, [&](auto p) {
+         using DB = Instance<mv::ycsb::Database, decltype(p)>;
+         auto db = create<DB>(p, in.custom1, in.custom2, in.custom3, in.thetas.front());
+         in.run(db, in.executor ? &DB::template clientTasks<true> : &DB::client, in.ycsbRuns(db));
+       });
+     }},
+    {"mvcc_tatp",
+     [](const Invocation& in) {
+       return MultiVersion::find(in.protocol, [&](auto p) {
+         using DB = Instance<mv::tatp::Database, decltype(p)>;
+         in.run(create<DB>(p), &DB::client, in.runs(in.benchmark));
+       });
+     }},
+    {"mvcc_tpcc",
+     [](const Invocation& in) {
+       return MultiVersion::find(in.protocol, [&](auto p) {
+         using DB = Instance<mv::tpcc::Database, decltype(p)>;
+         in.run(create<DB>(p, in.size), &DB::client, in.runs(in.benchmark));
+       });
+     }},
+    {"mvcc_test",
+     [](const Invocation& in) {
+       return MultiVersion::find(in.protocol, [&](auto p) {
+         using DB = Instance<mv::smallbank::Database, decltype(p)>;
+         void (*const clients[])(DB&, uint32_t, int, uint16_t) = {
+             DB::template clientTest<0, false>, DB::template clientTest<1, false>, DB::template clientTest<0, true>,
+             DB::template clientTest<1, true>};
+         in.runVariant(create<DB>(p), clients);
+       });
+     }}};
+
+// the protocols instantiated for benchmark
+std::string protocols(const std::string& benchmark) {
+  if (benchmark == "svcc_test")
+    return SingleVersionTest::names();
+  return benchmark.compare(0, 4, "svcc") == 0 ? SingleVersion::names() : MultiVersion::names();
+}
+
+void usage(const char* binary) {
+  std::cout << "Usage: " << binary << " [recover] benchmark protocol size transactions cores [custom1 custom2 custom3 "
+            << "custom4]" << std::endl
+            << "       " << binary << " [--recover] --benchmark=name --protocol=name --size=n --transactions=n "
+            << "--cores=list [--config=file]" << std::endl
+            << "         [--scanners=n] [--variant=n] [--ops=n --read=share --scan=share --theta=list "
+            << "--workload=a-f --fields=list --scramble --executor]" << std::endl
+            << "         [--repeat=n] [--sweep[=sweep.csv]] [--rate=list [--arrival=poisson|constant]]" << std::endl
+            << "         [--placement=linear|compact|scatter|cores|none|list] [--oversubscribe=list] "
+            << "[--interleave[=n]]" << std::endl
+            << "Lists are comma separated values or ranges first-last[:step], e.g., --cores=1,2,4-32:4, protocol "
+            << "and size take lists as well, --protocol=all runs every protocol of the benchmark" << std::endl
+            << "Benchmarks:";
+  for (auto& benchmark : benchmarks) {
+    std::cout << " " << benchmark.first;
+  }
+  std::cout << std::endl
+            << "Protocols: svcc " << SingleVersion::names() << ", svcc_test " << SingleVersionTest::names()
+            << ", mvcc " << MultiVersion::names() << std::endl;
+}
+};  // namespace
+
+int main(int argc, char** argv) {
+  common::Options options;
+  if (!options.parse(argc, argv)) {
+    usage(argv[0]);
+    return 1;
+  }
+  if (!common::Environment::check()) {
+    return 1;
+  }
+  // recover: populates the database and recovers it from the log in NFN_LOG on cores threads instead of running it
+  recoveryMode = options.recover();
+  if (options.get("arrival", "poisson") != "poisson" && options.get("arrival") != "constant") {
+    std::cout << "Error: --arrival has to be poisson or constant" << std::endl;
+    return 1;
+  }
+  common::Arrivals::setPoisson(options.get("arrival", "poisson") == "poisson");
+  // placement: a policy or a list of CPUs, see common::Placement
+  auto placement = options.get("placement", "linear");
+  if (!common::Placement::configure(placement) &&
+      !common::Placement::configure(placement, options.list<uint32_t>("placement"))) {
+    std::cout << "Error: --placement has to be linear, compact, scatter, cores, none or a list of available CPUs"
+              << std::endl;
+    return 1;
+  }
+  common::Placement::printTopology();
+  // interleave: the lookups in flight per worker, see common::Interleave
+  common::Interleave::configure(options.has("interleave") ? options.number("interleave", 8) : 0);
+  if (common::Interleave::width() > 0 && !common::Interleave::supported) {
+    std::cout << "Error: --interleave needs a build with coroutines, cmake -DNFN_COROUTINES=ON" << std::endl;
+    return 1;
+  }
+  Invocation invocation{options};
+
+  auto benchmark = benchmarks.find(invocation.benchmark);
+  if (benchmark == benchmarks.end()) {
+    std::cout << "Error: unknown benchmark " << invocation.benchmark << std::endl;
+    usage(argv[0]);
+    return 1;
+  }
+
+  // sweep: every protocol and size is populated once, their runs are summarized into one line per configuration
+  auto protocol_names = options.names("protocol");
+  if (protocol_names == std::vector<std::string>{"all"}) {
+    std::stringstream all{protocols(invocation.benchmark)};
+    protocol_names.clear();
+    for (std::string name; all >> name;) {
+      protocol_names.push_back(name);
+    }
+  }
+  auto sizes = options.list<uint64_t>("size");
+  if (options.has("sweep")) {
+    common::Sweep::enable();
   }
 
   cpu_set_t cpuset;
@@ -93,428 +589,21 @@ int main(int argc, char** argv) {
     std::cout << "Error pthread_getaffinity_np" << std::endl;
   }
 
-  tbb::task_scheduler_init init(std::thread::hardware_concurrency());
-
-  if (!strcmp(benchmark, "svcc_smallbank")) {
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db =
-          new sv::smallbank::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                      common::MutexWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "NoFalseNegatives_online")) {
-      auto db =
-          new sv::smallbank::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                      common::MutexWaitManager>{true};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_step_based")) {
-      auto db = new sv::smallbank::Database<step::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_step_based_online")) {
-      auto db = new sv::smallbank::Database<step::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{true};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_locked")) {
-      auto db = new sv::smallbank::Database<locked::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "2PL")) {
-      auto db = new sv::smallbank::Database<twopl::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "2PL_table")) {
-      auto db = new sv::smallbank::Database<twopl_table::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::NoWaitManager, std::pair<uint64_t, std::set<uint64_t>>*>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "TicToc")) {
-      auto db = new sv::smallbank::Database<tictoc::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::NoWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    }
-  } else if (!strcmp(benchmark, "svcc_smallbank_hc")) {
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db =
-          new sv::smallbank::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                      common::MutexWaitManager>{};
-      runBenchmark(db, db->clientHighContention, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "NoFalseNegatives_online")) {
-      auto db =
-          new sv::smallbank::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                      common::MutexWaitManager>{true};
-      runBenchmark(db, db->clientHighContention, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_step_based")) {
-      auto db = new sv::smallbank::Database<step::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      runBenchmark(db, db->clientHighContention, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_step_based_online")) {
-      auto db = new sv::smallbank::Database<step::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{true};
-      runBenchmark(db, db->clientHighContention, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_locked")) {
-      auto db = new sv::smallbank::Database<locked::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      runBenchmark(db, db->clientHighContention, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "2PL")) {
-      auto db = new sv::smallbank::Database<twopl::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      runBenchmark(db, db->clientHighContention, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "2PL_table")) {
-      auto db = new sv::smallbank::Database<twopl_table::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager, std::pair<uint64_t, std::set<uint64_t>>*>{};
-      runBenchmark(db, db->clientHighContention, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "TicToc")) {
-      auto db = new sv::smallbank::Database<tictoc::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::NoWaitManager>{};
-      runBenchmark(db, db->clientHighContention, benchmark, algorithm, database_size, transaction_iterations, cores);
-    }
-  } else if (!strcmp(benchmark, "svcc_smallbank_scan")) {
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db =
-          new sv::smallbank::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                      common::MutexWaitManager>{};
-      runBenchmark(db, db->clientScan, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "NoFalseNegatives_online")) {
-      auto db =
-          new sv::smallbank::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                      common::MutexWaitManager>{true};
-      runBenchmark(db, db->clientScan, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_step_based")) {
-      auto db = new sv::smallbank::Database<step::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      runBenchmark(db, db->clientScan, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_step_based_online")) {
-      auto db = new sv::smallbank::Database<step::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{true};
-      runBenchmark(db, db->clientScan, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_locked")) {
-      auto db = new sv::smallbank::Database<locked::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      runBenchmark(db, db->clientScan, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "2PL")) {
-      auto db = new sv::smallbank::Database<twopl::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      runBenchmark(db, db->clientScan, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "2PL_table")) {
-      auto db = new sv::smallbank::Database<twopl_table::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager, std::pair<uint64_t, std::set<uint64_t>>*>{};
-      runBenchmark(db, db->clientScan, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "TicToc")) {
-      auto db = new sv::smallbank::Database<tictoc::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::NoWaitManager>{};
-      runBenchmark(db, db->clientScan, benchmark, algorithm, database_size, transaction_iterations, cores);
-    }
-  } else if (!strcmp(benchmark, "svcc_smallbank_scanner")) {
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db =
-          new sv::smallbank::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                      common::MutexWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores, custom1,
-                   db->clientOLAPOnly);
-    } else if (!strcmp(algorithm, "NoFalseNegatives_online")) {
-      auto db =
-          new sv::smallbank::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                      common::MutexWaitManager>{true};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores, custom1,
-                   db->clientOLAPOnly);
-    } else if (!strcmp(algorithm, "SGT_step_based")) {
-      auto db = new sv::smallbank::Database<step::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores, custom1,
-                   db->clientOLAPOnly);
-    } else if (!strcmp(algorithm, "SGT_step_based_online")) {
-      auto db = new sv::smallbank::Database<step::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{true};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores, custom1,
-                   db->clientOLAPOnly);
-    } else if (!strcmp(algorithm, "SGT_locked")) {
-      auto db = new sv::smallbank::Database<locked::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores, custom1,
-                   db->clientOLAPOnly);
-    } else if (!strcmp(algorithm, "2PL")) {
-      auto db = new sv::smallbank::Database<twopl::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores, custom1,
-                   db->clientOLAPOnly);
-    } else if (!strcmp(algorithm, "2PL_table")) {
-      auto db = new sv::smallbank::Database<twopl_table::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager, std::pair<uint64_t, std::set<uint64_t>>*>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores, custom1,
-                   db->clientOLAPOnly);
-    } else if (!strcmp(algorithm, "TicToc")) {
-      auto db = new sv::smallbank::Database<tictoc::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::NoWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores, custom1,
-                   db->clientOLAPOnly);
-    }
-  } else if (!strcmp(benchmark, "svcc_ycsb")) {
-    std::string benchmark_detail = std::string(benchmark) + ";" + std::to_string(custom1) + ";" +
-                                   std::to_string(custom2) + ";" + std::to_string(custom3) + ";" +
-                                   std::to_string(custom4);
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db = new sv::ycsb::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{custom1, custom2, custom3, custom4};
-      runBenchmark(db, db->client, benchmark_detail.c_str(), algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "NoFalseNegatives_online")) {
-      auto db = new sv::ycsb::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{custom1, custom2, custom3, custom4, true};
-      runBenchmark(db, db->client, benchmark_detail.c_str(), algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_step_based")) {
-      auto db = new sv::ycsb::Database<step::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{custom1, custom2, custom3, custom4, true};
-      runBenchmark(db, db->client, benchmark_detail.c_str(), algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_step_based_online")) {
-      auto db = new sv::ycsb::Database<step::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{custom1, custom2, custom3, custom4};
-      runBenchmark(db, db->client, benchmark_detail.c_str(), algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_locked")) {
-      auto db = new sv::ycsb::Database<locked::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{custom1, custom2, custom3, custom4};
-      runBenchmark(db, db->client, benchmark_detail.c_str(), algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "2PL")) {
-      auto db = new sv::ycsb::Database<twopl::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{custom1, custom2, custom3, custom4};
-      runBenchmark(db, db->client, benchmark_detail.c_str(), algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "2PL_table")) {
-      auto db = new sv::ycsb::Database<twopl_table::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager, std::pair<uint64_t, std::set<uint64_t>>*>{
-          custom1, custom2, custom3, custom4};
-      runBenchmark(db, db->client, benchmark_detail.c_str(), algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "TicToc")) {
-      auto db = new sv::ycsb::Database<tictoc::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::NoWaitManager>{custom1, custom2, custom3, custom4};
-      runBenchmark(db, db->clientMulti<false>, benchmark_detail.c_str(), algorithm, database_size,
-                   transaction_iterations, cores);
-    }
-  } else if (!strcmp(benchmark, "svcc_tatp")) {
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db = new sv::tatp::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "NoFalseNegatives_online")) {
-      auto db = new sv::tatp::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{true};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_step_based")) {
-      auto db = new sv::tatp::Database<step::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{true};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_step_based_online")) {
-      auto db = new sv::tatp::Database<step::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_locked")) {
-      auto db = new sv::tatp::Database<locked::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "2PL")) {
-      auto db = new sv::tatp::Database<twopl::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "2PL_table")) {
-      auto db = new sv::tatp::Database<twopl_table::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager, std::pair<uint64_t, std::set<uint64_t>>*>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "TicToc")) {
-      auto db = new sv::tatp::Database<tictoc::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::NoWaitManager>{};
-      runBenchmark(db, db->clientMultiRead<false>, benchmark, algorithm, database_size, transaction_iterations, cores);
-    }
-  } else if (!strcmp(benchmark, "svcc_tpcc")) {
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db = new sv::tpcc::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{database_size};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "NoFalseNegatives_online")) {
-      auto db = new sv::tpcc::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{database_size, true};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_step_based")) {
-      auto db = new sv::tpcc::Database<step::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{database_size, true};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_step_based_online")) {
-      auto db = new sv::tpcc::Database<step::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{database_size};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_locked")) {
-      auto db = new sv::tpcc::Database<locked::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{database_size};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "2PL")) {
-      auto db = new sv::tpcc::Database<twopl::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager>{database_size};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "2PL_table")) {
-      auto db = new sv::tpcc::Database<twopl_table::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::MutexWaitManager, std::pair<uint64_t, std::set<uint64_t>>*>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "TicToc")) {
-      auto db = new sv::tpcc::Database<tictoc::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                       common::NoWaitManager>{database_size};
-      runBenchmark(db, db->clientMultiRead<false>, benchmark, algorithm, database_size, transaction_iterations, cores);
-    }
-  } else if (!strcmp(benchmark, "mvcc_smallbank")) {
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db = new mv::smallbank::Database<mv::nofalsenegatives::transaction::TransactionCoordinator<
-                                                atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "MVOCC")) {
-      auto db = new mv::smallbank::Database<mv::mvocc::transaction::TransactionCoordinator<
-                                                atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                            common::NoWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    }
-  } else if (!strcmp(benchmark, "mvcc_smallbank_hc")) {
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db = new mv::smallbank::Database<mv::nofalsenegatives::transaction::TransactionCoordinator<
-                                                atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      runBenchmark(db, db->clientHighContention, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "MVOCC")) {
-      auto db = new mv::smallbank::Database<mv::mvocc::transaction::TransactionCoordinator<
-                                                atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                            common::NoWaitManager>{};
-      runBenchmark(db, db->clientHighContention, benchmark, algorithm, database_size, transaction_iterations, cores);
-    }
-  } else if (!strcmp(benchmark, "mvcc_ycsb")) {
-    std::string benchmark_detail = std::string(benchmark) + ";" + std::to_string(custom1) + ";" +
-                                   std::to_string(custom2) + ";" + std::to_string(custom3) + ";" +
-                                   std::to_string(custom4);
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db = new mv::ycsb::Database<mv::nofalsenegatives::transaction::TransactionCoordinator<
-                                           atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                       common::MutexWaitManager>{custom1, custom2, custom3, custom4};
-      runBenchmark(db, db->client, benchmark_detail.c_str(), algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "MVOCC")) {
-      auto db = new mv::ycsb::Database<mv::mvocc::transaction::TransactionCoordinator<
-                                           atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                       common::NoWaitManager>{custom1, custom2, custom3, custom4};
-      runBenchmark(db, db->client, benchmark_detail.c_str(), algorithm, database_size, transaction_iterations, cores);
-    }
-  } else if (!strcmp(benchmark, "mvcc_tatp")) {
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db = new mv::tatp::Database<mv::nofalsenegatives::transaction::TransactionCoordinator<
-                                           atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                       common::MutexWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "MVOCC")) {
-      auto db = new mv::tatp::Database<mv::mvocc::transaction::TransactionCoordinator<
-                                           atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                       common::NoWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    }
-  } else if (!strcmp(benchmark, "mvcc_tpcc")) {
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db = new mv::tpcc::Database<mv::nofalsenegatives::transaction::TransactionCoordinator<
-                                           atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                       common::MutexWaitManager>{database_size};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "MVOCC")) {
-      auto db = new mv::tpcc::Database<mv::mvocc::transaction::TransactionCoordinator<
-                                           atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                       common::NoWaitManager>{database_size};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores);
-    }
-  } else if (!strcmp(benchmark, "mvcc_smallbank_scan")) {
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db = new mv::smallbank::Database<mv::nofalsenegatives::transaction::TransactionCoordinator<
-                                                atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      runBenchmark(db, db->clientScan, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "MVOCC")) {
-      auto db = new mv::smallbank::Database<mv::mvocc::transaction::TransactionCoordinator<
-                                                atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                            common::NoWaitManager>{};
-      runBenchmark(db, db->clientScan, benchmark, algorithm, database_size, transaction_iterations, cores);
-    }
-  } else if (!strcmp(benchmark, "mvcc_smallbank_scanner")) {
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db = new mv::smallbank::Database<mv::nofalsenegatives::transaction::TransactionCoordinator<
-                                                atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores, custom1,
-                   db->clienOLAPOnly);
-      // std::cout << "AVG VC Length: " << db->tc.getAVGVC() << std::endl;
-    } else if (!strcmp(algorithm, "MVOCC")) {
-      auto db = new mv::smallbank::Database<mv::mvocc::transaction::TransactionCoordinator<
-                                                atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                            common::NoWaitManager>{};
-      runBenchmark(db, db->client, benchmark, algorithm, database_size, transaction_iterations, cores, custom1,
-                   db->clienOLAPOnly);
-    }
-  } else if (!strcmp(benchmark, "mvcc_smallbank_read")) {
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db = new mv::smallbank::Database<mv::nofalsenegatives::transaction::TransactionCoordinator<
-                                                atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      // p.timeAndProfile("bench", [&]() {
-      runBenchmark(db, db->clientReadOnly, benchmark, algorithm, database_size, transaction_iterations, cores);
-      //});
-    } else if (!strcmp(algorithm, "MVOCC")) {
-      auto db = new mv::smallbank::Database<mv::mvocc::transaction::TransactionCoordinator<
-                                                atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                            common::NoWaitManager>{};
-      runBenchmark(db, db->clientReadOnly, benchmark, algorithm, database_size, transaction_iterations, cores);
-    }
-  } else if (!strcmp(benchmark, "mvcc_test")) {
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db = new mv::smallbank::Database<mv::nofalsenegatives::transaction::TransactionCoordinator<
-                                                atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      if (custom1 == 2)
-        runBenchmark(db, db->clientTest<0, true>, benchmark, algorithm, database_size, transaction_iterations, cores);
-      if (custom1 == 3)
-        runBenchmark(db, db->clientTest<1, true>, benchmark, algorithm, database_size, transaction_iterations, cores);
-      if (custom1 == 0)
-        runBenchmark(db, db->clientTest<0, false>, benchmark, algorithm, database_size, transaction_iterations, cores);
-      if (custom1 == 1)
-        runBenchmark(db, db->clientTest<1, false>, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "MVOCC")) {
-      auto db = new mv::smallbank::Database<mv::mvocc::transaction::TransactionCoordinator<
-                                                atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>,
-                                            common::NoWaitManager>{};
-      if (custom1 == 2)
-        runBenchmark(db, db->clientTest<0, true>, benchmark, algorithm, database_size, transaction_iterations, cores);
-      if (custom1 == 3)
-        runBenchmark(db, db->clientTest<1, true>, benchmark, algorithm, database_size, transaction_iterations, cores);
-      if (custom1 == 0)
-        runBenchmark(db, db->clientTest<0, false>, benchmark, algorithm, database_size, transaction_iterations, cores);
-      if (custom1 == 1)
-        runBenchmark(db, db->clientTest<1, false>, benchmark, algorithm, database_size, transaction_iterations, cores);
-    }
-  } else if (!strcmp(benchmark, "svcc_test")) {
-    if (!strcmp(algorithm, "NoFalseNegatives")) {
-      auto db =
-          new sv::smallbank::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                      common::MutexWaitManager>{};
-      if (custom1 == 0)
-        runBenchmark(db, db->clientTest<0>, benchmark, algorithm, database_size, transaction_iterations, cores);
-      if (custom1 == 1)
-        runBenchmark(db, db->clientTest<1>, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_step_based")) {
-      auto db = new sv::smallbank::Database<step::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      if (custom1 == 0)
-        runBenchmark(db, db->clientTest<0>, benchmark, algorithm, database_size, transaction_iterations, cores);
-      if (custom1 == 1)
-        runBenchmark(db, db->clientTest<1>, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "SGT_locked")) {
-      auto db = new sv::smallbank::Database<locked::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::MutexWaitManager>{};
-      if (custom1 == 0)
-        runBenchmark(db, db->clientTest<0>, benchmark, algorithm, database_size, transaction_iterations, cores);
-      if (custom1 == 1)
-        runBenchmark(db, db->clientTest<1>, benchmark, algorithm, database_size, transaction_iterations, cores);
-    } else if (!strcmp(algorithm, "TicToc")) {
-      auto db = new sv::smallbank::Database<tictoc::transaction::TransactionCoordinator<common::ChunkAllocator>,
-                                            common::NoWaitManager>{};
-      if (custom1 == 0)
-        runBenchmark(db, db->clientTest<0>, benchmark, algorithm, database_size, transaction_iterations, cores);
-      if (custom1 == 1)
-        runBenchmark(db, db->clientTest<1>, benchmark, algorithm, database_size, transaction_iterations, cores);
+  for (auto& protocol : protocol_names) {
+    for (auto size : sizes) {
+      invocation.protocol = protocol;
+      invocation.size = size;
+      if (!benchmark->second(invocation)) {
+        std::cout << "Error: " << invocation.benchmark << " does not support protocol " << protocol << std::endl;
+        usage(argv[0]);
+        return 1;
+      }
     }
   }
+
+  if (common::Sweep::enabled()) {
+    common::Sweep::writeCSV(options.get("sweep").empty() ? "sweep.csv" : options.get("sweep"));
+    common::Sweep::printStatistics();
+  }
   return 0;
 }
@@ -32,11 +32,11 @@ thread_local std::atomic<uint64_t> mv::nofalsenegatives::transaction::
         0);
 
 template <>
-thread_local uint8_t mv::nofalsenegatives::transaction::
-    TransactionCoordinator<atom::ExtentVector, atom::AtomicExtentVector, common::StdAllocator>::current_core_(0xFF);
+thread_local uint16_t mv::nofalsenegatives::transaction::
+    TransactionCoordinator<atom::ExtentVector, atom::AtomicExtentVector, common::StdAllocator>::current_core_(0xFFFF);
 template <>
-thread_local uint8_t mv::nofalsenegatives::transaction::
-    TransactionCoordinator<atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>::current_core_(0xFF);
+thread_local uint16_t mv::nofalsenegatives::transaction::
+    TransactionCoordinator<atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>::current_core_(0xFFFF);
 
 template <>
 thread_local std::unordered_set<uint64_t> mv::nofalsenegatives::transaction::
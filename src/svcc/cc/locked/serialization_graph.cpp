@@ -249,7 +249,7 @@ void SerializationGraph::abort(uint64_t transaction, std::unordered_set<uint64_t
   }
 }
 
-bool SerializationGraph::checkCommited(uint64_t transaction) {
+bool SerializationGraph::checkCommited(uint64_t transaction, const std::function<void()>& committing) {
   std::lock_guard<tbb::spin_mutex> lock(mut);
   Node* this_node;
   bool lookup = node_map_.lookup(transaction, this_node);
@@ -271,7 +271,7 @@ bool SerializationGraph::checkCommited(uint64_t transaction) {
     return false;
   }
 
-  bool success = erase_graph_constraints(transaction);
+  bool success = erase_graph_constraints(transaction, committing);
   if (success) {
     cleanup(this_node);
     node_map_.erase(transaction);
@@ -279,13 +279,15 @@ bool SerializationGraph::checkCommited(uint64_t transaction) {
   return success;
 }
 
-bool SerializationGraph::erase_graph_constraints(uint64_t transaction) {
+bool SerializationGraph::erase_graph_constraints(uint64_t transaction, const std::function<void()>& committing) {
   Node* this_node;
   bool lookup = node_map_.lookup(transaction, this_node);
   if (lookup) {
     if (cycleCheckNaive(transaction)) {
       return false;
     }
+    if (committing)
+      committing();
     this_node->commited_ = true;
 
 #ifdef SGLOGGER
@@ -266,7 +266,7 @@ void SerializationGraph::abort(std::unordered_set<uint64_t>& oset) {
   oset.emplace(this_node->abort_through_);
 }
 
-bool SerializationGraph::checkCommited() {
+bool SerializationGraph::checkCommited(const std::function<void()>& committing) {
   if (this_node->abort_ || this_node->cascading_abort_) {
     return false;
   }
@@ -291,7 +291,7 @@ bool SerializationGraph::checkCommited() {
     return false;
   }
 
-  bool success = erase_graph_constraints();
+  bool success = erase_graph_constraints(committing);
 
   if (success) {
     cleanup();
@@ -299,12 +299,14 @@ bool SerializationGraph::checkCommited() {
   return success;
 }
 
-bool SerializationGraph::erase_graph_constraints() {
+bool SerializationGraph::erase_graph_constraints(const std::function<void()>& committing) {
   if (cycleCheckNaive()) {
     this_node->abort_ = true;
     return false;
   }
 
+  if (committing)
+    committing();
   this_node->commited_ = true;
 
 #ifdef SGLOGGER
@@ -30,9 +30,9 @@ thread_local std::atomic<uint64_t>
     nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>::transaction_counter_(0);
 
 template <>
-thread_local uint8_t nofalsenegatives::transaction::TransactionCoordinator<common::StdAllocator>::current_core_(0xFF);
+thread_local uint16_t nofalsenegatives::transaction::TransactionCoordinator<common::StdAllocator>::current_core_(0xFFFF);
 template <>
-thread_local uint8_t nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>::current_core_(0xFF);
+thread_local uint16_t nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>::current_core_(0xFFFF);
 
 template <>
 thread_local std::unordered_set<uint64_t>
@@ -425,7 +425,7 @@ void SerializationGraph::abort(uint64_t transaction, std::unordered_set<uint64_t
   }
 }
 
-bool SerializationGraph::checkCommited(uint64_t transaction) {
+bool SerializationGraph::checkCommited(uint64_t transaction, const std::function<void()>& committing) {
   Node* this_node;
   StepGuard sg{sm_};
   uint64_t ctr = sg.getCtr();
@@ -458,7 +458,7 @@ bool SerializationGraph::checkCommited(uint64_t transaction) {
 
   StepGuard sg_check{sm_};
 
-  bool success = erase_graph_constraints(transaction, sg_check.getCtr());
+  bool success = erase_graph_constraints(transaction, sg_check.getCtr(), committing);
   if (success) {
     sg_check.destroy();
     StepGuard sg_clean{sm_};
@@ -469,7 +469,9 @@ bool SerializationGraph::checkCommited(uint64_t transaction) {
   return success;
 }
 
-bool SerializationGraph::erase_graph_constraints(uint64_t transaction, uint64_t ctr) {
+bool SerializationGraph::erase_graph_constraints(uint64_t transaction,
+                                                 uint64_t ctr,
+                                                 const std::function<void()>& committing) {
   Node* this_node;
   bool lookup = node_map_.lookup(transaction, this_node);
   if (lookup) {
@@ -477,6 +479,8 @@ bool SerializationGraph::erase_graph_constraints(uint64_t transaction, uint64_t
       return false;
     }
 
+    if (committing)
+      committing();
     node_map_.erase(transaction);
     order_map_.erase(transaction);
     this_node->commited_ = true;
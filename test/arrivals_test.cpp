@@ -0,0 +1,94 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/arrivals.hpp"
+#include "common/run_control.hpp"
+#include "common/timer.hpp"
+#include <chrono>
+#include <thread>
+#include <gtest/gtest.h>
+
+using common::Arrivals;
+using common::Timer;
+
+TEST(Arrivals, ClosedLoopAndScannersAreNotPaced) {
+  Arrivals::setRate(0);
+  std::thread([]() {
+    Arrivals::open();
+    Arrivals arrivals;
+    arrivals.start();
+    ASSERT_FALSE(arrivals.paced());
+  }).join();
+
+  // the thread did not call open, i.e., it is a scanner
+  Arrivals::setRate(1000);
+  std::thread([]() {
+    Arrivals arrivals;
+    arrivals.start();
+    ASSERT_FALSE(arrivals.paced());
+  }).join();
+  Arrivals::setRate(0);
+}
+
+TEST(Arrivals, ConstantArrivalsAreEvenlySpaced) {
+  ASSERT_TRUE(common::RunControl::configure(nullptr));
+  Arrivals::setRate(20000);
+  Arrivals::setPoisson(false);
+  std::thread([]() {
+    Arrivals::open();
+    Arrivals arrivals;
+    arrivals.start();
+    ASSERT_TRUE(arrivals.paced());
+    double gap = 1e9 / 20000 / Timer::nsPerTick();
+    auto start = std::chrono::steady_clock::now();
+    uint64_t first = arrivals.arrive(), last = first;
+    for (int i = 1; i <= 200; i++) {
+      uint64_t arrival = arrivals.arrive();
+      ASSERT_NEAR(static_cast<double>(arrival - last), gap, 1);
+      ASSERT_LE(arrival, Timer::now());
+      last = arrival;
+    }
+    // 200 gaps of 50us, the worker never starts before the arrival
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::microseconds(200 * 50 - 100));
+  }).join();
+  Arrivals::setRate(0);
+  Arrivals::setPoisson(true);
+}
+
+TEST(Arrivals, PoissonGapsHaveTheMeanOfTheRate) {
+  Arrivals::setRate(200000);
+  Arrivals::setPoisson(true);
+  std::thread([]() {
+    Arrivals::open();
+    Arrivals arrivals;
+    arrivals.start();
+    uint64_t first = arrivals.arrive(), last = first;
+    constexpr int n = 4000;
+    for (int i = 0; i < n; i++) {
+      last = arrivals.arrive();
+    }
+    // the mean of n exponential gaps of 5us has a standard deviation of 5us / sqrt(n)
+    double mean = Timer::nanoseconds(last - first) / static_cast<double>(n);
+    ASSERT_NEAR(mean, 5000, 500);
+  }).join();
+  Arrivals::setRate(0);
+}
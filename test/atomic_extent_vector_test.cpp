@@ -21,8 +21,10 @@
 //
 
 #include "ds/atomic_extent_vector.hpp"
+#include <cstdlib>
 #include <gtest/gtest.h>
 #include <tbb/tbb.h>
+#include <unistd.h>
 
 TEST(AtomicExtentVector, Insert) {
   atom::AtomicExtentVector<uint64_t> vector;
@@ -212,3 +214,41 @@ TEST(AtomicExtentVector, InsertDeleteReadMultithread) {
   ASSERT_EQ(i, t);
   ASSERT_EQ(c, counter);
 }
+
+TEST(AtomicExtentVector, WriteMap) {
+  atom::AtomicExtentVector<uint64_t> vector;
+  vector.reserve(64);
+  for (uint64_t i = 0; i < 1000; i++) {
+    vector.push_back(i);
+  }
+
+  char path[] = "/tmp/atomic_extent_vector_XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_GE(fd, 0);
+  unlink(path);
+  ASSERT_TRUE(vector.write(fd, 4096));
+
+  for (bool hugepages : {false, true}) {
+    atom::AtomicExtentVector<uint64_t> mapped;
+    mapped.reserve(16);
+    ASSERT_TRUE(mapped.map(fd, 4096, vector.size(), vector.max_size(), true, hugepages));
+    ASSERT_EQ(mapped.size(), 1000u);
+
+    uint64_t i = 0;
+    for (auto l : mapped) {
+      ASSERT_EQ(l, i);
+      i++;
+    }
+    ASSERT_EQ(i, 1000u);
+
+    mapped.atomic_replace(7, 42);
+    mapped.push_back(1000);
+    ASSERT_EQ(mapped[7], 42u);
+    ASSERT_EQ(mapped[1000], 1000u);
+  }
+
+  atom::AtomicExtentVector<uint64_t> unchanged;
+  ASSERT_TRUE(unchanged.map(fd, 4096, vector.size(), vector.max_size(), false, false));
+  ASSERT_EQ(unchanged[7], 7u);
+  close(fd);
+}
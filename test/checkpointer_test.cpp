@@ -0,0 +1,190 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/checkpointer.hpp"
+#include "common/recovery.hpp"
+#include "common/redo_log.hpp"
+#include "ds/extent_vector.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+namespace {
+std::string temporaryDirectory() {
+  char directory[] = "/tmp/nfn_checkpointer_XXXXXX";
+  return mkdtemp(directory);
+}
+
+struct Write {
+  atom::ExtentVector<uint64_t>* column;
+  uint64_t offset;
+  uint64_t value;
+
+  void redo(common::RedoLog& log) { log.append(column, offset, value); }
+};
+
+// the newest checkpoint with a manifest, i.e., a complete one, empty if there is none
+std::string latestCheckpoint(const std::string& directory) {
+  std::string latest;
+  uint64_t sequence = 0;
+  DIR* dir = opendir(directory.c_str());
+  if (dir == nullptr)
+    return latest;
+  while (auto entry = readdir(dir)) {
+    std::string name{entry->d_name};
+    if (name.compare(0, 11, "checkpoint.") != 0 || access((directory + "/" + name + "/manifest").c_str(), F_OK) != 0)
+      continue;
+    uint64_t n = std::stoull(name.substr(11));
+    if (n > sequence) {
+      sequence = n;
+      latest = directory + "/" + name;
+    }
+  }
+  closedir(dir);
+  return latest;
+}
+
+common::Checkpointer::Header readHeader(std::ifstream& file) {
+  common::Checkpointer::Header header{};
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  return header;
+}
+}  // namespace
+
+TEST(Checkpointer, FuzzyCheckpointOfAColumn) {
+  constexpr uint64_t rows = 1000;
+  auto directory = temporaryDirectory();
+  atom::ExtentVector<uint64_t> column;
+  column.reserve(rows);
+  for (uint64_t i = 0; i < rows; i++) {
+    column.push_back(0);
+  }
+  std::atomic<uint64_t> epochs{1};
+
+  common::RedoLog log{directory, true, &epochs};
+  log.column("value", column);
+  ASSERT_TRUE(log.open());
+  common::Checkpointer checkpointer{&log, 1, 1.0, [&](common::Checkpointer& c) { c.column("value", column); }};
+  checkpointer.start();
+
+  // the values are written in place before their commit, as the single version protocols do, while checkpoints copy
+  // the column and the epoch advances
+  uint64_t last = 0;
+  std::thread worker([&]() {
+    Write w{&column, 0, 0};
+    std::vector<Write*> write_set{&w};
+    for (uint64_t i = 1; i <= 20 * rows || latestCheckpoint(directory).empty(); i++) {
+      w.offset = (i * 7) % rows;
+      w.value = i;
+      column.replace(w.offset, w.value);
+      log.commit(write_set, false, log.reserve());
+      if (i % 64 == 0)
+        epochs++;
+      last = i;
+    }
+  });
+  worker.join();
+  checkpointer.stop();
+  log.close();
+
+  auto checkpoint = latestCheckpoint(directory);
+  ASSERT_FALSE(checkpoint.empty());
+  std::ifstream manifest{checkpoint + "/manifest", std::ios::binary};
+  auto header = readHeader(manifest);
+  ASSERT_EQ(header.magic, common::Checkpointer::magic);
+  ASSERT_EQ(header.rows, 1u);
+  ASSERT_GE(header.epoch, 1u);
+  ASSERT_LE(header.epoch, epochs.load());
+
+  // a fuzzy copy holds for every row the initial value or one written to it, at most the last one
+  std::ifstream values{checkpoint + "/value.col", std::ios::binary};
+  header = readHeader(values);
+  ASSERT_EQ(header.magic, common::Checkpointer::magic);
+  ASSERT_EQ(header.element_size, sizeof(uint64_t));
+  ASSERT_EQ(header.rows, rows);
+  values.seekg(common::Checkpointer::page_size);
+  for (uint64_t i = 0; i < rows; i++) {
+    uint64_t value;
+    ASSERT_TRUE(values.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    ASSERT_LE(value, last);
+    ASSERT_TRUE(value == 0 || (value * 7) % rows == i) << i;
+  }
+
+  std::system(("rm -rf " + directory).c_str());
+}
+
+TEST(Checkpointer, FuzzyCheckpointAndLogRecovery) {
+  constexpr uint64_t rows = 1000;
+  auto directory = temporaryDirectory();
+  atom::ExtentVector<uint64_t> column;
+  column.reserve(rows);
+  for (uint64_t i = 0; i < rows; i++) {
+    column.push_back(0);
+  }
+  std::atomic<uint64_t> epochs{1};
+
+  common::RedoLog log{directory, true, &epochs};
+  log.column("value", column);
+  ASSERT_TRUE(log.open());
+  common::Checkpointer checkpointer{&log, 1, 1.0, [&](common::Checkpointer& c) { c.column("value", column); }};
+  checkpointer.start();
+
+  std::thread worker([&]() {
+    Write w{&column, 0, 0};
+    std::vector<Write*> write_set{&w};
+    for (uint64_t i = 1; i <= 20 * rows || latestCheckpoint(directory).empty(); i++) {
+      w.offset = (i * 7) % rows;
+      w.value = i;
+      column.replace(w.offset, w.value);
+      log.commit(write_set, false, log.reserve());
+      if (i % 64 == 0)
+        epochs++;
+    }
+  });
+  worker.join();
+  checkpointer.stop();
+  log.close();
+
+  // the checkpoint made consistent by the log from its epoch on
+  atom::ExtentVector<uint64_t> recovered;
+  recovered.reserve(rows);
+  for (uint64_t i = 0; i < rows; i++) {
+    recovered.push_back(0);
+  }
+  common::Recovery recovery{directory, 2};
+  ASSERT_TRUE(recovery.open());
+  ASSERT_FALSE(recovery.checkpoint().empty());
+  recovery.column("value", recovered);
+  ASSERT_TRUE(recovery.run());
+  for (uint64_t i = 0; i < rows; i++) {
+    ASSERT_EQ(recovered[i], column[i]);
+  }
+
+  std::system(("rm -rf " + directory).c_str());
+}
@@ -0,0 +1,49 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/csv_writer.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include <gtest/gtest.h>
+
+TEST(CSVWriter, HeaderStartsNewFilesOnly) {
+  char name[] = "/tmp/nfn_csv_XXXXXX";
+  close(mkstemp(name));
+
+  common::CSVWriter csvwriter;
+  csvwriter.setLogName(name);
+  csvwriter.setHeader("a;b");
+  csvwriter.log("1;2");
+  csvwriter.log("3;4");
+
+  std::ifstream file(name);
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(file, line);) {
+    lines.push_back(line);
+  }
+  ASSERT_EQ(lines, (std::vector<std::string>{"a;b", "1;2", "3;4"}));
+  std::remove(name);
+}
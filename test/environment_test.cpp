@@ -0,0 +1,73 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/environment.hpp"
+#include "common/run_control.hpp"
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+TEST(Environment, Duration) {
+  ASSERT_TRUE(common::RunControl::configure(nullptr));
+  ASSERT_FALSE(common::RunControl::timed());
+  ASSERT_TRUE(common::RunControl::configure("10"));
+  ASSERT_TRUE(common::RunControl::timed());
+  ASSERT_TRUE(common::RunControl::configure("2,10"));
+  ASSERT_TRUE(common::RunControl::configure("2,10,1.5"));
+  ASSERT_FALSE(common::RunControl::configure("2,10,1,4"));
+  ASSERT_FALSE(common::RunControl::configure("2,10,"));
+  ASSERT_FALSE(common::RunControl::configure("2,0"));
+  ASSERT_FALSE(common::RunControl::configure("-1,10"));
+  ASSERT_FALSE(common::RunControl::configure("10s"));
+  ASSERT_TRUE(common::RunControl::configure(nullptr));
+}
+
+TEST(Environment, MalformedValues) {
+  unsetenv("NFN_DURATION");
+  unsetenv("NFN_SAMPLE");
+  unsetenv("NFN_LOG_COMMIT");
+  unsetenv("NFN_CHECKPOINT_SHARE");
+  ASSERT_TRUE(common::Environment::check());
+
+  auto check = [](const char* name, const char* value) {
+    setenv(name, value, 1);
+    bool valid = common::Environment::check();
+    unsetenv(name);
+    return valid;
+  };
+  ASSERT_TRUE(check("NFN_DURATION", "1,5"));
+  ASSERT_FALSE(check("NFN_DURATION", "1,5,1,1"));
+  ASSERT_FALSE(common::RunControl::timed());
+  ASSERT_TRUE(check("NFN_SAMPLE", "100"));
+  ASSERT_FALSE(check("NFN_SAMPLE", "10ms"));
+  ASSERT_TRUE(check("NFN_TRACE_SEED", "0x2a"));
+  ASSERT_FALSE(check("NFN_TRACE_SEED", "-1"));
+  ASSERT_TRUE(check("NFN_LOG_COMMIT", "epoch"));
+  ASSERT_FALSE(check("NFN_LOG_COMMIT", "async"));
+  ASSERT_FALSE(check("NFN_CHECKPOINT", "0"));
+  ASSERT_TRUE(check("NFN_CHECKPOINT_SHARE", "0.5"));
+  ASSERT_FALSE(check("NFN_CHECKPOINT_SHARE", "2"));
+  ASSERT_FALSE(check("NFN_SNAPSHOT_MAP", "eager"));
+  ASSERT_TRUE(check("NFN_PERF", ""));
+
+  // unknown variables are only reported
+  ASSERT_TRUE(check("NFN_DURATON", "1,5"));
+}
@@ -0,0 +1,98 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/executor.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+#include <gtest/gtest.h>
+
+using common::Executor;
+
+TEST(Executor, RunsOwnTasksFirstAndStealsTheNewest) {
+  Executor<uint64_t> executor;
+  executor.start(2);
+  uint64_t task;
+  ASSERT_FALSE(executor.take(0, task));
+
+  for (uint64_t i = 1; i <= 3; ++i)
+    executor.submit(0, uint64_t{i});
+  executor.submit(1, 10);
+  ASSERT_EQ(executor.queued(0), 3u);
+
+  // the own queue runs from the front
+  ASSERT_TRUE(executor.take(0, task));
+  ASSERT_EQ(task, 1u);
+  ASSERT_TRUE(executor.take(1, task));
+  ASSERT_EQ(task, 10u);
+  // an idle worker steals from the back
+  ASSERT_TRUE(executor.take(1, task));
+  ASSERT_EQ(task, 3u);
+  ASSERT_TRUE(executor.take(0, task));
+  ASSERT_EQ(task, 2u);
+  ASSERT_FALSE(executor.take(0, task));
+  ASSERT_FALSE(executor.take(1, task));
+}
+
+TEST(Executor, DefersAbortedTasksBehindTheReadyOnes) {
+  Executor<uint64_t> executor;
+  executor.start(1);
+  executor.submit(0, 1);
+  executor.submit(0, 2);
+
+  uint64_t task;
+  ASSERT_TRUE(executor.take(0, task));
+  ASSERT_EQ(task, 1u);
+  executor.defer(0, std::move(task));
+  ASSERT_TRUE(executor.take(0, task));
+  ASSERT_EQ(task, 2u);
+  ASSERT_TRUE(executor.take(0, task));
+  ASSERT_EQ(task, 1u);
+  ASSERT_FALSE(executor.take(0, task));
+}
+
+TEST(Executor, EveryTaskRunsOnce) {
+  constexpr uint64_t workers = 4, tasks = 20000;
+  Executor<uint64_t> executor;
+  executor.start(workers);
+  std::vector<std::atomic<uint32_t>> runs(workers * tasks);
+  std::vector<std::thread> threads;
+  for (uint64_t w = 0; w < workers; ++w) {
+    threads.emplace_back([&, w]() {
+      uint64_t task;
+      for (uint64_t i = 0; i < tasks; ++i) {
+        executor.submit(w, w * tasks + i);
+        // keep the window of the worker, the others steal from it
+        while (executor.queued(w) > Executor<uint64_t>::window && executor.take(w, task))
+          runs[task]++;
+      }
+      while (executor.take(w, task))
+        runs[task]++;
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  for (auto& count : runs)
+    ASSERT_EQ(count, 1u);
+}
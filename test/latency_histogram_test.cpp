@@ -0,0 +1,84 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/latency_histogram.hpp"
+#include <memory>
+#include <gtest/gtest.h>
+
+using common::LatencyHistogram;
+
+TEST(LatencyHistogram, SmallValuesAreExact) {
+  auto h = std::make_unique<LatencyHistogram>();
+  ASSERT_EQ(h->percentile(0.5), 0u);
+  for (uint64_t v = 1; v <= 2 * LatencyHistogram::sub_buckets; v++) {
+    h->record(v);
+  }
+  ASSERT_EQ(h->count(), 2 * LatencyHistogram::sub_buckets);
+  ASSERT_EQ(h->percentile(0), 1u);
+  ASSERT_EQ(h->percentile(0.5), LatencyHistogram::sub_buckets);
+  ASSERT_EQ(h->percentile(1), 2 * LatencyHistogram::sub_buckets);
+  ASSERT_DOUBLE_EQ(h->mean(), (2 * LatencyHistogram::sub_buckets + 1) / 2.0);
+}
+
+TEST(LatencyHistogram, BucketsBoundTheRelativeError) {
+  // a value is reported as the highest value of its bucket, the larger second value keeps it from being capped by max
+  for (uint64_t v = 1; v < (1ull << 36); v += v / 7 + 1) {
+    auto h = std::make_unique<LatencyHistogram>();
+    h->record(v);
+    h->record(LatencyHistogram::max_value);
+    auto p = h->percentile(0.5);
+    ASSERT_GE(p, v);
+    ASSERT_LE(p - v, v / LatencyHistogram::sub_buckets);
+  }
+}
+
+TEST(LatencyHistogram, PercentilesOfUniformValues) {
+  auto h = std::make_unique<LatencyHistogram>();
+  for (uint64_t v = 1; v <= 100000; v++) {
+    h->record(v * 1000);
+  }
+  for (double q : {0.5, 0.9, 0.99, 0.999}) {
+    double expected = q * 100000 * 1000;
+    ASSERT_GE(h->percentile(q), expected);
+    ASSERT_LE(h->percentile(q), expected * (1 + 1.0 / LatencyHistogram::sub_buckets));
+  }
+  ASSERT_EQ(h->percentile(1), 100000u * 1000);
+  ASSERT_EQ(h->max(), 100000u * 1000);
+}
+
+TEST(LatencyHistogram, MergeAndClamp) {
+  auto a = std::make_unique<LatencyHistogram>();
+  auto b = std::make_unique<LatencyHistogram>();
+  for (uint64_t v = 1; v <= 50; v++) {
+    a->record(v);
+    b->record(v + 50);
+  }
+  a->merge(*b);
+  ASSERT_EQ(a->count(), 100u);
+  ASSERT_EQ(a->max(), 100u);
+  ASSERT_EQ(a->percentile(0.5), 50u);
+
+  // values beyond the range end up in the last bucket
+  b->record(LatencyHistogram::max_value * 4);
+  ASSERT_EQ(b->max(), LatencyHistogram::max_value * 4);
+  ASSERT_EQ(b->percentile(1), LatencyHistogram::max_value);
+}
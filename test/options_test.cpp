@@ -0,0 +1,144 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/options.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace {
+bool parse(common::Options& options, std::vector<std::string> args) {
+  args.insert(args.begin(), "db");
+  std::vector<char*> argv;
+  for (auto& arg : args) {
+    argv.push_back(&arg[0]);
+  }
+  return options.parse(argv.size(), argv.data());
+}
+}  // namespace
+
+TEST(Options, Positional) {
+  common::Options options;
+  ASSERT_TRUE(parse(options, {"svcc_ycsb", "TicToc", "1000", "200", "1,2", "16", "0.5", "0.1", "0.9"}));
+  ASSERT_FALSE(options.recover());
+  ASSERT_EQ(options.get("benchmark"), "svcc_ycsb");
+  ASSERT_EQ(options.get("algorithm"), "TicToc");
+  ASSERT_EQ(options.number("size"), 1000u);
+  ASSERT_EQ(options.number("transactions"), 200u);
+  ASSERT_EQ(options.list<uint64_t>("cores"), (std::vector<uint64_t>{1, 2}));
+  ASSERT_EQ(options.number("ops"), 16u);
+  ASSERT_DOUBLE_EQ(options.real("read"), 0.5);
+  ASSERT_DOUBLE_EQ(options.real("scan"), 0.1);
+  ASSERT_DOUBLE_EQ(options.real("theta"), 0.9);
+  ASSERT_FALSE(options.has("sweep"));
+  ASSERT_EQ(options.number("repeat", 3), 3u);
+
+  common::Options recover;
+  ASSERT_TRUE(parse(recover, {"recover", "svcc_tpcc", "2PL", "4", "100", "8"}));
+  ASSERT_TRUE(recover.recover());
+  ASSERT_EQ(recover.get("benchmark"), "svcc_tpcc");
+}
+
+TEST(Options, Named) {
+  common::Options options;
+  ASSERT_TRUE(parse(options, {"--benchmark=svcc_tpcc", "--protocol", "NoFalseNegatives", "--size=4",
+                              "--transactions=10", "--cores=1-4", "--sweep", "--placement", "compact", "--recover"}));
+  ASSERT_TRUE(options.recover());
+  ASSERT_EQ(options.get("benchmark"), "svcc_tpcc");
+  ASSERT_EQ(options.get("protocol"), "NoFalseNegatives");
+  ASSERT_EQ(options.list<uint64_t>("cores"), (std::vector<uint64_t>{1, 2, 3, 4}));
+  ASSERT_TRUE(options.has("sweep"));
+  ASSERT_EQ(options.get("sweep"), "");
+  ASSERT_EQ(options.get("placement"), "compact");
+}
+
+TEST(Options, FlagsBeforePositionals) {
+  common::Options options;
+  ASSERT_TRUE(parse(options, {"--recover", "--scramble", "--executor", "--sweep=runs.csv", "--interleave", "--theta=0.5",
+                              "svcc_ycsb", "TicToc", "100", "10", "2"}));
+  ASSERT_TRUE(options.recover());
+  ASSERT_TRUE(options.has("scramble"));
+  ASSERT_TRUE(options.has("executor"));
+  ASSERT_EQ(options.get("sweep"), "runs.csv");
+  ASSERT_EQ(options.get("interleave"), "");
+  ASSERT_DOUBLE_EQ(options.real("theta"), 0.5);
+  ASSERT_EQ(options.get("benchmark"), "svcc_ycsb");
+  ASSERT_EQ(options.get("protocol"), "TicToc");
+  ASSERT_EQ(options.number("cores"), 2u);
+}
+
+TEST(Options, ConfigFile) {
+  char name[] = "/tmp/nfn_options_XXXXXX";
+  close(mkstemp(name));
+  {
+    std::ofstream config(name);
+    config << "# ycsb sweep\n"
+           << "benchmark = svcc_ycsb\n"
+           << "protocol=NoFalseNegatives,TicToc  # both\n"
+           << "\n"
+           << "size=1000\ntransactions=100\ncores=1-2\ntheta=0-0.9:0.3\n";
+  }
+
+  // later options override the file
+  common::Options options;
+  ASSERT_TRUE(parse(options, {std::string{"--config="} + name, "--cores=8"}));
+  ASSERT_EQ(options.get("benchmark"), "svcc_ycsb");
+  ASSERT_EQ(options.names("protocol"), (std::vector<std::string>{"NoFalseNegatives", "TicToc"}));
+  ASSERT_EQ(options.list<uint64_t>("cores"), (std::vector<uint64_t>{8}));
+  auto thetas = options.list("custom4");
+  ASSERT_EQ(thetas.size(), 4u);
+  ASSERT_NEAR(thetas.back(), 0.9, 1e-9);
+
+  {
+    std::ofstream config(name);
+    config << "benchmark=svcc_ycsb\nthetas=0.5\n";
+  }
+  common::Options unknown;
+  ASSERT_FALSE(parse(unknown, {std::string{"--config="} + name, "TicToc", "1", "1", "1"}));
+  std::remove(name);
+
+  common::Options missing;
+  ASSERT_FALSE(parse(missing, {"--config=/nonexistent/nfn.conf", "svcc_ycsb", "TicToc", "1", "1", "1"}));
+}
+
+TEST(Options, Errors) {
+  common::Options missing;
+  ASSERT_FALSE(parse(missing, {"svcc_ycsb", "TicToc", "1000", "200"}));
+  common::Options unknown;
+  ASSERT_FALSE(parse(unknown, {"svcc_ycsb", "TicToc", "1000", "200", "1", "--unknown=1"}));
+  common::Options unexpected;
+  ASSERT_FALSE(parse(unexpected, {"svcc_ycsb", "TicToc", "1", "1", "1", "1", "1", "1", "1", "1"}));
+}
+
+TEST(Options, ListRanges) {
+  common::Options options;
+  ASSERT_TRUE(parse(options, {"svcc_ycsb", "TicToc", "1", "1", "1-7:2,8", "--rate=4-32:4", "--fields=10,2-3"}));
+  ASSERT_EQ(options.list<uint64_t>("cores"), (std::vector<uint64_t>{1, 3, 5, 7, 8}));
+  ASSERT_EQ(options.list<uint64_t>("rate"), (std::vector<uint64_t>{4, 8, 12, 16, 20, 24, 28, 32}));
+  ASSERT_EQ(options.list<uint64_t>("fields"), (std::vector<uint64_t>{10, 2, 3}));
+  ASSERT_EQ(options.number("cores"), 1u);
+  ASSERT_TRUE(options.list("oversubscribe").empty());
+}
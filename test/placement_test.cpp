@@ -0,0 +1,74 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/placement.hpp"
+#include <thread>
+#include <vector>
+#include <sched.h>
+#include <stdint.h>
+#include <gtest/gtest.h>
+
+using common::Placement;
+
+TEST(Placement, ParsesKernelLists) {
+  ASSERT_EQ(Placement::parseList("0"), (std::vector<uint32_t>{0}));
+  ASSERT_EQ(Placement::parseList("0-3,8"), (std::vector<uint32_t>{0, 1, 2, 3, 8}));
+  ASSERT_EQ(Placement::parseList("2,4-5,7"), (std::vector<uint32_t>{2, 4, 5, 7}));
+  ASSERT_TRUE(Placement::parseList("").empty());
+  ASSERT_TRUE(Placement::parseList("a-b").empty());
+}
+
+TEST(Placement, OrdersOnlyAllowedCpus) {
+  cpu_set_t mask;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(cpu_set_t), &mask), 0);
+
+  for (auto policy : {"linear", "compact", "scatter", "cores"}) {
+    ASSERT_TRUE(Placement::configure(policy));
+    ASSERT_EQ(Placement::cpus(), static_cast<uint64_t>(CPU_COUNT(&mask))) << policy;
+    for (uint64_t worker = 0; worker < Placement::cpus(); ++worker)
+      ASSERT_TRUE(CPU_ISSET(Placement::cpu(worker), &mask)) << policy;
+  }
+  ASSERT_FALSE(Placement::configure("unknown"));
+  Placement::configure("linear");
+}
+
+TEST(Placement, RejectsListsOutsideTheMask) {
+  cpu_set_t mask;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(cpu_set_t), &mask), 0);
+  uint32_t allowed = 0, outside = CPU_SETSIZE - 1;
+  while (!CPU_ISSET(allowed, &mask))
+    allowed++;
+
+  ASSERT_TRUE(Placement::configure("list", {allowed}));
+  ASSERT_EQ(Placement::cpu(3), allowed);
+  ASSERT_FALSE(Placement::configure("list", {allowed, outside}));
+  ASSERT_FALSE(Placement::configure("list", {}));
+  Placement::configure("linear");
+}
+
+TEST(Placement, WaitRunsTheWorkerOnItsCpu) {
+  ASSERT_TRUE(Placement::configure("linear"));
+  std::thread([]() {
+    Placement::wait(0);
+    ASSERT_EQ(static_cast<uint32_t>(sched_getcpu()), Placement::cpu(0));
+  }).join();
+}
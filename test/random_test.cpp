@@ -0,0 +1,57 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/random.hpp"
+#include <random>
+#include <stdint.h>
+#include <gtest/gtest.h>
+
+using common::Random;
+
+TEST(Random, MatchesTheReferenceOutput) {
+  // the first outputs of xoshiro256** seeded by splitmix64 with seed 0, computed by the reference implementation
+  const uint64_t reference[] = {0x99ec5f36cb75f2b4, 0xbf6e1f784956452a, 0x1a5f849d4933e6e0, 0x6aa594f1262d2d2c,
+                                0xbba5ad4a1f842e59};
+  Random gen{0};
+  for (auto expected : reference) {
+    ASSERT_EQ(gen(), expected);
+  }
+
+  gen.seed(0);
+  ASSERT_EQ(gen(), reference[0]);
+}
+
+TEST(Random, RealAndBelowStayInRange) {
+  Random gen{42};
+  for (int i = 0; i < 100000; ++i) {
+    double r = gen.real();
+    ASSERT_GE(r, 0.0);
+    ASSERT_LT(r, 1.0);
+    ASSERT_LT(gen.below(7), 7u);
+  }
+
+  // satisfies UniformRandomBitGenerator
+  std::uniform_int_distribution<int> dis(1, 6);
+  int x = dis(gen);
+  ASSERT_GE(x, 1);
+  ASSERT_LE(x, 6);
+}
@@ -0,0 +1,205 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/recovery.hpp"
+#include "common/redo_log.hpp"
+#include "ds/extent_vector.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <fcntl.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace {
+std::string temporaryDirectory() {
+  char directory[] = "/tmp/nfn_recovery_XXXXXX";
+  return mkdtemp(directory);
+}
+
+struct Write {
+  atom::ExtentVector<uint64_t>* column;
+  uint64_t offset;
+  uint64_t value;
+
+  void redo(common::RedoLog& log) { log.append(column, offset, value); }
+};
+
+// replays the log of directory with threads into a column of rows zeros
+std::vector<uint64_t> recover(const std::string& directory, uint64_t rows, uint32_t threads) {
+  atom::ExtentVector<uint64_t> column;
+  column.reserve(rows);
+  for (uint64_t i = 0; i < rows; i++) {
+    column.push_back(0);
+  }
+  common::Recovery recovery{directory, threads};
+  if (!recovery.open())
+    return {};
+  recovery.column("value", column);
+  if (!recovery.run())
+    return {};
+  std::vector<uint64_t> values;
+  for (uint64_t i = 0; i < rows; i++) {
+    values.push_back(column[i]);
+  }
+  return values;
+}
+
+bool setDurableEpoch(const std::string& directory, uint64_t epoch) {
+  common::RedoLog::LogHeader header{common::RedoLog::magic, epoch};
+  int fd = open((directory + "/redo.log").c_str(), O_WRONLY);
+  bool written = fd >= 0 && pwrite(fd, &header, sizeof(header), 0) == sizeof(header);
+  if (fd >= 0)
+    close(fd);
+  return written;
+}
+}  // namespace
+
+TEST(Recovery, ParallelReplayUpToDurableEpoch) {
+  constexpr uint64_t rows = 1000;
+  auto directory = temporaryDirectory();
+  atom::ExtentVector<uint64_t> column;
+  column.reserve(rows);
+  for (uint64_t i = 0; i < rows; i++) {
+    column.push_back(0);
+  }
+  std::atomic<uint64_t> epochs{1};
+
+  // every row is written by several commits per epoch, s.t. only the last one in lsn order must survive the replay
+  common::RedoLog log{directory, true, &epochs};
+  log.column("value", column);
+  ASSERT_TRUE(log.open());
+  Write first{&column, 0, 0}, second{&column, 0, 0};
+  std::vector<Write*> write_set{&first, &second};
+  for (uint64_t epoch = 1; epoch <= 2; epoch++) {
+    epochs = epoch;
+    for (uint64_t i = 0; i < 2 * rows; i++) {
+      first.offset = i % rows;
+      first.value = epoch * rows * 10 + i;
+      second.offset = (i + 1) % rows;
+      second.value = epoch * rows * 10 + 5 * rows + i + 1;
+      log.commit(write_set, false, log.reserve());
+    }
+  }
+  log.close();
+
+  // row 0 is last written by the second write of the last commit, every other row by the first write of commit rows + r
+  auto expected = [&](uint64_t epoch, uint64_t row) {
+    return epoch * rows * 10 + (row == 0 ? 7 * rows : rows + row);
+  };
+  ASSERT_TRUE(setDurableEpoch(directory, 1));
+  auto values = recover(directory, rows, 4);
+  ASSERT_EQ(values.size(), rows);
+  for (uint64_t i = 0; i < rows; i++) {
+    ASSERT_EQ(values[i], expected(1, i));
+  }
+
+  ASSERT_TRUE(setDurableEpoch(directory, 2));
+  values = recover(directory, rows, 3);
+  ASSERT_EQ(values.size(), rows);
+  for (uint64_t i = 0; i < rows; i++) {
+    ASSERT_EQ(values[i], expected(2, i));
+  }
+
+  std::system(("rm -rf " + directory).c_str());
+}
+
+TEST(Recovery, StopsAtTheFirstMissingLsn) {
+  auto directory = temporaryDirectory();
+  atom::ExtentVector<uint64_t> column;
+  column.reserve(2);
+  column.push_back(0);
+  column.push_back(0);
+  std::atomic<uint64_t> epochs{1};
+
+  // lsn 2 is reserved but its record never written, e.g., the system crashed while it was committing
+  common::RedoLog log{directory, true, &epochs};
+  log.column("value", column);
+  ASSERT_TRUE(log.open());
+  Write first{&column, 0, 1}, third{&column, 1, 3};
+  std::vector<Write*> first_set{&first}, third_set{&third};
+  log.commit(first_set, false, log.reserve());
+  std::thread([&]() { ASSERT_EQ(log.reserve(), 2u); }).join();
+  log.commit(third_set, false, log.reserve());
+  log.close();
+
+  // with synchronous commits, the record behind the gap was never acknowledged
+  ASSERT_TRUE(setDurableEpoch(directory, common::RedoLog::idle));
+  atom::ExtentVector<uint64_t> recovered;
+  recovered.reserve(2);
+  recovered.push_back(0);
+  recovered.push_back(0);
+  common::Recovery recovery{directory, 2};
+  ASSERT_TRUE(recovery.open());
+  recovery.column("value", recovered);
+  ASSERT_TRUE(recovery.run());
+  ASSERT_EQ(recovered[0], 1u);
+  ASSERT_EQ(recovered[1], 0u);
+  ASSERT_EQ(recovery.dropped(), 1u);
+
+  std::system(("rm -rf " + directory).c_str());
+}
+
+TEST(Recovery, RejectsIncompatibleLog) {
+  auto directory = temporaryDirectory();
+  atom::ExtentVector<uint64_t> column;
+  column.reserve(1);
+  column.push_back(0);
+  {
+    common::RedoLog log{directory};
+    log.column("value", column);
+    ASSERT_TRUE(log.open());
+  }
+
+  int fd = open((directory + "/redo.log").c_str(), O_WRONLY);
+  uint64_t magic = 0;
+  ASSERT_EQ(pwrite(fd, &magic, sizeof(magic), 0), static_cast<ssize_t>(sizeof(magic)));
+  close(fd);
+  ASSERT_TRUE(recover(directory, 1, 1).empty());
+
+  std::system(("rm -rf " + directory).c_str());
+}
+
+TEST(Recovery, RejectsAnotherPopulation) {
+  auto directory = temporaryDirectory();
+  atom::ExtentVector<uint64_t> column;
+  column.reserve(1);
+  column.push_back(0);
+  {
+    common::RedoLog log{directory};
+    log.column("value", column);
+    log.setPopulation("svcc_tpcc_1_4e464e");
+    ASSERT_TRUE(log.open());
+  }
+
+  common::Recovery other{directory, 1};
+  other.setPopulation("svcc_tpcc_2_4e464e");
+  ASSERT_FALSE(other.open());
+
+  common::Recovery same{directory, 1};
+  same.setPopulation("svcc_tpcc_1_4e464e");
+  ASSERT_TRUE(same.open());
+
+  std::system(("rm -rf " + directory).c_str());
+}
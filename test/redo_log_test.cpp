@@ -0,0 +1,226 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/chunk_allocator.hpp"
+#include "common/epoch_manager.hpp"
+#include "common/recovery.hpp"
+#include "common/redo_log.hpp"
+#include "ds/atomic_extent_vector.hpp"
+#include "ds/atomic_singly_linked_list.hpp"
+#include "ds/extent_vector.hpp"
+#include "svcc/cc/nofalsenegatives/transaction_coordinator.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace {
+using TC = nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>;
+
+std::string temporaryDirectory() {
+  char directory[] = "/tmp/nfn_redo_log_XXXXXX";
+  return mkdtemp(directory);
+}
+
+struct Table {
+  atom::ExtentVector<uint64_t> value;
+  atom::AtomicExtentVector<uint64_t> lsn;
+  atom::AtomicExtentVector<uint64_t> locked;
+  atom::AtomicExtentVector<atom::AtomicSinglyLinkedList<uint64_t>*> rw_table;
+
+  Table(uint64_t rows, common::ChunkAllocator* ca, atom::EpochManagerBase<common::ChunkAllocator>* emp) {
+    value.reserve(rows);
+    lsn.reserve(rows);
+    locked.reserve(rows);
+    rw_table.reserve(rows);
+    for (uint64_t i = 0; i < rows; i++) {
+      value.push_back(0);
+      lsn.push_back(0);
+      locked.push_back(0);
+      rw_table.push_back(new atom::AtomicSinglyLinkedList<uint64_t>{ca, emp});
+    }
+  }
+};
+
+struct Write {
+  atom::ExtentVector<uint64_t>* column;
+  uint64_t offset;
+  uint64_t value;
+
+  void redo(common::RedoLog& log) { log.append(column, offset, value); }
+};
+
+template <typename Func>
+bool eventually(Func&& func) {
+  for (int i = 0; i < 5000 && !func(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return func();
+}
+
+bool write(TC& tc, Table& table, uint64_t offset, uint64_t value, uint64_t transaction) {
+  return tc.writeValue(value, table.value, table.lsn, table.rw_table, table.locked, offset, transaction);
+}
+}  // namespace
+
+TEST(RedoLog, ChainedWritersRecoverLastValue) {
+  common::ChunkAllocator ca{};
+  atom::EpochManagerBase<common::ChunkAllocator> emp{&ca};
+  TC tc{&ca, &emp};
+  Table table{1, &ca, &emp};
+  auto directory = temporaryDirectory();
+
+  common::RedoLog log{directory};
+  log.column("value", table.value);
+  ASSERT_TRUE(log.open());
+  tc.setRedoLog(&log);
+
+  // t2 overwrites the dirty value of t1 and thus has to be replayed after it, although it starts committing first
+  std::atomic<int> step{0};
+  std::atomic<bool> first{false}, second{false};
+  std::thread t1([&]() {
+    std::unordered_set<uint64_t> oset;
+    auto transaction = tc.start();
+    first = write(tc, table, 0, 1, transaction);
+    step = 1;
+    while (step.load() < 2) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    first = first && tc.commit(transaction, oset);
+  });
+  std::thread t2([&]() {
+    std::unordered_set<uint64_t> oset;
+    while (step.load() < 1) {
+    }
+    auto transaction = tc.start();
+    step = 2;
+    second = write(tc, table, 0, 2, transaction) && tc.commit(transaction, oset);
+  });
+  t1.join();
+  t2.join();
+  log.close();
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  ASSERT_EQ(table.value[0], 2u);
+
+  atom::ExtentVector<uint64_t> recovered;
+  recovered.reserve(1);
+  recovered.push_back(0);
+  common::Recovery recovery{directory, 1};
+  ASSERT_TRUE(recovery.open());
+  recovery.column("value", recovered);
+  ASSERT_TRUE(recovery.run());
+  ASSERT_EQ(recovered[0], 2u);
+
+  std::system(("rm -rf " + directory).c_str());
+}
+
+TEST(RedoLog, ReservedEpochHoldsBackDurableEpoch) {
+  auto directory = temporaryDirectory();
+  atom::ExtentVector<uint64_t> column;
+  column.reserve(1);
+  column.push_back(0);
+  std::atomic<uint64_t> epochs{1};
+
+  common::RedoLog log{directory, true, &epochs};
+  log.column("value", column);
+  ASSERT_TRUE(log.open());
+
+  Write w{&column, 0, 7};
+  std::vector<Write*> write_set{&w};
+  auto lsn = log.reserve();
+  ASSERT_EQ(log.activeEpoch(), 1u);
+
+  // the epoch of the record in flight must not become durable, regardless of the global epoch
+  epochs = 3;
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ASSERT_EQ(log.durableEpoch(), 0u);
+  ASSERT_EQ(log.activeEpoch(), 1u);
+
+  // the writer acknowledges the commit without any further commit of this worker
+  log.commit(write_set, false, lsn);
+  ASSERT_TRUE(eventually([&]() { return log.acknowledged() == 1; }));
+  ASSERT_GE(log.durableEpoch(), 1u);
+  ASSERT_EQ(log.activeEpoch(), 3u);
+  log.close();
+
+  atom::ExtentVector<uint64_t> recovered;
+  recovered.reserve(1);
+  recovered.push_back(0);
+  common::Recovery recovery{directory, 1};
+  ASSERT_TRUE(recovery.open());
+  recovery.column("value", recovered);
+  ASSERT_TRUE(recovery.run());
+  ASSERT_EQ(recovered[0], 7u);
+
+  std::system(("rm -rf " + directory).c_str());
+}
+
+TEST(RedoLog, SyncCommitWaitsForSmallerLsns) {
+  auto directory = temporaryDirectory();
+  atom::ExtentVector<uint64_t> column;
+  column.reserve(2);
+  column.push_back(0);
+  column.push_back(0);
+
+  common::RedoLog log{directory};
+  log.column("value", column);
+  ASSERT_TRUE(log.open());
+
+  // the successor reserves its lsn after the predecessor but emits its record first
+  std::atomic<int> step{0};
+  std::atomic<bool> acknowledged{false};
+  std::thread predecessor([&]() {
+    Write w{&column, 0, 1};
+    std::vector<Write*> write_set{&w};
+    auto lsn = log.reserve();
+    step = 1;
+    while (step.load() < 2) {
+    }
+    log.commit(write_set, false, lsn);
+  });
+  std::thread successor([&]() {
+    Write w{&column, 1, 2};
+    std::vector<Write*> write_set{&w};
+    while (step.load() < 1) {
+    }
+    log.commit(write_set, false, log.reserve());
+    acknowledged = true;
+  });
+
+  // the record of the successor is flushed, but it must not be acknowledged before the one of the predecessor
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_FALSE(acknowledged);
+  ASSERT_EQ(log.flushedLsn(), 0u);
+  step = 2;
+  predecessor.join();
+  successor.join();
+  ASSERT_TRUE(acknowledged);
+  ASSERT_EQ(log.flushedLsn(), 2u);
+  log.close();
+
+  std::system(("rm -rf " + directory).c_str());
+}
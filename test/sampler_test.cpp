@@ -0,0 +1,87 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/sampler.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+TEST(Sampler, TimeSeriesAddsUpToTheTotals) {
+  ASSERT_EQ(common::Sampler::attach(), nullptr);
+
+  char directory[] = "/tmp/nfn_sampler_XXXXXX";
+  ASSERT_NE(mkdtemp(directory), nullptr);
+  char cwd[4096];
+  ASSERT_NE(getcwd(cwd, sizeof(cwd)), nullptr);
+  ASSERT_EQ(chdir(directory), 0);
+
+  {
+    common::Sampler sampler{2};
+    sampler.start(2);
+    auto worker = [](uint64_t commits) {
+      auto counters = common::Sampler::attach();
+      ASSERT_NE(counters, nullptr);
+      for (uint64_t i = 0; i < commits; i++) {
+        common::Sampler::add(counters->commits);
+        common::Sampler::add(counters->aborts, 2);
+        if (i % 100 == 0)
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    };
+    std::thread a(worker, 1000), b(worker, 3000);
+    a.join();
+    b.join();
+    ASSERT_EQ(common::Sampler::attach(), nullptr);
+    sampler.stop();
+    sampler.writeCSV("run");
+  }
+
+  // run;time_ms;phase;commits;aborts;... per interval
+  std::ifstream samples("samples.csv");
+  uint64_t lines = 0, commits = 0, aborts = 0, time = 0;
+  for (std::string line; std::getline(samples, line); lines++) {
+    std::stringstream fields(line);
+    std::string prefix, phase;
+    uint64_t t, c, a;
+    char sep;
+    std::getline(fields, prefix, ';');
+    fields >> t >> sep;
+    std::getline(fields, phase, ';');
+    fields >> c >> sep >> a;
+    ASSERT_EQ(prefix, "run");
+    ASSERT_GE(t, time);
+    time = t;
+    commits += c;
+    aborts += a;
+  }
+  ASSERT_GT(lines, 1u);
+  ASSERT_EQ(commits, 4000u);
+  ASSERT_EQ(aborts, 8000u);
+
+  ASSERT_EQ(chdir(cwd), 0);
+  std::system((std::string{"rm -rf "} + directory).c_str());
+}
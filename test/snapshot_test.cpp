@@ -0,0 +1,102 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/chunk_allocator.hpp"
+#include "common/epoch_manager.hpp"
+#include "common/snapshot.hpp"
+#include "ds/atomic_unordered_map.hpp"
+#include "ds/extent_vector.hpp"
+#include <cstdlib>
+#include <string>
+#include <gtest/gtest.h>
+
+namespace {
+using Map = atom::AtomicUnorderedMap<uint64_t,
+                                     uint64_t,
+                                     atom::AtomicUnorderedMapBucket<uint64_t, uint64_t>,
+                                     common::ChunkAllocator>;
+
+std::string temporaryDirectory() {
+  char directory[] = "/tmp/nfn_snapshot_XXXXXX";
+  return mkdtemp(directory);
+}
+}  // namespace
+
+TEST(Snapshot, ColumnAndIndexRoundTrip) {
+  common::ChunkAllocator ca{};
+  atom::EpochManagerBase<common::ChunkAllocator> emp{&ca};
+  auto directory = temporaryDirectory();
+
+  atom::ExtentVector<uint64_t> column;
+  column.reserve(1000);
+  Map index{1024, &ca, &emp};
+  for (uint64_t i = 0; i < 1000; i++) {
+    column.push_back(i * 7);
+    index.insert(i * 3, i);
+  }
+
+  common::Snapshot write{directory, "test"};
+  ASSERT_FALSE(write.exists());
+  ASSERT_TRUE(write.startWrite());
+  write.column("column", column);
+  write.index("index", index);
+  ASSERT_TRUE(write.finish(1000));
+  ASSERT_TRUE(write.exists());
+
+  common::Snapshot read{directory, "test"};
+  ASSERT_EQ(read.rows(), 1000u);
+  atom::ExtentVector<uint64_t> restored_column;
+  Map restored_index{1024, &ca, &emp};
+  read.column("column", restored_column);
+  read.index("index", restored_index);
+  ASSERT_TRUE(read.good());
+
+  ASSERT_EQ(restored_column.size(), 1000u);
+  for (uint64_t i = 0; i < 1000; i++) {
+    ASSERT_EQ(restored_column[i], i * 7);
+    uint64_t val = 0;
+    ASSERT_TRUE(restored_index.lookup(i * 3, val));
+    ASSERT_EQ(val, i);
+  }
+  uint64_t val = 0;
+  ASSERT_FALSE(restored_index.lookup(1, val));
+  emp.remove();
+  std::system(("rm -rf " + directory).c_str());
+}
+
+TEST(Snapshot, IncompleteOrIncompatibleFiles) {
+  auto directory = temporaryDirectory();
+  atom::ExtentVector<uint64_t> column;
+  column.push_back(1);
+
+  common::Snapshot write{directory, "test"};
+  ASSERT_TRUE(write.startWrite());
+  write.column("column", column);
+  // without the manifest the snapshot is regenerated
+  ASSERT_FALSE(write.exists());
+
+  common::Snapshot read{directory, "test"};
+  atom::ExtentVector<uint32_t> incompatible;
+  read.column("column", incompatible);
+  ASSERT_FALSE(read.good());
+  std::system(("rm -rf " + directory).c_str());
+}
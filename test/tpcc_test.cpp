@@ -0,0 +1,85 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/chunk_allocator.hpp"
+#include "common/mutex_wait_manager.hpp"
+#include "mvcc/benchmarks/column_store_tpcc.hpp"
+#include "mvcc/cc/nofalsenegatives/transaction_coordinator.hpp"
+#include "svcc/benchmarks/column_store_tpcc.hpp"
+#include "svcc/cc/nofalsenegatives/transaction_coordinator.hpp"
+#include <memory>
+#include <unordered_set>
+#include <gtest/gtest.h>
+
+namespace {
+// the orders from 2101 on are undelivered after the population, i.e., three of 2103 orders per district
+constexpr uint64_t orders = 2103;
+
+// runs deliveries of warehouse 1 and checks the next delivery of every district after each commit
+template <typename DB, typename Deliver>
+void checkNextDelivery(Deliver&& deliver) {
+  auto db = std::make_unique<DB>(1);
+  db->cust_per_dist = orders;
+  db->populateDatabase(1);
+
+  typename DB::DeliveryVar delivery{1, 1};
+  for (int64_t expected : {2102, 2103, 2101, 2102}) {
+    auto transaction = db->tc.start();
+    db->bot(transaction);
+    ASSERT_EQ(deliver(*db, delivery, transaction), 1);
+    std::unordered_set<uint64_t> oset;
+    ASSERT_TRUE(db->commit(transaction, oset));
+    for (uint64_t d = 1; d <= db->dist_per_warehouse; ++d) {
+      uint64_t offset;
+      ASSERT_TRUE(db->district_map->lookup(db->distKey(d, 1), offset));
+      ASSERT_EQ(db->district.d_next_delivery_o_id[offset], expected);
+    }
+  }
+}
+}  // namespace
+
+TEST(Tpcc, DeliveryAdvancesAndWrapsTheNextDelivery) {
+  using DB = sv::tpcc::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
+                                common::MutexWaitManager>;
+  sv::tpcc::SinglyDistrict d;
+  sv::tpcc::SinglyNewOrder no;
+  sv::tpcc::SinglyOrder o;
+  sv::tpcc::SinglyOrderLine ol;
+  sv::tpcc::SinglyCustomer c;
+  checkNextDelivery<DB>([&](DB& db, DB::DeliveryVar& delivery, uint64_t transaction) {
+    return db.template execDelivery<true>(delivery, d, no, o, ol, c, transaction);
+  });
+}
+
+TEST(Tpcc, MultiVersionDeliveryAdvancesAndWrapsTheNextDelivery) {
+  using TC = mv::nofalsenegatives::transaction::
+      TransactionCoordinator<atom::ExtentVector, atom::AtomicExtentVector, common::ChunkAllocator>;
+  using DB = mv::tpcc::Database<TC, common::MutexWaitManager>;
+  mv::tpcc::VersionDistrict d;
+  mv::tpcc::VersionNewOrder no;
+  mv::tpcc::VersionOrder o;
+  mv::tpcc::VersionOrderLine ol;
+  mv::tpcc::VersionCustomer c;
+  checkNextDelivery<DB>([&](DB& db, DB::DeliveryVar& delivery, uint64_t transaction) {
+    return db.execDelivery(delivery, d, no, o, ol, c, transaction);
+  });
+}
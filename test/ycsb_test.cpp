@@ -0,0 +1,84 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/acknowledged_counter.hpp"
+#include "common/chunk_allocator.hpp"
+#include "common/mutex_wait_manager.hpp"
+#include "common/run_control.hpp"
+#include "svcc/benchmarks/column_store_ycsb.hpp"
+#include "svcc/cc/nofalsenegatives/transaction_coordinator.hpp"
+#include <memory>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using common::AcknowledgedCounter;
+
+TEST(AcknowledgedCounter, LastFollowsTheContiguousPrefix) {
+  AcknowledgedCounter keys;
+  keys.reset(100);
+  ASSERT_EQ(keys.last(), 100u);
+  ASSERT_EQ(keys.next(), 101u);
+  ASSERT_EQ(keys.next(), 102u);
+  ASSERT_EQ(keys.next(), 103u);
+
+  // 102 and 103 commit before 101
+  keys.acknowledge(103);
+  keys.acknowledge(102);
+  ASSERT_EQ(keys.last(), 100u);
+  keys.acknowledge(101);
+  ASSERT_EQ(keys.last(), 103u);
+}
+
+TEST(AcknowledgedCounter, RolledBackKeysAreHandedOutAgain) {
+  AcknowledgedCounter keys;
+  keys.reset(0);
+  ASSERT_EQ(keys.next(), 1u);
+  ASSERT_EQ(keys.next(), 2u);
+  keys.acknowledge(2);
+  keys.release(1);
+  ASSERT_EQ(keys.last(), 0u);
+
+  ASSERT_EQ(keys.next(), 1u);
+  ASSERT_EQ(keys.next(), 3u);
+  keys.acknowledge(1);
+  ASSERT_EQ(keys.last(), 2u);
+}
+
+TEST(Ycsb, LatestWorkloadReadsOnlyInsertedKeys) {
+  using DB = sv::ycsb::Database<nofalsenegatives::transaction::TransactionCoordinator<common::ChunkAllocator>,
+                                common::MutexWaitManager>;
+  constexpr uint64_t population = 10000, workers = 4, transactions = 2000;
+  ASSERT_TRUE(common::RunControl::configure(nullptr));
+  auto db = std::make_unique<DB>(10, 0.95, 0, 0.99);
+  db->populateDatabase(population);
+  ASSERT_TRUE(db->setWorkload('d'));
+
+  std::vector<std::thread> threads;
+  for (uint64_t w = 0; w < workers; ++w)
+    threads.emplace_back([&, w]() { DB::client(*db, population, transactions, w); });
+  for (auto& thread : threads)
+    thread.join();
+
+  ASSERT_EQ(db->global_details_collector.commitCount(), workers * transactions);
+  ASSERT_EQ(db->global_details_collector.notFoundCount(), 0u);
+}
@@ -0,0 +1,79 @@
+//
+// No False Negatives Database - A prototype database to test concurrency control that scales to many cores.
+// Copyright (C) 2019 Dominik Durner <dominik.durner@tum.de>
+//
+// This file is part of No False Negatives Database.
+//
+// No False Negatives Database is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// No False Negatives Database is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with No False Negatives Database.  If not, see <http://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/random.hpp"
+#include "common/zipf.hpp"
+#include <cmath>
+#include <stdint.h>
+#include <gtest/gtest.h>
+
+using common::Zipf;
+
+namespace {
+double exactZeta(uint64_t n, double theta) {
+  double sum = 0;
+  for (uint64_t i = 1; i <= n; i++)
+    sum += std::pow(1.0 / i, theta);
+  return sum;
+}
+};  // namespace
+
+TEST(Zipf, ZetaOfSmallPopulations) {
+  // reference values of the exact sums
+  ASSERT_NEAR(Zipf::zeta(10, 0.99), 2.9561075165103636, 1e-12);
+  ASSERT_NEAR(Zipf::zeta(1000, 0.5), 61.80100876524318, 1e-12);
+  ASSERT_NEAR(Zipf::zeta(5000, 1.0), 9.094508852984404, 1e-12);
+  ASSERT_DOUBLE_EQ(Zipf::zeta(1, 0.99), 1.0);
+  ASSERT_DOUBLE_EQ(Zipf::zeta(2, 0.5), 1 + std::sqrt(0.5));
+}
+
+TEST(Zipf, ZetaTailApproximation) {
+  // beyond exact_terms the tail is approximated, it must agree with the exact sum
+  for (double theta : {0.5, 0.99, 1.0, 1.2}) {
+    uint64_t n = 3 * Zipf::exact_terms + 17;
+    double exact = exactZeta(n, theta);
+    ASSERT_NEAR(Zipf::zeta(n, theta), exact, exact * 1e-10) << "theta " << theta;
+  }
+}
+
+TEST(Zipf, DrawsFollowTheSkew) {
+  Zipf zipf;
+  zipf.configure(1000, 0.99);
+  common::Random gen{7};
+  uint64_t first = 0, draws = 200000;
+  for (uint64_t i = 0; i < draws; ++i) {
+    uint64_t key = zipf(gen);
+    ASSERT_GE(key, 1u);
+    ASSERT_LE(key, 1000u);
+    first += key == 1;
+  }
+  // the most popular key is drawn with probability 1 / zeta(1000, 0.99)
+  double expected = draws / Zipf::zeta(1000, 0.99);
+  ASSERT_NEAR(first, expected, expected * 0.05);
+
+  zipf.configure(1000, 0.99, true);
+  for (uint64_t i = 0; i < 1000; ++i) {
+    uint64_t key = zipf(gen);
+    ASSERT_GE(key, 1u);
+    ASSERT_LE(key, 1000u);
+  }
+}